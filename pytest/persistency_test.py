@@ -44,6 +44,7 @@ def test_hdf5_structure(detectors):
             assert 'length'             in pcolumns
             assert 'creator_proc'       in pcolumns
             assert 'final_proc'         in pcolumns
+            assert 'weight'             in pcolumns
 
 
             hcolumns = h5out.root.MC.hits.colnames
@@ -57,6 +58,7 @@ def test_hdf5_structure(detectors):
             assert 'label'       in hcolumns
             assert 'particle_id' in hcolumns
             assert 'hit_id'      in hcolumns
+            assert 'weight'      in hcolumns
 
 
             scolumns = h5out.root.MC.sns_response.colnames
@@ -76,6 +78,15 @@ def test_hdf5_structure(detectors):
             assert 'z'           in sposcolumns
 
 
+            # The event weights are only written when the
+            # simulation applies some kind of weighting
+            if 'event_weights' in h5out.root.MC:
+                wcolumns = h5out.root.MC.event_weights.colnames
+
+                assert 'event_id' in wcolumns
+                assert 'weight'   in wcolumns
+
+
     filename, _, _, _, _ = detectors
     if "DEMOPP" in filename:
         for run in ["run5", "run7", "run8", "run9", "run10"]:
@@ -0,0 +1,255 @@
+"""
+End-to-end throughput harness of nexus.
+
+Runs a set of the configurations shipped in macros/ with a fixed seed and
+number of events, and writes a JSON report with, for each configuration,
+the events simulated per second, the time to the first event, the peak
+resident memory, the bytes per event of each table of the output file and
+the timings of the start-up stages. The comparison mode flags the
+regressions between the reports of two nexus builds.
+
+Usage:
+    python scripts/nexus_throughput.py run -o report.json [-n 10] [-s 12345]
+                                           [--nexus bin/nexus] [NEXT100_full ...]
+    python scripts/nexus_throughput.py compare base.json new.json [-t 0.10]
+
+The configurations are run from the nexus directory ($NEXUSDIR by default),
+since the macros refer to each other with paths relative to it.
+"""
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+
+default_configurations = ['NEXT100_full',
+                          'NEW_fullKr',
+                          'NextFlex_fullKr',
+                          'NEXT100_S1_LT',
+                          'NEXT100_S2_LT',
+                          'NEXT100_muons']
+
+# Metrics compared between reports, and whether higher values are better
+compared_metrics = {'events_per_second'   : True,
+                    'time_to_first_event' : False,
+                    'peak_rss_mb'         : False,
+                    'bytes_per_event'     : False}
+
+# Start-up stages shorter than this (in seconds) are not compared,
+# since their relative fluctuations are large
+min_stage_time = 0.5
+
+stage_format = re.compile(r'wall ([\d.]+) s, cpu ([\d.]+) s, peak rss \+([\d.]+) MB')
+
+
+def write_macros(nexus_dir, workdir, config, seed):
+    """Write an init macro that registers, after the configuration macros
+    of the shipped one, a macro setting the seed and the output file."""
+    override_path = os.path.join(workdir, config + '.override.config.mac')
+    with open(override_path, 'w') as override:
+        override.write(f'/nexus/random_seed {seed}\n')
+        override.write(f'/nexus/persistency/output_file {os.path.join(workdir, config)}\n')
+
+    with open(os.path.join(nexus_dir, 'macros', config + '.init.mac')) as shipped:
+        init_text = shipped.read()
+
+    init_path = os.path.join(workdir, config + '.init.mac')
+    with open(init_path, 'w') as init:
+        init.write(init_text)
+        init.write(f'\n/nexus/RegisterMacro {override_path}\n')
+
+    return init_path
+
+
+def run_nexus(nexus, init_path, nevents, nexus_dir, log_path):
+    """Run nexus in batch mode and return its exit status,
+    wall time (in seconds) and peak resident memory (in MB)."""
+    start = time.monotonic()
+    with open(log_path, 'w') as log:
+        p = subprocess.Popen([nexus, '-b', '-n', str(nevents), init_path],
+                             cwd=nexus_dir, stdout=log, stderr=subprocess.STDOUT)
+        # Unlike getrusage, wait4 gives the usage of this process only
+        _, status, usage = os.wait4(p.pid, 0)
+    wall = time.monotonic() - start
+
+    p.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -os.WTERMSIG(status)
+
+    # ru_maxrss is given in bytes on macOS and in kilobytes elsewhere
+    scale = 1024**2 if sys.platform == 'darwin' else 1024
+    return p.returncode, wall, usage.ru_maxrss / scale
+
+
+def read_output(filename, nevents):
+    """Return the bytes per event of each table of the output file
+    and the start-up stages stored in its configuration table."""
+    # Imported here, so that reports can be compared without PyTables
+    import tables as tb
+
+    tables, stages = {}, {}
+
+    with tb.open_file(filename) as h5in:
+        for table in h5in.walk_nodes('/', 'Table'):
+            tables[table._v_pathname.lstrip('/')] = table.size_on_disk / nevents
+
+        for row in h5in.root.MC.configuration.iterrows():
+            key   = row['param_key'  ].decode()
+            value = row['param_value'].decode()
+            match = stage_format.match(value)
+            if key.startswith('startup:') and match:
+                wall, cpu, rss = map(float, match.groups())
+                stages[key[len('startup:'):]] = {'wall': wall, 'cpu': cpu, 'rss_mb': rss}
+
+    return tables, stages
+
+
+def measure(args, config, workdir):
+    init_path = write_macros(args.nexus_dir, workdir, config, args.seed)
+    log_path  = os.path.join(workdir, config + '.log')
+
+    print(f'Running {config} ({args.events} events)...', flush=True)
+    status, wall, rss = run_nexus(args.nexus, init_path, args.events, args.nexus_dir, log_path)
+
+    output = os.path.join(workdir, config + '.h5')
+    failed = status != 0 or not os.path.exists(output)
+
+    result = {'failed': failed, 'exit_status': status, 'wall_time': wall, 'peak_rss_mb': rss}
+    if failed:
+        print(f'  {config} failed, see {log_path}')
+        return result
+
+    tables, stages = read_output(output, args.events)
+    result['tables'] = tables
+    result['bytes_per_event'] = os.path.getsize(output) / args.events
+    result['stages'] = stages
+
+    # The start-up stages (the outermost ones) last
+    # until the generation of the first event begins
+    startup = sum(s['wall'] for name, s in stages.items() if '/' not in name)
+    if stages:
+        result['time_to_first_event'] = startup
+    result['events_per_second'] = args.events / max(wall - startup, 1.e-3)
+
+    print(f'  {result["events_per_second"]:.3g} events/s, '
+          f'{startup:.1f} s to first event, {rss:.0f} MB peak memory')
+    return result
+
+
+def run(args):
+    configs = args.configurations or default_configurations
+
+    report = {'nexus'          : os.path.abspath(args.nexus),
+              'events'         : args.events,
+              'seed'           : args.seed,
+              'date'           : datetime.datetime.now().isoformat(timespec='seconds'),
+              'host'           : platform.node(),
+              'configurations' : {}}
+
+    workdir = args.workdir or tempfile.mkdtemp(prefix='nexus_throughput_')
+    os.makedirs(workdir, exist_ok=True)
+
+    for config in configs:
+        report['configurations'][config] = measure(args, config, workdir)
+
+    with open(args.output, 'w') as out:
+        json.dump(report, out, indent=2)
+    print(f'Report written to {args.output} (outputs and logs in {workdir})')
+
+    failed = [c for c, r in report['configurations'].items() if r['failed']]
+    return 1 if failed else 0
+
+
+def relative_change(base, new, higher_is_better):
+    """Relative change of a metric, positive when it gets worse."""
+    if not base:
+        return 0.
+    change = (new - base) / base
+    return -change if higher_is_better else change
+
+
+def compare(args):
+    with open(args.base) as f: base = json.load(f)
+    with open(args.new ) as f: new  = json.load(f)
+
+    if (base['events'], base['seed']) != (new['events'], new['seed']):
+        print('Warning: the reports were made with different events or seeds')
+
+    regressions = 0
+
+    def check(metric, base_value, new_value, higher_is_better):
+        nonlocal regressions
+        if base_value is None or new_value is None:
+            return
+        flag = ''
+        if relative_change(base_value, new_value, higher_is_better) > args.tolerance:
+            flag = '  REGRESSION'
+            regressions += 1
+        change = (new_value - base_value) / base_value if base_value else 0.
+        print(f'  {metric:40s} {base_value:12.4g} {new_value:12.4g} {change:+8.1%}{flag}')
+
+    for config, b in base['configurations'].items():
+        n = new['configurations'].get(config)
+        if n is None:
+            continue
+        print(f'{config}')
+        print(f'  {"metric":40s} {"base":>12s} {"new":>12s} {"change":>8s}')
+        if n['failed'] and not b['failed']:
+            print('  FAILED in the new build  REGRESSION')
+            regressions += 1
+            continue
+
+        for metric, higher_is_better in compared_metrics.items():
+            check(metric, b.get(metric), n.get(metric), higher_is_better)
+
+        for table, value in b.get('tables', {}).items():
+            check(table + ' (bytes/event)', value,
+                  n.get('tables', {}).get(table), False)
+
+        for stage, value in b.get('stages', {}).items():
+            if value['wall'] < min_stage_time:
+                continue
+            new_stage = n.get('stages', {}).get(stage)
+            check('stage ' + stage + ' (s)', value['wall'],
+                  new_stage['wall'] if new_stage else None, False)
+
+    print(f'{regressions} regression(s) beyond {args.tolerance:.0%}')
+    return 1 if regressions else 0
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    nexus_dir = os.environ.get('NEXUSDIR', os.getcwd())
+
+    run_parser = commands.add_parser('run', help='run the configurations and write a report')
+    run_parser.add_argument('configurations', nargs='*',
+                            help=f'names of the init macros (default: {" ".join(default_configurations)})')
+    run_parser.add_argument('-o', '--output', required=True, help='JSON report')
+    run_parser.add_argument('-n', '--events', type=int, default=10, help='events per configuration')
+    run_parser.add_argument('-s', '--seed', type=int, default=12345, help='random seed')
+    run_parser.add_argument('--nexus', default=os.path.join(nexus_dir, 'bin', 'nexus'),
+                            help='nexus executable')
+    run_parser.add_argument('--nexus-dir', default=nexus_dir,
+                            help='nexus directory, containing macros/ ($NEXUSDIR)')
+    run_parser.add_argument('--workdir', help='directory for the output files and logs')
+
+    compare_parser = commands.add_parser('compare', help='compare two reports')
+    compare_parser.add_argument('base', help='report of the reference build')
+    compare_parser.add_argument('new' , help='report of the new build')
+    compare_parser.add_argument('-t', '--tolerance', type=float, default=0.10,
+                                help='relative change flagged as a regression')
+
+    return parser.parse_args()
+
+
+if __name__ == '__main__':
+    args = parse_args()
+    sys.exit(run(args) if args.command == 'run' else compare(args))
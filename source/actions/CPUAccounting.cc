@@ -0,0 +1,373 @@
+// ----------------------------------------------------------------------------
+// nexus | CPUAccounting.cc
+//
+// This class accumulates the number of steps and the wall time spent on them
+// by particle type, creator process and logical volume, as measured by the
+// CPU accounting stepping and tracking actions. There is an instance of the
+// class per thread. At the end of each run, triggered by the CPU accounting
+// run action, the counters of all threads are added up and the master prints
+// a sorted report and writes it in JSON format, together with the breakdown
+// by particle of the slowest events.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "CPUAccounting.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4Event.hh>
+#include <G4EventManager.hh>
+#include <G4LogicalVolume.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4VProcess.hh>
+#include <G4Run.hh>
+#include <G4Threading.hh>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+using namespace nexus;
+
+
+namespace {
+
+  G4String Quoted(const G4String& s)
+  {
+    G4String q = "\"";
+    for (char c: s) {
+      if (c == '"' || c == '\\') q += '\\';
+      q += c;
+    }
+    return q + "\"";
+  }
+
+}
+
+
+G4ThreadLocal CPUAccounting* CPUAccounting::instance_ = nullptr;
+
+std::mutex CPUAccounting::mutex_;
+CPUAccounting::NamedCounters CPUAccounting::run_counters_;
+std::vector<CPUAccounting::EventRecord> CPUAccounting::run_slowest_;
+
+
+
+CPUAccounting& CPUAccounting::Instance()
+{
+  // The instances are never deleted, so that their
+  // messengers outlive the UI manager
+  if (!instance_) instance_ = new CPUAccounting();
+  return *instance_;
+}
+
+
+
+CPUAccounting::CPUAccounting():
+  msg_(nullptr), nslowest_(10), json_file_("cpu_accounting"),
+  last_(Clock::now()), event_id_(-1)
+{
+  msg_ = new G4GenericMessenger(this, "/Actions/CPUAccounting/",
+                                "Control commands of the CPU accounting actions.");
+
+  G4GenericMessenger::Command& slowest_cmd =
+    msg_->DeclareProperty("slowest_events", nslowest_,
+                          "Number of slowest events whose breakdown is reported.");
+  slowest_cmd.SetParameterName("slowest_events", false);
+  slowest_cmd.SetRange("slowest_events>=0");
+
+  msg_->DeclareProperty("json_file", json_file_,
+                        "Name (without extension) of the JSON report file.");
+}
+
+
+
+CPUAccounting::~CPUAccounting()
+{
+  delete msg_;
+}
+
+
+
+size_t CPUAccounting::KeyHash::operator()(const Key& k) const
+{
+  std::hash<const void*> h;
+  return h(k.particle) ^ (h(k.creator) << 1) ^ (h(k.volume) << 2);
+}
+
+
+
+void CPUAccounting::BeginTrack(const G4Track*)
+{
+  // A new event begins with the first of its tracks
+  const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  if (event && event->GetEventID() != event_id_) {
+    EndEvent();
+    event_id_ = event->GetEventID();
+  }
+
+  last_ = Clock::now();
+}
+
+
+
+void CPUAccounting::Step(const G4Step* step)
+{
+  Clock::time_point now = Clock::now();
+  G4double time = std::chrono::duration<G4double>(now - last_).count();
+  last_ = now;
+
+  const G4Track* track = step->GetTrack();
+  const G4ParticleDefinition* particle = track->GetDefinition();
+
+  Key key = {particle, track->GetCreatorProcess(),
+             step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume()};
+
+  Counter& counter = counters_[key];
+  counter.steps += 1;
+  counter.time  += time;
+
+  event_total_.steps += 1;
+  event_total_.time  += time;
+
+  Counter& event_counter = event_particles_[particle];
+  event_counter.steps += 1;
+  event_counter.time  += time;
+}
+
+
+
+void CPUAccounting::EndEvent()
+{
+  if (event_id_ >= 0 && nslowest_ > 0 &&
+      ((G4int) slowest_.size() < nslowest_ || event_total_.time > slowest_.back().total.time)) {
+
+    std::map<G4String, Counter> particles;
+    for (const auto& p: event_particles_)
+      particles[p.first->GetParticleName()] = p.second;
+
+    EventRecord record;
+    record.id        = event_id_;
+    record.total     = event_total_;
+    record.particles = Sorted(particles);
+
+    KeepSlowest(slowest_, record);
+  }
+
+  event_id_ = -1;
+  event_total_ = Counter();
+  event_particles_.clear();
+}
+
+
+
+void CPUAccounting::KeepSlowest(std::vector<EventRecord>& slowest,
+                                const EventRecord& record) const
+{
+  if (nslowest_ <= 0) return;
+
+  auto pos = std::find_if(slowest.begin(), slowest.end(), [&record](const EventRecord& r)
+                          { return r.total.time < record.total.time; });
+  slowest.insert(pos, record);
+  if ((G4int) slowest.size() > nslowest_) slowest.pop_back();
+}
+
+
+
+void CPUAccounting::EndOfRun(const G4Run* run)
+{
+  if (!instance_) return;
+
+  instance_->EndEvent();
+  instance_->Merge();
+  instance_->Reset();
+
+  if (G4Threading::IsWorkerThread()) return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!run_counters_.empty()) {
+    instance_->Print(run);
+    instance_->WriteJSON(run);
+  }
+
+  run_counters_.clear();
+  run_slowest_.clear();
+}
+
+
+
+void CPUAccounting::Merge()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (const auto& c: counters_) {
+    const Key& key = c.first;
+    const G4String creator = key.creator ? key.creator->GetProcessName() : "primary";
+    Counter& sum = run_counters_[{key.particle->GetParticleName(), creator,
+                                  key.volume->GetName()}];
+    sum.steps += c.second.steps;
+    sum.time  += c.second.time;
+  }
+
+  for (const EventRecord& record: slowest_)
+    KeepSlowest(run_slowest_, record);
+}
+
+
+
+void CPUAccounting::Reset()
+{
+  counters_.clear();
+  slowest_.clear();
+  event_id_ = -1;
+  event_total_ = Counter();
+  event_particles_.clear();
+}
+
+
+
+CPUAccounting::Summary CPUAccounting::Sorted(const std::map<G4String, Counter>& counters)
+{
+  Summary summary(counters.begin(), counters.end());
+  std::stable_sort(summary.begin(), summary.end(),
+                   [](const std::pair<G4String, Counter>& a, const std::pair<G4String, Counter>& b)
+                   { return a.second.time > b.second.time; });
+  return summary;
+}
+
+
+
+void CPUAccounting::Summarize(Summary& particles, Summary& creators, Summary& volumes)
+{
+  std::map<G4String, Counter> by_particle, by_creator, by_volume;
+
+  for (const auto& c: run_counters_) {
+    const auto& names = c.first;
+    for (Counter* sum: {&by_particle[names[0]], &by_creator[names[1]],
+                        &by_volume[names[2]]}) {
+      sum->steps += c.second.steps;
+      sum->time  += c.second.time;
+    }
+  }
+
+  particles = Sorted(by_particle);
+  creators  = Sorted(by_creator);
+  volumes   = Sorted(by_volume);
+}
+
+
+
+void CPUAccounting::Print(const G4Run* run) const
+{
+  Summary particles, creators, volumes;
+  Summarize(particles, creators, volumes);
+
+  Counter total;
+  for (const auto& p: particles) {
+    total.steps += p.second.steps;
+    total.time  += p.second.time;
+  }
+
+  std::ostringstream report;
+  report << std::fixed << "[CPUAccounting] Run " << run->GetRunID() << ": "
+         << total.steps << " steps in " << std::setprecision(3) << total.time << " s\n";
+
+  const std::vector<std::pair<G4String, const Summary*>> tables =
+    {{"particle", &particles}, {"creator process", &creators}, {"logical volume", &volumes}};
+
+  for (const auto& table: tables) {
+    report << "  " << std::left << std::setw(40) << ("By " + table.first) << std::right
+           << std::setw(14) << "steps" << std::setw(12) << "time (s)"
+           << std::setw(10) << "fraction" << "\n";
+    for (const auto& e: *table.second) {
+      G4double fraction = total.time > 0. ? e.second.time / total.time : 0.;
+      report << "    " << std::left << std::setw(38) << e.first << std::right
+             << std::setw(14) << e.second.steps
+             << std::setw(12) << std::setprecision(3) << e.second.time
+             << std::setw(9) << std::setprecision(1) << 100. * fraction << "%\n";
+    }
+  }
+
+  if (!run_slowest_.empty()) {
+    report << "  Slowest events (three slowest particles)\n";
+    for (const EventRecord& r: run_slowest_) {
+      report << "    Event " << r.id << ": " << r.total.steps << " steps in "
+             << std::setprecision(3) << r.total.time << " s (";
+      for (size_t i=0; i<r.particles.size() && i<3; ++i)
+        report << (i ? ", " : "") << r.particles[i].first << " "
+               << r.particles[i].second.time << " s";
+      report << ")\n";
+    }
+  }
+
+  G4cout << report.str();
+}
+
+
+
+void CPUAccounting::WriteSummary(std::ostream& out, const Summary& summary)
+{
+  out << "[";
+  for (size_t i=0; i<summary.size(); ++i) {
+    out << (i ? ", " : "") << "{\"name\": " << Quoted(summary[i].first)
+        << ", \"steps\": " << summary[i].second.steps
+        << ", \"time\": " << summary[i].second.time << "}";
+  }
+  out << "]";
+}
+
+
+
+void CPUAccounting::WriteJSON(const G4Run* run) const
+{
+  const G4String filename =
+    json_file_ + "_run" + std::to_string(run->GetRunID()) + ".json";
+
+  std::ofstream out(filename);
+  if (!out) {
+    G4String msg = "Cannot write " + filename;
+    G4Exception("[CPUAccounting]", "WriteJSON()", JustWarning, msg);
+    return;
+  }
+
+  out.precision(6);
+  out << "{\n  \"run\": " << run->GetRunID() << ",\n  \"entries\": [";
+
+  G4bool first = true;
+  for (const auto& c: run_counters_) {
+    const auto& names = c.first;
+    out << (first ? "\n" : ",\n")
+        << "    {\"particle\": " << Quoted(names[0])
+        << ", \"creator_process\": " << Quoted(names[1])
+        << ", \"volume\": " << Quoted(names[2])
+        << ", \"steps\": " << c.second.steps << ", \"time\": " << c.second.time << "}";
+    first = false;
+  }
+  out << "\n  ],\n";
+
+  Summary particles, creators, volumes;
+  Summarize(particles, creators, volumes);
+
+  out << "  \"by_particle\": ";
+  WriteSummary(out, particles);
+  out << ",\n  \"by_creator_process\": ";
+  WriteSummary(out, creators);
+  out << ",\n  \"by_volume\": ";
+  WriteSummary(out, volumes);
+
+  out << ",\n  \"slowest_events\": [";
+  for (size_t i=0; i<run_slowest_.size(); ++i) {
+    const EventRecord& r = run_slowest_[i];
+    out << (i ? ",\n" : "\n") << "    {\"event\": " << r.id
+        << ", \"steps\": " << r.total.steps << ", \"time\": " << r.total.time
+        << ", \"by_particle\": ";
+    WriteSummary(out, r.particles);
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+}
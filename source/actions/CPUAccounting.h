@@ -0,0 +1,131 @@
+// ----------------------------------------------------------------------------
+// nexus | CPUAccounting.h
+//
+// This class accumulates the number of steps and the wall time spent on them
+// by particle type, creator process and logical volume, as measured by the
+// CPU accounting stepping and tracking actions. There is an instance of the
+// class per thread. At the end of each run, triggered by the CPU accounting
+// run action, the counters of all threads are added up and the master prints
+// a sorted report and writes it in JSON format, together with the breakdown
+// by particle of the slowest events.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef CPU_ACCOUNTING_H
+#define CPU_ACCOUNTING_H
+
+#include <globals.hh>
+
+#include <array>
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class G4GenericMessenger;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4Run;
+class G4Step;
+class G4Track;
+class G4VProcess;
+
+
+namespace nexus {
+
+  class CPUAccounting
+  {
+  public:
+    /// Return the instance of the current thread, creating it if needed
+    static CPUAccounting& Instance();
+
+    /// Add the counters of the current thread to those of the run (and
+    /// start new ones). On the master, which ends its run after the
+    /// worker threads, write the report of the run.
+    static void EndOfRun(const G4Run*);
+
+    /// Start timing a track
+    void BeginTrack(const G4Track*);
+    /// Charge the time since the previous step (or the start
+    /// of the track) to the particle, creator process and volume
+    void Step(const G4Step*);
+
+  private:
+    CPUAccounting();
+    ~CPUAccounting();
+    CPUAccounting(const CPUAccounting&) = delete;
+
+    /// Keep the current event among the slowest ones, if it is
+    void EndEvent();
+    /// Add the counters of the thread to those of the run
+    void Merge();
+    void Print(const G4Run*) const;
+    void WriteJSON(const G4Run*) const;
+    void Reset();
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Key {
+      const G4ParticleDefinition* particle;
+      const G4VProcess* creator; ///< nullptr for primary particles
+      const G4LogicalVolume* volume;
+      G4bool operator==(const Key& k) const
+      { return particle == k.particle && creator == k.creator && volume == k.volume; }
+    };
+
+    struct KeyHash {
+      size_t operator()(const Key& k) const;
+    };
+
+    struct Counter {
+      G4long steps = 0;
+      G4double time = 0.; ///< In seconds
+    };
+
+    /// Counters by name, sorted by decreasing time
+    using Summary = std::vector<std::pair<G4String, Counter>>;
+
+    /// Counters by names of particle, creator process and logical
+    /// volume, which (unlike the processes) are shared by all threads
+    using NamedCounters = std::map<std::array<G4String, 3>, Counter>;
+
+    struct EventRecord {
+      G4int id;
+      Counter total;
+      Summary particles;
+    };
+
+    /// Counters of the run summed by particle, creator process and logical volume
+    static void Summarize(Summary& particles, Summary& creators, Summary& volumes);
+    /// Keep the record among the given slowest events, if it is
+    void KeepSlowest(std::vector<EventRecord>& slowest, const EventRecord&) const;
+    static Summary Sorted(const std::map<G4String, Counter>&);
+    static void WriteSummary(std::ostream&, const Summary&);
+
+    G4GenericMessenger* msg_;
+    G4int nslowest_;     ///< Number of slowest events reported
+    G4String json_file_; ///< Output JSON file
+
+    Clock::time_point last_; ///< End of the previous step
+
+    std::unordered_map<Key, Counter, KeyHash> counters_;
+
+    G4int event_id_; ///< Event being tracked, -1 if none
+    Counter event_total_;
+    std::unordered_map<const G4ParticleDefinition*, Counter> event_particles_;
+    std::vector<EventRecord> slowest_; ///< Slowest events, from the slowest
+
+    static G4ThreadLocal CPUAccounting* instance_;
+
+    static std::mutex mutex_;
+    static NamedCounters run_counters_;           ///< Counters of all threads
+    static std::vector<EventRecord> run_slowest_; ///< Slowest events of all threads
+  };
+
+} // namespace nexus
+
+#endif
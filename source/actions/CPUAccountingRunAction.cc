@@ -0,0 +1,41 @@
+// ----------------------------------------------------------------------------
+// nexus | CPUAccountingRunAction.cc
+//
+// This class writes the report of the CPU accounting stepping and tracking
+// actions at the end of the run, once the counters of all threads have been
+// added up. Otherwise, it behaves as the default run action.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "CPUAccountingRunAction.h"
+#include "CPUAccounting.h"
+#include "FactoryBase.h"
+
+#include <G4Run.hh>
+
+using namespace nexus;
+
+REGISTER_CLASS(CPUAccountingRunAction, G4UserRunAction)
+
+
+CPUAccountingRunAction::CPUAccountingRunAction(): DefaultRunAction()
+{
+  // Create the accounting of this thread (the master, in multithreaded
+  // mode), which writes the report with the counters of all threads
+  CPUAccounting::Instance();
+}
+
+
+
+CPUAccountingRunAction::~CPUAccountingRunAction()
+{
+}
+
+
+
+void CPUAccountingRunAction::EndOfRunAction(const G4Run* run)
+{
+  DefaultRunAction::EndOfRunAction(run);
+  CPUAccounting::EndOfRun(run);
+}
@@ -0,0 +1,34 @@
+// ----------------------------------------------------------------------------
+// nexus | CPUAccountingRunAction.h
+//
+// This class writes the report of the CPU accounting stepping and tracking
+// actions at the end of the run, once the counters of all threads have been
+// added up. Otherwise, it behaves as the default run action.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef CPU_ACCOUNTING_RUN_ACTION_H
+#define CPU_ACCOUNTING_RUN_ACTION_H
+
+#include "DefaultRunAction.h"
+
+class G4Run;
+
+
+namespace nexus {
+
+  class CPUAccountingRunAction: public DefaultRunAction
+  {
+  public:
+    /// Constructor
+    CPUAccountingRunAction();
+    /// Destructor
+    ~CPUAccountingRunAction();
+
+    virtual void EndOfRunAction(const G4Run*);
+  };
+
+} // namespace nexus
+
+#endif
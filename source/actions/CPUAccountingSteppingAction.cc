@@ -0,0 +1,41 @@
+// ----------------------------------------------------------------------------
+// nexus | CPUAccountingSteppingAction.cc
+//
+// This class charges the wall time spent on each step to the particle type,
+// creator process and logical volume of the step. It is meant to be used
+// together with the CPU accounting tracking action, which marks the start
+// of each track, and with the CPU accounting run action, which writes the
+// report at the end of the run.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "CPUAccountingSteppingAction.h"
+#include "CPUAccounting.h"
+#include "FactoryBase.h"
+
+#include <G4Step.hh>
+
+using namespace nexus;
+
+REGISTER_CLASS(CPUAccountingSteppingAction, G4UserSteppingAction)
+
+
+CPUAccountingSteppingAction::CPUAccountingSteppingAction(): G4UserSteppingAction()
+{
+  // Create the accounting of this thread, so that its commands are available
+  CPUAccounting::Instance();
+}
+
+
+
+CPUAccountingSteppingAction::~CPUAccountingSteppingAction()
+{
+}
+
+
+
+void CPUAccountingSteppingAction::UserSteppingAction(const G4Step* step)
+{
+  CPUAccounting::Instance().Step(step);
+}
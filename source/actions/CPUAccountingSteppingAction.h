@@ -0,0 +1,36 @@
+// ----------------------------------------------------------------------------
+// nexus | CPUAccountingSteppingAction.h
+//
+// This class charges the wall time spent on each step to the particle type,
+// creator process and logical volume of the step. It is meant to be used
+// together with the CPU accounting tracking action, which marks the start
+// of each track, and with the CPU accounting run action, which writes the
+// report at the end of the run.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef CPU_ACCOUNTING_STEPPING_ACTION_H
+#define CPU_ACCOUNTING_STEPPING_ACTION_H
+
+#include <G4UserSteppingAction.hh>
+
+class G4Step;
+
+
+namespace nexus {
+
+  class CPUAccountingSteppingAction: public G4UserSteppingAction
+  {
+  public:
+    /// Constructor
+    CPUAccountingSteppingAction();
+    /// Destructor
+    ~CPUAccountingSteppingAction();
+
+    virtual void UserSteppingAction(const G4Step*);
+  };
+
+} // namespace nexus
+
+#endif
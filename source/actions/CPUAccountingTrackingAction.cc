@@ -0,0 +1,40 @@
+// ----------------------------------------------------------------------------
+// nexus | CPUAccountingTrackingAction.cc
+//
+// This class marks the start of each track for the CPU accounting stepping
+// action, so that the time spent between tracks is not charged to any step.
+// Trajectories are stored as in the default tracking action.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "CPUAccountingTrackingAction.h"
+#include "CPUAccounting.h"
+#include "FactoryBase.h"
+
+#include <G4Track.hh>
+
+using namespace nexus;
+
+REGISTER_CLASS(CPUAccountingTrackingAction, G4UserTrackingAction)
+
+
+CPUAccountingTrackingAction::CPUAccountingTrackingAction(): DefaultTrackingAction()
+{
+}
+
+
+
+CPUAccountingTrackingAction::~CPUAccountingTrackingAction()
+{
+}
+
+
+
+void CPUAccountingTrackingAction::PreUserTrackingAction(const G4Track* track)
+{
+  DefaultTrackingAction::PreUserTrackingAction(track);
+
+  // Started last, so that the creation of the trajectory is not charged
+  CPUAccounting::Instance().BeginTrack(track);
+}
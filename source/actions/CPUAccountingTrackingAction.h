@@ -0,0 +1,34 @@
+// ----------------------------------------------------------------------------
+// nexus | CPUAccountingTrackingAction.h
+//
+// This class marks the start of each track for the CPU accounting stepping
+// action, so that the time spent between tracks is not charged to any step.
+// Trajectories are stored as in the default tracking action.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef CPU_ACCOUNTING_TRACKING_ACTION_H
+#define CPU_ACCOUNTING_TRACKING_ACTION_H
+
+#include "DefaultTrackingAction.h"
+
+class G4Track;
+
+
+namespace nexus {
+
+  class CPUAccountingTrackingAction: public DefaultTrackingAction
+  {
+  public:
+    /// Constructor
+    CPUAccountingTrackingAction();
+    /// Destructor
+    virtual ~CPUAccountingTrackingAction();
+
+    virtual void PreUserTrackingAction(const G4Track*);
+  };
+
+} // namespace nexus
+
+#endif
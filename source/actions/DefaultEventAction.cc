@@ -10,16 +10,14 @@
 #include "DefaultEventAction.h"
 #include "Trajectory.h"
 #include "PersistencyManager.h"
-#include "IonizationHit.h"
+#include "SubEventMerger.h"
 #include "FactoryBase.h"
 
 #include <G4Event.hh>
+#include <G4Threading.hh>
 #include <G4VVisManager.hh>
 #include <G4Trajectory.hh>
 #include <G4GenericMessenger.hh>
-#include <G4HCofThisEvent.hh>
-#include <G4SDManager.hh>
-#include <G4HCtable.hh>
 #include <globals.hh>
 
 
@@ -49,7 +47,7 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
     PersistencyManager* pm = dynamic_cast<PersistencyManager*>
       (G4VPersistencyManager::GetPersistencyManager());
 
-    pm->SaveNumbOfInteractingEvents(true);
+    if (pm) pm->SaveNumbOfInteractingEvents(true);
   }
 
 
@@ -75,6 +73,11 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
   {
     nevt_++;
 
+    // In sub-event mode, the master thread processes the events,
+    // and the hits of all their sub-events are merged by now
+    if (G4Threading::IsMultithreadedApplication() && G4Threading::IsMasterThread())
+      SubEventMerger::SortHits(event);
+
     // Determine whether total energy deposit in ionization sensitive
     // detectors is above threshold
     if (energy_min_ >= 0.) {
@@ -85,7 +88,11 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
       G4double edep = 0.;
 
       G4TrajectoryContainer* tc = event->GetTrajectoryContainer();
-      if (tc) {
+      if (event->IsAborted()) {
+        // The event may have been aborted before any trajectory was
+        // stored; it is not saved anyway
+      }
+      else if (tc) {
         // in interactive mode, a G4TrajectoryContainer would exist
         // but the trajectories will not cast to Trajectory
         Trajectory* trj = dynamic_cast<Trajectory*>((*tc)[0]);
@@ -94,9 +101,11 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
                       "The trajectory container is empty. If you are simulating optical photons as primary particles,"
                       " and not using OpticalTrackingAction, you should use the G4 default event action.");
         }
+        // The deposits are weighted, so that the split copies of a
+        // track biased by importance sampling are not counted in full
         for (unsigned int i=0; i<tc->size(); ++i) {
           Trajectory* tr = dynamic_cast<Trajectory*>((*tc)[i]);
-          edep += tr->GetEnergyDeposit();
+          edep += tr->GetWeightedEnergyDeposit();
         }
       }
       else {
@@ -108,13 +117,14 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
 
       PersistencyManager* pm = dynamic_cast<PersistencyManager*>
         (G4VPersistencyManager::GetPersistencyManager());
+      if (!pm) return;
 
       if (!event->IsAborted() && edep>0) {
 	pm->InteractingEvent(true);
       } else {
 	pm->InteractingEvent(false);
       }
-      if (!event->IsAborted() && edep > energy_min_ && edep < energy_max_) {
+      if (!event->IsAborted() && IsInEnergyWindow(edep)) {
 	pm->StoreCurrentEvent(true);
       } else {
 	pm->StoreCurrentEvent(false);
@@ -124,4 +134,14 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
   }
 
 
+
+#if G4VERSION_NUMBER >= 1120
+  void DefaultEventAction::MergeSubEvent(G4Event* master_event,
+                                         const G4Event* sub_event)
+  {
+    SubEventMerger::Merge(master_event, sub_event);
+  }
+#endif
+
+
 } // end namespace nexus
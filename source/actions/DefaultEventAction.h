@@ -11,6 +11,7 @@
 #define DEFAULT_EVENT_ACTION_H
 
 #include <G4UserEventAction.hh>
+#include <G4Version.hh>
 #include <globals.hh>
 
 class G4Event;
@@ -33,6 +34,21 @@ namespace nexus {
     /// Hook at the end of the event loop
     void EndOfEventAction(const G4Event*);
 
+#if G4VERSION_NUMBER >= 1120
+    /// Merge the sensor and ionization hits of a sub-event
+    /// into the event processed by the master thread
+    void MergeSubEvent(G4Event* master_event, const G4Event* sub_event);
+#endif
+
+    /// Whether an energy window has been set with the
+    /// min_energy and max_energy commands
+    G4bool HasEnergyWindow() const;
+    /// Whether an energy deposit is within the window of
+    /// the events saved to file
+    G4bool IsInEnergyWindow(G4double edep) const;
+    /// Maximum energy of the window (DBL_MAX if not set)
+    G4double GetMaxEnergy() const;
+
   private:
     G4GenericMessenger* msg_;
     G4int nevt_, nupdate_;
@@ -40,6 +56,17 @@ namespace nexus {
     G4double energy_max_;
   };
 
+  // INLINE METHODS //////////////////////////////////////////////////
+
+  inline G4bool DefaultEventAction::HasEnergyWindow() const
+  { return energy_min_ > 0. || energy_max_ < DBL_MAX; }
+
+  inline G4bool DefaultEventAction::IsInEnergyWindow(G4double edep) const
+  { return edep > energy_min_ && edep < energy_max_; }
+
+  inline G4double DefaultEventAction::GetMaxEnergy() const
+  { return energy_max_; }
+
 } // namespace nexus
 
 #endif
@@ -2,15 +2,21 @@
 // nexus | DefaultRunAction.cc
 //
 // This is the default run action of the NEXT simulations.
-// A message at the beginning and at the end of the simulation is printed.
+// A message at the beginning and at the end of the simulation is printed,
+// together with the counters accumulated by the persistency manager and the
+// other actions, summed over all threads.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
 
 #include "DefaultRunAction.h"
 #include "FactoryBase.h"
+#include "OpticalBudgetSteppingAction.h"
+#include "PhaseSpaceSteppingAction.h"
 
 #include <G4Run.hh>
+#include <G4RunManager.hh>
+#include <G4AccumulableManager.hh>
 
 using namespace nexus;
 
@@ -31,10 +37,36 @@ DefaultRunAction::~DefaultRunAction()
 void DefaultRunAction::BeginOfRunAction(const G4Run* run)
 {
   G4cout << "### Run " << run->GetRunID() << " start." << G4endl;
+
+  G4AccumulableManager::Instance()->Reset();
+
+  // The volumes used by the stepping actions are resolved
+  // once the geometry is built, before any particle is tracked
+  G4UserSteppingAction* stepact =
+    const_cast<G4UserSteppingAction*>(G4RunManager::GetRunManager()->GetUserSteppingAction());
+
+  OpticalBudgetSteppingAction* budget = dynamic_cast<OpticalBudgetSteppingAction*>(stepact);
+  if (budget) budget->BeginOfRun();
+
+  PhaseSpaceSteppingAction* phase_space = dynamic_cast<PhaseSpaceSteppingAction*>(stepact);
+  if (phase_space) phase_space->BeginOfRun();
 }
 
 
 void DefaultRunAction::EndOfRunAction(const G4Run* run)
 {
   G4cout << "### Run " << run->GetRunID() << " end." << G4endl;
+
+  // The counters of the worker threads are added to those of the
+  // master, which prints them once the workers have finished
+  G4AccumulableManager* accumulables = G4AccumulableManager::Instance();
+  accumulables->Merge();
+
+  if (!IsMaster()) return;
+
+  for (auto it = accumulables->Begin(); it != accumulables->End(); ++it) {
+    const G4Accumulable<G4long>* counter = dynamic_cast<const G4Accumulable<G4long>*>(*it);
+    if (counter)
+      G4cout << counter->GetName() << ": " << counter->GetValue() << G4endl;
+  }
 }
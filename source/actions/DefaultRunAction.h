@@ -2,7 +2,9 @@
 // nexus | DefaultRunAction.h
 //
 // This is the default run action of the NEXT simulations.
-// A message at the beginning and at the end of the simulation is printed.
+// A message at the beginning and at the end of the simulation is printed,
+// together with the counters accumulated by the persistency manager and the
+// other actions, summed over all threads.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -11,9 +11,11 @@
 #include "Trajectory.h"
 #include "PersistencyManager.h"
 #include "IonizationHit.h"
+#include "SubEventMerger.h"
 #include "FactoryBase.h"
 
 #include <G4Event.hh>
+#include <G4Threading.hh>
 #include <G4VVisManager.hh>
 #include <G4Trajectory.hh>
 #include <G4GenericMessenger.hh>
@@ -91,6 +93,11 @@ REGISTER_CLASS(MuonsEventAction, G4UserEventAction)
   {
     nevt_++;
 
+    // In sub-event mode, the master thread processes the events,
+    // and the hits of all their sub-events are merged by now
+    if (G4Threading::IsMultithreadedApplication() && G4Threading::IsMasterThread())
+      SubEventMerger::SortHits(event);
+
     // Determine whether total energy deposit in ionization sensitive
     // detectors is above threshold
     if (energy_threshold_ >= 0.) {
@@ -104,7 +111,7 @@ REGISTER_CLASS(MuonsEventAction, G4UserEventAction)
       if (tc) {
         for (unsigned int i=0; i<tc->size(); ++i) {
           Trajectory* trj = dynamic_cast<Trajectory*>((*tc)[i]);
-          edep += trj->GetEnergyDeposit();
+          edep += trj->GetWeightedEnergyDeposit();
           // Draw tracks in visual mode
           if (G4VVisManager::GetConcreteInstance()) trj->DrawTrajectory();
         }
@@ -115,8 +122,7 @@ REGISTER_CLASS(MuonsEventAction, G4UserEventAction)
       PersistencyManager* pm = dynamic_cast<PersistencyManager*>
         (G4VPersistencyManager::GetPersistencyManager());
 
-      if (edep > energy_threshold_) pm->StoreCurrentEvent(true);
-      else pm->StoreCurrentEvent(false);
+      if (pm) pm->StoreCurrentEvent(edep > energy_threshold_);
 
     }
 
@@ -138,4 +144,14 @@ REGISTER_CLASS(MuonsEventAction, G4UserEventAction)
   }
 
 
+
+#if G4VERSION_NUMBER >= 1120
+  void MuonsEventAction::MergeSubEvent(G4Event* master_event,
+                                       const G4Event* sub_event)
+  {
+    SubEventMerger::Merge(master_event, sub_event);
+  }
+#endif
+
+
 } // end namespace nexus
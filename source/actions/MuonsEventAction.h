@@ -12,6 +12,7 @@
 
 #include <G4UserEventAction.hh>
 #include <G4AnalysisManager.hh>
+#include <G4Version.hh>
 #include <globals.hh>
 
 
@@ -35,6 +36,12 @@ namespace nexus {
     /// Hook at the end of the event loop
     void EndOfEventAction(const G4Event*);
 
+#if G4VERSION_NUMBER >= 1120
+    /// Merge the sensor and ionization hits of a sub-event
+    /// into the event processed by the master thread
+    void MergeSubEvent(G4Event* master_event, const G4Event* sub_event);
+#endif
+
   private:
     G4GenericMessenger* msg_;
     G4int nevt_, nupdate_;
@@ -0,0 +1,165 @@
+// ----------------------------------------------------------------------------
+// nexus | OpticalBudgetSteppingAction.cc
+//
+// This class kills optical photons that are very unlikely to contribute
+// to the sensor response: photons that have undergone more than a given
+// number of boundary interactions, that have travelled more than a given
+// path length or for longer than a given time, or that enter one of a list
+// of non-instrumented (logical) volumes, resolved at the start of each run.
+// The number of photons killed for each reason is summed over all threads
+// and printed by the run action at the end of the run.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "OpticalBudgetSteppingAction.h"
+#include "FactoryBase.h"
+
+#include <G4Step.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4GenericMessenger.hh>
+#include <G4LogicalVolume.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4AccumulableManager.hh>
+
+#include <algorithm>
+
+using namespace nexus;
+
+REGISTER_CLASS(OpticalBudgetSteppingAction, G4UserSteppingAction)
+
+
+OpticalBudgetSteppingAction::OpticalBudgetSteppingAction():
+  G4UserSteppingAction(), msg_(0),
+  max_boundaries_(0), max_length_(0.), max_time_(0.), nboundaries_(0),
+  killed_boundaries_("Optical photons killed by boundary interactions", 0),
+  killed_length_("Optical photons killed by path length", 0),
+  killed_time_("Optical photons killed by time of flight", 0),
+  killed_volume_("Optical photons killed entering a non-instrumented volume", 0)
+{
+  msg_ = new G4GenericMessenger(this, "/Actions/OpticalBudgetSteppingAction/",
+                                "Control commands of the optical budget stepping action.");
+
+  G4GenericMessenger::Command& boundaries_cmd =
+    msg_->DeclareProperty("max_boundaries", max_boundaries_,
+                          "Max. number of boundary interactions of a photon (0 = no limit).");
+  boundaries_cmd.SetParameterName("max_boundaries", false);
+  boundaries_cmd.SetRange("max_boundaries>=0");
+
+  G4GenericMessenger::Command& length_cmd =
+    msg_->DeclareProperty("max_length", max_length_,
+                          "Max. path length of a photon (0 = no limit).");
+  length_cmd.SetUnitCategory("Length");
+  length_cmd.SetParameterName("max_length", false);
+  length_cmd.SetRange("max_length>=0.");
+
+  G4GenericMessenger::Command& time_cmd =
+    msg_->DeclareProperty("max_time", max_time_,
+                          "Max. time of flight of a photon (0 = no limit).");
+  time_cmd.SetUnitCategory("Time");
+  time_cmd.SetParameterName("max_time", false);
+  time_cmd.SetRange("max_time>=0.");
+
+  msg_->DeclareMethod("kill_volume", &OpticalBudgetSteppingAction::AddKillVolume,
+                      "Add a logical volume where optical photons are killed on entry.");
+
+  // An instance is created in every thread (including the master),
+  // so the counters are registered in the same order in all of them
+  G4AccumulableManager* accumulables = G4AccumulableManager::Instance();
+  accumulables->RegisterAccumulable(killed_boundaries_);
+  accumulables->RegisterAccumulable(killed_length_);
+  accumulables->RegisterAccumulable(killed_time_);
+  accumulables->RegisterAccumulable(killed_volume_);
+}
+
+
+
+OpticalBudgetSteppingAction::~OpticalBudgetSteppingAction()
+{
+  delete msg_;
+}
+
+
+
+void OpticalBudgetSteppingAction::UserSteppingAction(const G4Step* step)
+{
+  G4Track* track = step->GetTrack();
+  if (track->GetDefinition() != G4OpticalPhoton::Definition()) return;
+
+  // Photons detected or absorbed in this step are left alone
+  if (track->GetTrackStatus() != fAlive) return;
+
+  // Each name matches at least one volume once they are resolved
+  if (kill_volumes_.size() < kill_volume_names_.size())
+    G4Exception("[OpticalBudgetSteppingAction]", "UserSteppingAction()", FatalException,
+                "The kill volumes were not resolved; a run action derived "
+                "from DefaultRunAction is required.");
+
+  if (track->GetCurrentStepNumber() == 1) nboundaries_ = 0;
+
+  G4StepPoint* post = step->GetPostStepPoint();
+
+  if (post->GetStepStatus() == fGeomBoundary) {
+
+    ++nboundaries_;
+
+    if (!kill_volumes_.empty() && post->GetPhysicalVolume() &&
+        std::find(kill_volumes_.begin(), kill_volumes_.end(),
+                  post->GetPhysicalVolume()->GetLogicalVolume()) != kill_volumes_.end()) {
+      track->SetTrackStatus(fStopAndKill);
+      killed_volume_ += 1;
+      return;
+    }
+
+    if (max_boundaries_ > 0 && nboundaries_ > max_boundaries_) {
+      track->SetTrackStatus(fStopAndKill);
+      killed_boundaries_ += 1;
+      return;
+    }
+  }
+
+  if (max_length_ > 0. && track->GetTrackLength() > max_length_) {
+    track->SetTrackStatus(fStopAndKill);
+    killed_length_ += 1;
+    return;
+  }
+
+  // The local time is used, so that the photon time of flight is limited
+  // independently of the time at which it was produced
+  if (max_time_ > 0. && track->GetLocalTime() > max_time_) {
+    track->SetTrackStatus(fStopAndKill);
+    killed_time_ += 1;
+  }
+}
+
+
+
+void OpticalBudgetSteppingAction::AddKillVolume(G4String name)
+{
+  kill_volume_names_.push_back(name);
+}
+
+
+
+void OpticalBudgetSteppingAction::BeginOfRun()
+{
+  kill_volumes_.clear();
+
+  G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+
+  for (const G4String& name: kill_volume_names_) {
+    G4bool found = false;
+    for (const G4LogicalVolume* lv: *store) {
+      if (lv->GetName() == name) {
+        kill_volumes_.push_back(lv);
+        found = true;
+      }
+    }
+    if (!found) {
+      G4String msg = "Unknown volume: " + name;
+      G4Exception("[OpticalBudgetSteppingAction]", "BeginOfRun()",
+                  FatalException, msg);
+    }
+  }
+}
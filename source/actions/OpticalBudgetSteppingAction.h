@@ -0,0 +1,69 @@
+// ----------------------------------------------------------------------------
+// nexus | OpticalBudgetSteppingAction.h
+//
+// This class kills optical photons that are very unlikely to contribute
+// to the sensor response: photons that have undergone more than a given
+// number of boundary interactions, that have travelled more than a given
+// path length or for longer than a given time, or that enter one of a list
+// of non-instrumented (logical) volumes, resolved at the start of each run.
+// The number of photons killed for each reason is summed over all threads
+// and printed by the run action at the end of the run.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef OPTICAL_BUDGET_STEPPING_ACTION_H
+#define OPTICAL_BUDGET_STEPPING_ACTION_H
+
+#include <G4UserSteppingAction.hh>
+#include <G4Accumulable.hh>
+#include <globals.hh>
+#include <vector>
+
+class G4Step;
+class G4GenericMessenger;
+class G4LogicalVolume;
+
+
+namespace nexus {
+
+  class OpticalBudgetSteppingAction: public G4UserSteppingAction
+  {
+  public:
+    /// Constructor
+    OpticalBudgetSteppingAction();
+    /// Destructor
+    ~OpticalBudgetSteppingAction();
+
+    virtual void UserSteppingAction(const G4Step*);
+
+    /// Translate the names of the kill volumes into pointers, failing
+    /// for unknown names. Called by the run action at the start of the run.
+    void BeginOfRun();
+
+  private:
+    /// Add a volume to the list of volumes where photons are killed
+    void AddKillVolume(G4String);
+
+  private:
+    G4GenericMessenger* msg_;
+
+    G4int max_boundaries_;   ///< Max. number of boundary interactions
+    G4double max_length_;    ///< Max. path length of a photon
+    G4double max_time_;      ///< Max. time of flight of a photon
+
+    std::vector<G4String> kill_volume_names_;
+    std::vector<const G4LogicalVolume*> kill_volumes_;
+
+    G4int nboundaries_; ///< Boundary interactions of the current photon
+
+    // Number of photons killed for each reason in the current run
+    G4Accumulable<G4long> killed_boundaries_;
+    G4Accumulable<G4long> killed_length_;
+    G4Accumulable<G4long> killed_time_;
+    G4Accumulable<G4long> killed_volume_;
+  };
+
+} // namespace nexus
+
+#endif
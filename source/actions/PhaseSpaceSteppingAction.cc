@@ -0,0 +1,196 @@
+// ----------------------------------------------------------------------------
+// nexus | PhaseSpaceSteppingAction.cc
+//
+// This class records the particles that enter a given volume (e.g., the
+// air inside the shielding) in a primary event library, so that they can
+// be replayed later with the PhaseSpaceGenerator. It is meant for two-stage
+// simulations of external backgrounds: the expensive transport through the
+// outer shielding is done once, and the recorded phase space is then reused
+// by any number of simulations of the inner detector. Each recorded
+// particle keeps the weight of its track, which includes the weight of the
+// primary vertex and that of the biasing (e.g., importance sampling), and
+// the library header keeps the number of simulated events for the
+// normalisation. By default, the recorded particles are killed.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PhaseSpaceSteppingAction.h"
+#include "FactoryBase.h"
+
+#include <G4Step.hh>
+#include <G4Event.hh>
+#include <G4EventManager.hh>
+#include <G4RunManager.hh>
+#include <G4Run.hh>
+#include <G4ParticleTable.hh>
+#include <G4GenericMessenger.hh>
+#include <G4Threading.hh>
+#include <G4PhysicalVolumeStore.hh>
+
+#include <CLHEP/Units/SystemOfUnits.h>
+
+#include <algorithm>
+
+using namespace nexus;
+using namespace CLHEP;
+
+REGISTER_CLASS(PhaseSpaceSteppingAction, G4UserSteppingAction)
+
+
+PhaseSpaceSteppingAction::PhaseSpaceSteppingAction():
+  G4UserSteppingAction(), msg_(0), volume_("INNER_AIR"), file_("phase_space"),
+  min_energy_(0.), kill_(true), run_id_(-1), event_id_(-1), event_{}, nevents_(0)
+{
+  msg_ = new G4GenericMessenger(this, "/Actions/PhaseSpaceSteppingAction/",
+                                "Control commands of the phase space recorder.");
+
+  msg_->DeclareProperty("volume", volume_,
+                        "Volume whose entering particles are recorded.");
+
+  msg_->DeclareProperty("file", file_,
+                        "Base name of the output library. In multithreaded "
+                        "mode, each thread writes its own library.");
+
+  G4GenericMessenger::Command& min_energy_cmd =
+    msg_->DeclareProperty("min_energy", min_energy_,
+                          "Minimum kinetic energy of the recorded particles.");
+  min_energy_cmd.SetParameterName("min_energy", false);
+  min_energy_cmd.SetUnitCategory("Energy");
+  min_energy_cmd.SetRange("min_energy>=0.");
+
+  msg_->DeclareMethod("select_particle",
+                      &PhaseSpaceSteppingAction::AddSelectedParticle,
+                      "Record only the given particle (all of them by default).");
+
+  msg_->DeclareProperty("kill", kill_,
+                        "Whether to kill the particles once recorded.");
+}
+
+
+
+PhaseSpaceSteppingAction::~PhaseSpaceSteppingAction()
+{
+  // The master thread instance of multithreaded runs never steps
+  if (nevents_ > 0) {
+    WriteEvent();
+    writer_.SetNumberOfSourceEvents(nevents_);
+    writer_.Close();
+
+    G4cout << "[PhaseSpaceSteppingAction] " << writer_.GetNumberOfEvents()
+           << " events out of " << nevents_ << " recorded in "
+           << filename_ << G4endl;
+  }
+
+  delete msg_;
+}
+
+
+
+void PhaseSpaceSteppingAction::UserSteppingAction(const G4Step* step)
+{
+  if (volumes_.empty())
+    G4Exception("[PhaseSpaceSteppingAction]", "UserSteppingAction()", FatalException,
+                "The recorded volume was not resolved; a run action derived "
+                "from DefaultRunAction is required.");
+
+  // A new event begins with its first step
+  const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  G4int run_id = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+
+  if (event->GetEventID() != event_id_ || run_id != run_id_) {
+    WriteEvent();
+
+    // In multithreaded mode, each worker thread writes its own library
+    if (nevents_ == 0) {
+      filename_ = file_;
+      if (G4Threading::IsWorkerThread())
+        filename_ += "_t" + std::to_string(G4Threading::G4GetThreadId());
+      filename_ += ".lib";
+      writer_.Open(filename_, PrimaryEventLibrary::kHasPositions |
+                              PrimaryEventLibrary::kHasWeights);
+    }
+
+    run_id_   = run_id;
+    event_id_ = event->GetEventID();
+    nevents_++;
+
+    event_ = {};
+    event_.event_id = event_id_;
+    event_.weight   = event->GetPrimaryVertex() ?
+                      event->GetPrimaryVertex()->GetWeight() : 1.;
+  }
+
+  G4StepPoint* pre  = step->GetPreStepPoint();
+  G4StepPoint* post = step->GetPostStepPoint();
+
+  if (post->GetStepStatus() != fGeomBoundary) return;
+
+  G4VPhysicalVolume* post_volume = post->GetTouchableHandle()->GetVolume();
+  if (std::find(volumes_.begin(), volumes_.end(), post_volume) == volumes_.end())
+    return;
+  if (pre->GetTouchableHandle()->GetVolume() == post_volume) return;
+
+  G4Track* track = step->GetTrack();
+  const G4ParticleDefinition* pdef = track->GetDefinition();
+
+  if (!selected_particles_.empty() &&
+      std::find(selected_particles_.begin(), selected_particles_.end(), pdef)
+      == selected_particles_.end())
+    return;
+
+  if (post->GetKineticEnergy() < min_energy_) return;
+
+  LibraryParticle p = {};
+  p.pdg = pdef->GetPDGEncoding();
+  p.weight = track->GetWeight();
+  p.px  = post->GetMomentum().x() / MeV;
+  p.py  = post->GetMomentum().y() / MeV;
+  p.pz  = post->GetMomentum().z() / MeV;
+  p.t   = post->GetGlobalTime() / ns;
+  p.x   = post->GetPosition().x() / mm;
+  p.y   = post->GetPosition().y() / mm;
+  p.z   = post->GetPosition().z() / mm;
+  particles_.push_back(p);
+
+  if (kill_)
+    track->SetTrackStatus(fStopAndKill);
+}
+
+
+
+void PhaseSpaceSteppingAction::BeginOfRun()
+{
+  volumes_.clear();
+
+  for (const G4VPhysicalVolume* pv: *G4PhysicalVolumeStore::GetInstance())
+    if (pv->GetName() == volume_) volumes_.push_back(pv);
+
+  if (volumes_.empty()) {
+    G4String msg = "Unknown volume: " + volume_;
+    G4Exception("[PhaseSpaceSteppingAction]", "BeginOfRun()", FatalException, msg);
+  }
+}
+
+
+
+void PhaseSpaceSteppingAction::AddSelectedParticle(G4String particle_name)
+{
+  G4ParticleDefinition* pdef =
+    G4ParticleTable::GetParticleTable()->FindParticle(particle_name);
+  if (!pdef) {
+    G4String msg = "No particle description was found for particle name " + particle_name;
+    G4Exception("[PhaseSpaceSteppingAction]", "AddSelectedParticle()", FatalException, msg);
+  }
+  selected_particles_.push_back(pdef);
+}
+
+
+
+void PhaseSpaceSteppingAction::WriteEvent()
+{
+  if (particles_.empty()) return;
+
+  writer_.AddEvent(event_, particles_);
+  particles_.clear();
+}
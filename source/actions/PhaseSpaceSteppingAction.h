@@ -0,0 +1,75 @@
+// ----------------------------------------------------------------------------
+// nexus | PhaseSpaceSteppingAction.h
+//
+// This class records the particles that enter a given volume (e.g., the
+// air inside the shielding) in a primary event library, so that they can
+// be replayed later with the PhaseSpaceGenerator. It is meant for two-stage
+// simulations of external backgrounds: the expensive transport through the
+// outer shielding is done once, and the recorded phase space is then reused
+// by any number of simulations of the inner detector. Each recorded
+// particle keeps the weight of its track, which includes the weight of the
+// primary vertex and that of the biasing (e.g., importance sampling), and
+// the library header keeps the number of simulated events for the
+// normalisation. By default, the recorded particles are killed.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PHASE_SPACE_STEPPING_ACTION_H
+#define PHASE_SPACE_STEPPING_ACTION_H
+
+#include "PrimaryEventLibrary.h"
+
+#include <G4UserSteppingAction.hh>
+#include <globals.hh>
+
+#include <vector>
+
+class G4GenericMessenger;
+class G4ParticleDefinition;
+class G4VPhysicalVolume;
+
+
+namespace nexus {
+
+  class PhaseSpaceSteppingAction: public G4UserSteppingAction
+  {
+  public:
+    /// Constructor
+    PhaseSpaceSteppingAction();
+    /// Destructor. The library is written if any event was processed.
+    ~PhaseSpaceSteppingAction();
+
+    virtual void UserSteppingAction(const G4Step*);
+
+    /// Find the physical volumes with the name of the recorded one,
+    /// failing if there are none. Called by the run action at the
+    /// start of the run.
+    void BeginOfRun();
+
+  private:
+    void AddSelectedParticle(G4String);
+    /// Write the particles recorded in the current event, if any
+    void WriteEvent();
+
+  private:
+    G4GenericMessenger* msg_;
+
+    G4String volume_;      ///< Name of the volume whose entrance is recorded
+    std::vector<const G4VPhysicalVolume*> volumes_; ///< Volumes with that name
+    G4String file_;        ///< Base name of the output library
+    G4double min_energy_;  ///< Minimum kinetic energy of the recorded particles
+    G4bool   kill_;        ///< Whether the recorded particles are killed
+    std::vector<const G4ParticleDefinition*> selected_particles_;
+
+    PrimaryEventLibraryWriter writer_;
+    G4String filename_;       ///< Name of the library written by this thread
+    G4int run_id_, event_id_; ///< Identifiers of the current event
+    LibraryEvent event_;
+    std::vector<LibraryParticle> particles_; ///< Particles of the current event
+    uint64_t nevents_; ///< Number of events processed
+  };
+
+} // namespace nexus
+
+#endif
@@ -59,7 +59,7 @@ kill_after_selection_(false)
   PersistencyManager* pm = dynamic_cast<PersistencyManager*>
         (G4VPersistencyManager::GetPersistencyManager());
 
-  pm->StoreSteps(true);
+  if (pm) pm->StoreSteps(true);
 
 }
 
@@ -0,0 +1,104 @@
+// ----------------------------------------------------------------------------
+// nexus | StagedStackingAction.cc
+//
+// This class defers the tracking of ionization electrons and optical photons
+// to a second stage of the event. When the first stage is finished, the
+// energy deposited so far is compared with the energy window of the
+// DefaultEventAction (if one has been set) and, if it is outside of it,
+// the rest of the event is discarded, so that the drift and the light
+// production are not simulated for events that will not be saved.
+// Derived classes can replace the selection overriding KeepEvent.
+// The deposited energy is read from the trajectories, so the
+// DefaultTrackingAction must be used. The number of discarded events
+// is reported at the end of the run.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "StagedStackingAction.h"
+#include "DefaultEventAction.h"
+#include "IonizationElectron.h"
+#include "Trajectory.h"
+#include "TrajectoryMap.h"
+#include "FactoryBase.h"
+
+#include <G4Track.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4StackManager.hh>
+#include <G4EventManager.hh>
+#include <G4AccumulableManager.hh>
+
+using namespace nexus;
+
+REGISTER_CLASS(StagedStackingAction, G4UserStackingAction)
+
+
+StagedStackingAction::StagedStackingAction():
+  G4UserStackingAction(), first_stage_(true),
+  rejected_("Events discarded after the first stage", 0)
+{
+  G4AccumulableManager::Instance()->RegisterAccumulable(rejected_);
+}
+
+
+
+StagedStackingAction::~StagedStackingAction()
+{
+}
+
+
+
+G4ClassificationOfNewTrack
+StagedStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  // Once the event has passed the selection, tracks are no longer deferred
+  if (!first_stage_) return fUrgent;
+
+  const G4ParticleDefinition* pdef = track->GetDefinition();
+  if (pdef == IonizationElectron::Definition() ||
+      pdef == G4OpticalPhoton::Definition())
+    return fWaiting;
+
+  return fUrgent;
+}
+
+
+
+void StagedStackingAction::NewStage()
+{
+  if (!first_stage_) return;
+  first_stage_ = false;
+
+  if (!KeepEvent()) {
+    // Drop the deferred tracks. The event is then finished as usual
+    // and rejected by the event action.
+    stackManager->clear();
+    rejected_ += 1;
+  }
+}
+
+
+
+void StagedStackingAction::PrepareNewEvent()
+{
+  first_stage_ = true;
+}
+
+
+
+G4bool StagedStackingAction::KeepEvent()
+{
+  // Use the same window as the event action, so that no event
+  // that would be saved is discarded
+  const DefaultEventAction* event_action = dynamic_cast<const DefaultEventAction*>
+    (G4EventManager::GetEventManager()->GetUserEventAction());
+  if (!event_action || !event_action->HasEnergyWindow()) return true;
+
+  // The energy deposited in the ionization sensitive detectors is
+  // accumulated in the trajectories and weighted, like in DefaultEventAction
+  G4double edep = 0.;
+  for (const auto& entry: TrajectoryMap::GetMap())
+    edep += ((Trajectory*) entry.second)->GetWeightedEnergyDeposit();
+
+  return event_action->IsInEnergyWindow(edep);
+}
@@ -0,0 +1,55 @@
+// ----------------------------------------------------------------------------
+// nexus | StagedStackingAction.h
+//
+// This class defers the tracking of ionization electrons and optical photons
+// to a second stage of the event. When the first stage is finished, the
+// energy deposited so far is compared with the energy window of the
+// DefaultEventAction (if one has been set) and, if it is outside of it,
+// the rest of the event is discarded, so that the drift and the light
+// production are not simulated for events that will not be saved.
+// Derived classes can replace the selection overriding KeepEvent.
+// The deposited energy is read from the trajectories, so the
+// DefaultTrackingAction must be used. The number of discarded events
+// is reported at the end of the run.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef STAGED_STACKING_ACTION_H
+#define STAGED_STACKING_ACTION_H
+
+#include <G4UserStackingAction.hh>
+#include <G4Accumulable.hh>
+
+
+namespace nexus {
+
+  class StagedStackingAction: public G4UserStackingAction
+  {
+  public:
+    /// Constructor
+    StagedStackingAction();
+    /// Destructor
+    ~StagedStackingAction();
+
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+    virtual void NewStage();
+    virtual void PrepareNewEvent();
+
+  protected:
+    /// Decide, at the end of the first stage, whether the rest of the
+    /// event must be simulated. By default, the energy deposited
+    /// in the ionization sensitive detectors must be within the
+    /// window of the DefaultEventAction; all events are kept if
+    /// no window has been set or another event action is used.
+    virtual G4bool KeepEvent();
+
+  private:
+    G4bool first_stage_; ///< Whether the event is in its first stage
+    /// Number of events discarded after the first stage in the current run
+    G4Accumulable<G4long> rejected_;
+  };
+
+} // end namespace nexus
+
+#endif
@@ -0,0 +1,79 @@
+// ----------------------------------------------------------------------------
+// nexus | SubEventStackingAction.cc
+//
+// This class sends the optical photons produced by electroluminescence to
+// the sub-event stack, so that they are tracked in batches by the worker
+// threads while the rest of the event is tracked by the master thread.
+// It requires running nexus with the sub-event option (-s) and Geant4 11.2
+// or later; otherwise, all tracks are classified as urgent.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SubEventStackingAction.h"
+#include "IonizationElectron.h"
+#include "ThinningTrackingAction.h"
+#include "TrajectoryMap.h"
+#include "FactoryBase.h"
+
+#include <G4Track.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4VProcess.hh>
+#include <G4ProcessTable.hh>
+#include <G4Threading.hh>
+#include <G4Version.hh>
+
+using namespace nexus;
+
+REGISTER_CLASS(SubEventStackingAction, G4UserStackingAction)
+
+
+SubEventStackingAction::SubEventStackingAction():
+  G4UserStackingAction(), el_process_(nullptr), el_process_found_(false)
+{
+}
+
+
+
+SubEventStackingAction::~SubEventStackingAction()
+{
+}
+
+
+
+G4ClassificationOfNewTrack
+SubEventStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+#if G4VERSION_NUMBER >= 1120
+  // Only the master thread splits the event; in the worker threads,
+  // the photons of a sub-event are tracked as usual
+  if (G4Threading::IsWorkerThread()) return fUrgent;
+
+  if (!el_process_found_) {
+    el_process_ = G4ProcessTable::GetProcessTable()->
+      FindProcess("Electroluminescence", IonizationElectron::Definition());
+    el_process_found_ = true;
+  }
+
+  if (el_process_ && track->GetCreatorProcess() == el_process_ &&
+      track->GetDefinition() == G4OpticalPhoton::Definition())
+    return fSubEvent_0;
+#else
+  (void) track;
+#endif
+
+  return fUrgent;
+}
+
+
+
+void SubEventStackingAction::PrepareNewEvent()
+{
+  // The worker threads track the sub-events without generating
+  // primaries, so the event set-up is done here
+  if (!G4Threading::IsWorkerThread()) return;
+
+  // The trajectories of the previous sub-event are not looked up any more
+  TrajectoryMap::BeginEvent();
+  ThinningTrackingAction::Register();
+}
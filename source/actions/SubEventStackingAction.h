@@ -0,0 +1,44 @@
+// ----------------------------------------------------------------------------
+// nexus | SubEventStackingAction.h
+//
+// This class sends the optical photons produced by electroluminescence to
+// the sub-event stack, so that they are tracked in batches by the worker
+// threads while the rest of the event is tracked by the master thread.
+// It requires running nexus with the sub-event option (-s) and Geant4 11.2
+// or later; otherwise, all tracks are classified as urgent.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SUBEVENT_STACKING_ACTION_H
+#define SUBEVENT_STACKING_ACTION_H
+
+#include <G4UserStackingAction.hh>
+
+class G4VProcess;
+
+
+namespace nexus {
+
+  class SubEventStackingAction: public G4UserStackingAction
+  {
+  public:
+    /// Constructor
+    SubEventStackingAction();
+    /// Destructor
+    ~SubEventStackingAction();
+
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+    virtual void PrepareNewEvent();
+
+  private:
+    /// Electroluminescence process of the current thread, looked up
+    /// with the first track (the processes do not exist yet when the
+    /// action is created)
+    const G4VProcess* el_process_;
+    G4bool el_process_found_;
+  };
+
+} // end namespace nexus
+
+#endif
@@ -0,0 +1,73 @@
+// ----------------------------------------------------------------------------
+// nexus | ThinningTrackingAction.cc
+//
+// This class passes the thinning weight of the optical photons produced with
+// thinning on to the photons they produce through Geant4 processes (e.g.,
+// wavelength shifting), which only inherit the track weight. It is not meant
+// to be chosen in the macros: it is added to the chosen tracking action of
+// each thread once thinning is enabled, so that it costs nothing otherwise.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "ThinningTrackingAction.h"
+
+#include "ThinningInformation.h"
+
+#include <G4Track.hh>
+#include <G4TrackingManager.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4RunManager.hh>
+#include <G4MultiTrackingAction.hh>
+
+using namespace nexus;
+
+
+G4ThreadLocal G4bool ThinningTrackingAction::registered_ = false;
+
+
+
+ThinningTrackingAction::ThinningTrackingAction(): G4UserTrackingAction()
+{
+}
+
+
+
+ThinningTrackingAction::~ThinningTrackingAction()
+{
+}
+
+
+
+void ThinningTrackingAction::Register()
+{
+  if (registered_ || !ThinningInformation::IsThinningEnabled()) return;
+
+  // The chosen action (if any) is handed over to a multiple action that
+  // runs it before this one. The tracking manager only deletes the action
+  // it holds, which now owns the chosen one.
+  G4RunManager* runmgr = G4RunManager::GetRunManager();
+  auto trkact = std::make_unique<G4MultiTrackingAction>();
+  G4UserTrackingAction* chosen =
+    const_cast<G4UserTrackingAction*>(runmgr->GetUserTrackingAction());
+  if (chosen) trkact->push_back(std::unique_ptr<G4UserTrackingAction>(chosen));
+  trkact->push_back(std::make_unique<ThinningTrackingAction>());
+  runmgr->SetUserAction(trkact.release());
+
+  registered_ = true;
+}
+
+
+
+void ThinningTrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  G4double weight = ThinningInformation::GetWeight(*track);
+  if (weight == 1.) return;
+
+  // Photons created by nexus processes are already marked
+  for (G4Track* secondary: *fpTrackingManager->GimmeSecondaries()) {
+    if (secondary->GetDefinition() == G4OpticalPhoton::Definition() &&
+        !secondary->GetUserInformation())
+      secondary->SetUserInformation(new ThinningInformation(weight));
+  }
+}
@@ -0,0 +1,44 @@
+// ----------------------------------------------------------------------------
+// nexus | ThinningTrackingAction.h
+//
+// This class passes the thinning weight of the optical photons produced with
+// thinning on to the photons they produce through Geant4 processes (e.g.,
+// wavelength shifting), which only inherit the track weight. It is not meant
+// to be chosen in the macros: it is added to the chosen tracking action of
+// each thread once thinning is enabled, so that it costs nothing otherwise.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef THINNING_TRACKING_ACTION_H
+#define THINNING_TRACKING_ACTION_H
+
+#include <G4UserTrackingAction.hh>
+
+class G4Track;
+
+
+namespace nexus {
+
+  class ThinningTrackingAction: public G4UserTrackingAction
+  {
+  public:
+    /// Constructor
+    ThinningTrackingAction();
+    /// Destructor
+    virtual ~ThinningTrackingAction();
+
+    virtual void PostUserTrackingAction(const G4Track*);
+
+    /// Add an instance of the action to the tracking action of the
+    /// current thread if thinning is enabled and it was not added yet.
+    /// It must be called before the tracking of an event begins.
+    static void Register();
+
+  private:
+    static G4ThreadLocal G4bool registered_;
+  };
+
+} // end namespace nexus
+
+#endif
@@ -0,0 +1,157 @@
+// ----------------------------------------------------------------------------
+// nexus | ActionInitialization.cc
+//
+// This class instantiates the primary generator, the persistency manager
+// and the user actions chosen in the initialization macro. In multithreaded
+// mode, a set of instances is created for each worker thread. In sub-event
+// mode, the master thread processes the events and owns the persistency
+// manager, while the workers only track the sub-events.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "ActionInitialization.h"
+
+#include "PrimaryGeneration.h"
+#include "EventAbortManager.h"
+#include "FactoryBase.h"
+
+#include <G4VPrimaryGenerator.hh>
+#include <G4UserRunAction.hh>
+#include <G4UserEventAction.hh>
+#include <G4UserTrackingAction.hh>
+#include <G4UserSteppingAction.hh>
+#include <G4UserStackingAction.hh>
+
+using namespace nexus;
+using std::make_unique;
+
+
+ActionInitialization::ActionInitialization():
+  G4VUserActionInitialization(), subevent_mode_(false)
+{
+}
+
+
+
+ActionInitialization::~ActionInitialization()
+{
+}
+
+
+
+void ActionInitialization::SetMacros(const G4String& init_macro,
+                                     const std::vector<G4String>& macros,
+                                     const std::vector<G4String>& delayed)
+{
+  init_macro_ = init_macro;
+  macros_     = macros;
+  delayed_    = delayed;
+}
+
+
+
+void ActionInitialization::Build() const
+{
+  // In sub-event mode, the output is written by the master thread only
+  BuildActions(!subevent_mode_);
+}
+
+
+
+void ActionInitialization::BuildActions(G4bool with_pm) const
+{
+  // The counters of the worker threads are summed in the master, so
+  // they are registered in the same order in all threads (see BuildForMaster)
+  EventAbortManager::Instance().RegisterCounters();
+
+  // The persistency manager is created first, since some actions
+  // configure it in their constructors. It registers itself as the
+  // persistency manager of the current thread, and it is deleted
+  // by the application (or the worker initialization) at the end.
+  if (with_pm && !pm_name_.empty()) {
+    auto pm = ObjFactory<PersistencyManagerBase>::Instance().CreateObject(pm_name_);
+    pm->SetMacros(init_macro_, macros_, delayed_);
+    // In sub-event mode, there is no persistency manager in the workers,
+    // so there is nothing to sum to the counters of the master
+    if (!subevent_mode_) pm->RegisterCounters();
+    pm.release();
+  }
+
+  auto pg = make_unique<PrimaryGeneration>();
+  pg->SetGenerator(ObjFactory<G4VPrimaryGenerator>::Instance().CreateObject(gen_name_));
+  SetUserAction(pg.release());
+
+  if (!runact_name_.empty()) {
+    auto runact = ObjFactory<G4UserRunAction>::Instance().CreateObject(runact_name_);
+    SetUserAction(runact.release());
+  }
+
+  if (!evtact_name_.empty()) {
+    auto evtact = ObjFactory<G4UserEventAction>::Instance().CreateObject(evtact_name_);
+    SetUserAction(evtact.release());
+  }
+
+  if (!stkact_name_.empty()) {
+    auto stkact = ObjFactory<G4UserStackingAction>::Instance().CreateObject(stkact_name_);
+    SetUserAction(stkact.release());
+  }
+
+  // The thinning tracking action is added to this one when the first
+  // event begins, if thinning is enabled (see ThinningTrackingAction)
+  if (!trkact_name_.empty()) {
+    auto trkact = ObjFactory<G4UserTrackingAction>::Instance().CreateObject(trkact_name_);
+    SetUserAction(trkact.release());
+  }
+
+  if (!stepact_name_.empty()) {
+    auto stepact = ObjFactory<G4UserSteppingAction>::Instance().CreateObject(stepact_name_);
+    SetUserAction(stepact.release());
+  }
+}
+
+
+
+void ActionInitialization::BuildForMaster() const
+{
+  // In sub-event mode, the master thread tracks the events
+  // and hands the sub-events over to the workers
+  if (subevent_mode_) {
+    BuildActions(true);
+    return;
+  }
+
+  EventAbortManager::Instance().RegisterCounters();
+
+  if (!runact_name_.empty()) {
+    auto runact = ObjFactory<G4UserRunAction>::Instance().CreateObject(runact_name_);
+    SetUserAction(runact.release());
+  }
+
+  // The generator, the persistency manager and the remaining actions
+  // only run in the worker threads. However, their messenger commands
+  // must exist in the master thread for the configuration macros to be
+  // executed there (the commands are then broadcast to the workers).
+  // Therefore, we create here an instance of each of them that is never used.
+  // The one of the persistency manager also holds the sum of the run counters
+  // of the workers, which must be registered in the same order as theirs.
+  if (!pm_name_.empty()) {
+    master_pm_ = ObjFactory<PersistencyManagerBase>::Instance().CreateObject(pm_name_);
+    master_pm_->SetMacros(init_macro_, macros_, delayed_);
+    master_pm_->RegisterCounters();
+  }
+
+  master_gen_ = ObjFactory<G4VPrimaryGenerator>::Instance().CreateObject(gen_name_);
+
+  if (!evtact_name_.empty())
+    master_evtact_ = ObjFactory<G4UserEventAction>::Instance().CreateObject(evtact_name_);
+
+  if (!stkact_name_.empty())
+    master_stkact_ = ObjFactory<G4UserStackingAction>::Instance().CreateObject(stkact_name_);
+
+  if (!trkact_name_.empty())
+    master_trkact_ = ObjFactory<G4UserTrackingAction>::Instance().CreateObject(trkact_name_);
+
+  if (!stepact_name_.empty())
+    master_stepact_ = ObjFactory<G4UserSteppingAction>::Instance().CreateObject(stepact_name_);
+}
@@ -0,0 +1,123 @@
+// ----------------------------------------------------------------------------
+// nexus | ActionInitialization.h
+//
+// This class instantiates the primary generator, the persistency manager
+// and the user actions chosen in the initialization macro. In multithreaded
+// mode, a set of instances is created for each worker thread. In sub-event
+// mode, the master thread processes the events and owns the persistency
+// manager, while the workers only track the sub-events.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef ACTION_INITIALIZATION_H
+#define ACTION_INITIALIZATION_H
+
+#include "PersistencyManagerBase.h"
+
+#include <G4VUserActionInitialization.hh>
+#include <globals.hh>
+
+#include <memory>
+#include <vector>
+
+class G4VPrimaryGenerator;
+class G4UserEventAction;
+class G4UserSteppingAction;
+class G4UserTrackingAction;
+class G4UserStackingAction;
+
+
+namespace nexus {
+
+  class ActionInitialization: public G4VUserActionInitialization
+  {
+  public:
+    /// Constructor
+    ActionInitialization();
+    /// Destructor
+    ~ActionInitialization();
+
+    /// Create the generator, persistency manager and user actions
+    /// of a worker thread (or of the application in sequential mode)
+    virtual void Build() const;
+
+    /// Create the run action of the master thread (or, in
+    /// sub-event mode, all the user actions of the master thread)
+    virtual void BuildForMaster() const;
+
+    /// Enable the sub-event mode
+    void SetSubEventMode(G4bool);
+
+    void SetGeneratorName(const G4String&);
+    void SetPersistencyManagerName(const G4String&);
+    void SetRunActionName(const G4String&);
+    void SetEventActionName(const G4String&);
+    void SetSteppingActionName(const G4String&);
+    void SetTrackingActionName(const G4String&);
+    void SetStackingActionName(const G4String&);
+
+    /// Set the macros to be saved by the persistency manager
+    void SetMacros(const G4String& init_macro,
+                   const std::vector<G4String>& macros,
+                   const std::vector<G4String>& delayed);
+
+  private:
+    /// Create the generator and user actions of the current thread,
+    /// and the persistency manager if requested
+    void BuildActions(G4bool with_pm) const;
+
+  private:
+    G4bool subevent_mode_;
+
+    G4String gen_name_; ///< Name of the chosen primary generator
+    G4String pm_name_;  ///< Name of the chosen persistency manager
+    G4String runact_name_; ///< Name of the chosen run action
+    G4String evtact_name_; ///< Name of the chosen event action
+    G4String stepact_name_; ///< Name of the chosen stepping action
+    G4String trkact_name_; ///< Name of the chosen tracking action
+    G4String stkact_name_; ///< Name of the chosen stacking action
+
+    G4String init_macro_;
+    std::vector<G4String> macros_;
+    std::vector<G4String> delayed_;
+
+    // Instances created in the master thread in multithreaded mode
+    // only to define their messenger commands there
+    mutable std::unique_ptr<PersistencyManagerBase> master_pm_;
+    mutable std::unique_ptr<G4VPrimaryGenerator> master_gen_;
+    mutable std::unique_ptr<G4UserEventAction> master_evtact_;
+    mutable std::unique_ptr<G4UserSteppingAction> master_stepact_;
+    mutable std::unique_ptr<G4UserTrackingAction> master_trkact_;
+    mutable std::unique_ptr<G4UserStackingAction> master_stkact_;
+  };
+
+  // INLINE DEFINITIONS ////////////////////////////////////
+
+  inline void ActionInitialization::SetSubEventMode(G4bool b)
+  { subevent_mode_ = b; }
+
+  inline void ActionInitialization::SetGeneratorName(const G4String& name)
+  { gen_name_ = name; }
+
+  inline void ActionInitialization::SetPersistencyManagerName(const G4String& name)
+  { pm_name_ = name; }
+
+  inline void ActionInitialization::SetRunActionName(const G4String& name)
+  { runact_name_ = name; }
+
+  inline void ActionInitialization::SetEventActionName(const G4String& name)
+  { evtact_name_ = name; }
+
+  inline void ActionInitialization::SetSteppingActionName(const G4String& name)
+  { stepact_name_ = name; }
+
+  inline void ActionInitialization::SetTrackingActionName(const G4String& name)
+  { trkact_name_ = name; }
+
+  inline void ActionInitialization::SetStackingActionName(const G4String& name)
+  { stkact_name_ = name; }
+
+} // namespace nexus
+
+#endif
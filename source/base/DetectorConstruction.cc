@@ -8,6 +8,13 @@
 
 #include "DetectorConstruction.h"
 #include "GeometryBase.h"
+#include "EventAbortManager.h"
+#include "StartupProfiler.h"
+#include "VetoSD.h"
+#include "MeshTransmissionTable.h"
+#include "MeshTransmissionModel.h"
+#include "WLSFiberInfo.h"
+#include "WLSFiberModel.h"
 
 #include <G4Box.hh>
 #include <G4Material.hh>
@@ -15,6 +22,14 @@
 #include <G4LogicalVolume.hh>
 #include <G4VisAttributes.hh>
 #include <G4PVPlacement.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4VSensitiveDetector.hh>
+#include <G4SDManager.hh>
+#include <G4Threading.hh>
+#include <G4Region.hh>
+#include <G4RegionStore.hh>
+
+#include <map>
 
 
 using namespace nexus;
@@ -23,6 +38,9 @@ using namespace nexus;
 
 DetectorConstruction::DetectorConstruction(): geometry_(nullptr)
 {
+  // Define the commands of the event abort conditions
+  // before the configuration macros are executed
+  EventAbortManager::Instance();
 }
 
 
@@ -44,7 +62,7 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // At this point the user should have loaded the configuration
   // parameters of the geometry or it will get built with the
   // default values.
-  geometry_->Construct();
+  StartupProfiler::Measure("geometry", [this]{ geometry_->Construct(); });
 
   // We define now the world volume as an empty box big enough
   // to fit the user's geometry inside.
@@ -71,10 +89,72 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   new G4PVPlacement(0, G4ThreeVector(0,0,0),
 		    geometry_logic, geometry_logic->GetName(), world_logic, false, 0);
 
+  // Attach a veto sensitive detector to the veto volumes, if any
+  const std::vector<G4String>& veto_volumes =
+    EventAbortManager::Instance().GetVetoVolumes();
+
+  if (!veto_volumes.empty()) {
+    VetoSD* veto_sd = new VetoSD("/NEXUS/VETO");
+    G4SDManager::GetSDMpointer()->AddNewDetector(veto_sd);
+
+    for (const G4String& name: veto_volumes) {
+      G4LogicalVolume* lv = G4LogicalVolumeStore::GetInstance()->GetVolume(name, false);
+      if (!lv) {
+        G4String msg = "Unknown veto volume: " + name;
+        G4Exception("[DetectorConstruction]", "Construct()", FatalException, msg);
+      }
+      if (lv->GetSensitiveDetector()) {
+        G4String msg = "Veto volume " + name + " is already a sensitive detector.";
+        G4Exception("[DetectorConstruction]", "Construct()", FatalException, msg);
+      }
+      lv->SetSensitiveDetector(veto_sd);
+    }
+  }
+
+  // Keep track of the sensitive detectors set by the geometry, so that
+  // worker threads can create their own copies in ConstructSDandField()
+  sd_volumes_.clear();
+  for (G4LogicalVolume* lv: *G4LogicalVolumeStore::GetInstance()) {
+    G4VSensitiveDetector* sd = lv->GetSensitiveDetector();
+    if (sd) sd_volumes_.push_back(std::make_pair(lv, sd));
+  }
+
   return world_physi;
 }
 
 
+
+void DetectorConstruction::ConstructSDandField()
+{
+  // Fast simulation models are thread-local, so each thread creates
+  // its own for the regions with a mesh transmission table or WLS fiber
+  // information attached (they are owned by the fast simulation manager
+  // of the region)
+  for (G4Region* region: MeshTransmissionTable::GetRegions())
+    new MeshTransmissionModel(region);
+
+  for (G4Region* region: *G4RegionStore::GetInstance())
+    if (dynamic_cast<WLSFiberInfo*>(region->GetUserInformation()))
+      new WLSFiberModel(region);
+
+  // In the master thread (and in sequential mode) the sensitive
+  // detectors have already been attached by the geometry
+  if (!G4Threading::IsWorkerThread()) return;
+
+  std::map<G4VSensitiveDetector*, G4VSensitiveDetector*> clones;
+
+  for (auto& sdv: sd_volumes_) {
+    G4VSensitiveDetector* sd = clones[sdv.second];
+    if (!sd) {
+      sd = sdv.second->Clone();
+      G4SDManager::GetSDMpointer()->AddNewDetector(sd);
+      clones[sdv.second] = sd;
+    }
+    SetSensitiveDetector(sdv.first, sd);
+  }
+}
+
+
 void DetectorConstruction::SetGeometry(std::unique_ptr<GeometryBase> geo)
 {
   geometry_ = std::move(geo);
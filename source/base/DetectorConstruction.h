@@ -12,8 +12,11 @@
 #include <G4VUserDetectorConstruction.hh>
 
 #include <memory>
+#include <vector>
 
 class G4GenericMessenger;
+class G4LogicalVolume;
+class G4VSensitiveDetector;
 
 namespace nexus {
 
@@ -31,6 +34,11 @@ namespace nexus {
     /// It returns the physical volume that represents the world.
     virtual G4VPhysicalVolume* Construct();
 
+    /// Invoked by the run manager in every thread after Construct().
+    /// In worker threads, it attaches to the logical volumes a thread-local
+    /// copy of the sensitive detectors created by the geometry.
+    virtual void ConstructSDandField();
+
     /// Set a detector geometry
     void SetGeometry(std::unique_ptr<GeometryBase>);
     /// Get the detector geometry
@@ -38,6 +46,10 @@ namespace nexus {
 
   private:
     std::unique_ptr<GeometryBase> geometry_;
+
+    /// Sensitive detectors (as created in the master thread)
+    /// attached to the logical volumes of the geometry
+    std::vector<std::pair<G4LogicalVolume*, G4VSensitiveDetector*>> sd_volumes_;
   };
 
 
@@ -0,0 +1,136 @@
+// ----------------------------------------------------------------------------
+// nexus | EventAbortManager.cc
+//
+// This class aborts the current event as soon as it is known that it will
+// not be saved: when the energy deposited in the ionization sensitive
+// detectors exceeds the maximum energy of the DefaultEventAction window,
+// or when a particle deposits energy in one of the veto volumes. The number
+// of aborted events is counted for each run and summed over all threads.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "EventAbortManager.h"
+#include "DefaultEventAction.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4AccumulableManager.hh>
+#include <G4EventManager.hh>
+#include <G4Event.hh>
+
+using namespace nexus;
+
+
+G4ThreadLocal G4double EventAbortManager::edep_ = 0.;
+G4ThreadLocal G4double EventAbortManager::max_energy_ = DBL_MAX;
+G4ThreadLocal G4bool EventAbortManager::aborted_ = false;
+G4ThreadLocal G4Accumulable<G4long>* EventAbortManager::n_energy_ = nullptr;
+G4ThreadLocal G4Accumulable<G4long>* EventAbortManager::n_veto_ = nullptr;
+
+
+
+EventAbortManager& EventAbortManager::Instance()
+{
+  // The instance is never deleted, so that its messenger
+  // outlives the UI manager
+  static EventAbortManager* instance = new EventAbortManager();
+  return *instance;
+}
+
+
+
+EventAbortManager::EventAbortManager(): msg_(0), energy_window_(false)
+{
+  msg_ = new G4GenericMessenger(this, "/nexus/abort/",
+                                "Control commands of the early abort of events.");
+
+  // The configuration is shared by all threads,
+  // so the commands are applied in the master thread only
+  G4GenericMessenger::Command& energy_cmd =
+    msg_->DeclareProperty("energy_window", energy_window_,
+                          "Abort the event once the deposited energy exceeds "
+                          "the max_energy of DefaultEventAction.");
+  energy_cmd.SetToBeBroadcasted(false);
+
+  G4GenericMessenger::Command& veto_cmd =
+    msg_->DeclareMethod("veto_volume", &EventAbortManager::AddVetoVolume,
+                        "Abort the event if energy is deposited in this logical volume.");
+  veto_cmd.SetToBeBroadcasted(false);
+}
+
+
+
+EventAbortManager::~EventAbortManager()
+{
+  delete msg_;
+}
+
+
+
+void EventAbortManager::AddVetoVolume(G4String name)
+{
+  veto_volumes_.push_back(name);
+}
+
+
+
+void EventAbortManager::RegisterCounters()
+{
+  if (n_energy_) return;
+
+  // The counters are never deleted, since the accumulable
+  // manager of the thread keeps a reference to them
+  n_energy_ = new G4Accumulable<G4long>("Events aborted by energy", 0);
+  n_veto_   = new G4Accumulable<G4long>("Events aborted by veto", 0);
+
+  G4AccumulableManager* accumulables = G4AccumulableManager::Instance();
+  accumulables->RegisterAccumulable(*n_energy_);
+  accumulables->RegisterAccumulable(*n_veto_);
+}
+
+
+
+void EventAbortManager::BeginEvent()
+{
+  edep_ = 0.;
+  aborted_ = false;
+
+  // The event action of the thread is looked up once per event
+  max_energy_ = DBL_MAX;
+  if (!energy_window_) return;
+
+  const DefaultEventAction* event_action = dynamic_cast<const DefaultEventAction*>
+    (G4EventManager::GetEventManager()->GetUserEventAction());
+  if (event_action) max_energy_ = event_action->GetMaxEnergy();
+}
+
+
+
+void EventAbortManager::AddEnergy(G4double edep)
+{
+  if (max_energy_ == DBL_MAX || aborted_) return;
+
+  // The event is saved only if the deposit is below the maximum energy
+  edep_ += edep;
+  if (edep_ >= max_energy_ && Abort() && n_energy_) *n_energy_ += 1;
+}
+
+
+
+void EventAbortManager::Veto()
+{
+  if (aborted_) return;
+  if (Abort() && n_veto_) *n_veto_ += 1;
+}
+
+
+
+G4bool EventAbortManager::Abort()
+{
+  G4EventManager* evtmgr = G4EventManager::GetEventManager();
+  if (!evtmgr || !evtmgr->GetConstCurrentEvent()) return false;
+
+  evtmgr->AbortCurrentEvent();
+  aborted_ = true;
+  return true;
+}
@@ -0,0 +1,101 @@
+// ----------------------------------------------------------------------------
+// nexus | EventAbortManager.h
+//
+// This class aborts the current event as soon as it is known that it will
+// not be saved: when the energy deposited in the ionization sensitive
+// detectors exceeds the maximum energy of the DefaultEventAction window,
+// or when a particle deposits energy in one of the veto volumes. The number
+// of aborted events is counted for each run and summed over all threads.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef EVENT_ABORT_MANAGER_H
+#define EVENT_ABORT_MANAGER_H
+
+#include <G4Accumulable.hh>
+#include <globals.hh>
+#include <vector>
+
+class G4GenericMessenger;
+
+
+namespace nexus {
+
+  class EventAbortManager
+  {
+  public:
+    /// Return the single instance of the class. It must be created
+    /// in the master thread, before the configuration macros are executed.
+    static EventAbortManager& Instance();
+
+    /// Register the counters of aborted events of the current thread
+    /// as accumulables. It must be done in all threads in the same order
+    /// with respect to the other accumulables.
+    void RegisterCounters();
+
+    /// Reset the energy accumulated in the current event
+    void BeginEvent();
+    /// Add the energy of an ionization hit (weighted as the deposits of the
+    /// trajectories), aborting the event if the maximum energy is exceeded
+    void AddEnergy(G4double edep);
+    /// Abort the event because a veto volume has been hit
+    void Veto();
+
+    /// Whether any abort condition has been set
+    G4bool IsEnabled() const;
+
+    /// Names of the logical volumes used as veto
+    const std::vector<G4String>& GetVetoVolumes() const;
+
+    /// Number of events of the current run (and thread)
+    /// aborted because of their energy
+    G4long GetAbortedByEnergy() const;
+    /// Number of events of the current run (and thread)
+    /// aborted because of a veto volume
+    G4long GetAbortedByVeto() const;
+
+  private:
+    EventAbortManager();
+    ~EventAbortManager();
+    EventAbortManager(const EventAbortManager&) = delete;
+
+    void AddVetoVolume(G4String);
+
+    /// Abort the current event, if not done yet
+    G4bool Abort();
+
+  private:
+    G4GenericMessenger* msg_;
+
+    // Configuration, shared by all threads
+    G4bool energy_window_;
+    std::vector<G4String> veto_volumes_;
+
+    // State of the event being simulated by each thread
+    static G4ThreadLocal G4double edep_;
+    static G4ThreadLocal G4double max_energy_;
+    static G4ThreadLocal G4bool aborted_;
+
+    // Counters of each thread
+    static G4ThreadLocal G4Accumulable<G4long>* n_energy_;
+    static G4ThreadLocal G4Accumulable<G4long>* n_veto_;
+  };
+
+  // INLINE DEFINITIONS ////////////////////////////////////
+
+  inline G4bool EventAbortManager::IsEnabled() const
+  { return energy_window_ || !veto_volumes_.empty(); }
+
+  inline const std::vector<G4String>& EventAbortManager::GetVetoVolumes() const
+  { return veto_volumes_; }
+
+  inline G4long EventAbortManager::GetAbortedByEnergy() const
+  { return n_energy_ ? n_energy_->GetValue() : 0; }
+
+  inline G4long EventAbortManager::GetAbortedByVeto() const
+  { return n_veto_ ? n_veto_->GetValue() : 0; }
+
+} // namespace nexus
+
+#endif
@@ -0,0 +1,121 @@
+// ----------------------------------------------------------------------------
+// nexus | ImportanceParallelWorld.cc
+//
+// Parallel world used for geometry-importance biasing. It is made of the
+// nested box cells defined by the geometry (e.g., the layers of the
+// shielding), each of which is given an importance with a messenger
+// command. The importance of the world outside the cells is 1.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "ImportanceParallelWorld.h"
+
+#include "GeometryBase.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4PVPlacement.hh>
+#include <G4IStore.hh>
+
+#include <sstream>
+
+using namespace nexus;
+
+
+ImportanceParallelWorld::ImportanceParallelWorld(const G4String& name,
+                                                 const GeometryBase* geometry):
+  G4VUserParallelWorld(name), geometry_(geometry)
+{
+  msg_ = std::make_unique<G4GenericMessenger>(this, "/Biasing/Importance/",
+                                              "Control commands of the importance biasing.");
+
+  msg_->DeclareMethod("importance", &ImportanceParallelWorld::SetImportance,
+                      "Set the importance of a cell (<cell name> <importance>).");
+}
+
+
+
+ImportanceParallelWorld::~ImportanceParallelWorld()
+{
+}
+
+
+
+void ImportanceParallelWorld::SetImportance(G4String value)
+{
+  std::istringstream iss(value);
+  G4String name;
+  G4double importance = 0.;
+
+  if (!(iss >> name >> importance) || importance <= 0.) {
+    G4String msg = "Wrong importance specification: " + value;
+    G4Exception("[ImportanceParallelWorld]", "SetImportance()",
+                FatalErrorInArgument, msg.c_str());
+    return;
+  }
+
+  importances_[name] = importance;
+}
+
+
+
+void ImportanceParallelWorld::Construct()
+{
+  std::vector<GeometryBase::ImportanceCell> cells = geometry_->GetImportanceCells();
+
+  if (cells.empty())
+    G4Exception("[ImportanceParallelWorld]", "Construct()", FatalException,
+                "The geometry does not define importance biasing cells!");
+
+  // Each cell is placed inside the previous one, so the
+  // positions given by the geometry are made relative to it
+  G4LogicalVolume* mother = GetWorld()->GetLogicalVolume();
+  G4ThreeVector mother_pos;
+
+  for (const GeometryBase::ImportanceCell& cell: cells) {
+    G4String name = "IMPORTANCE_" + cell.name;
+
+    G4Box* solid = new G4Box(name, cell.half_length.x(),
+                             cell.half_length.y(), cell.half_length.z());
+
+    G4LogicalVolume* logic = new G4LogicalVolume(solid, nullptr, name);
+
+    cells_.push_back(new G4PVPlacement(nullptr, cell.position - mother_pos,
+                                       logic, cell.name, mother, false, 0));
+
+    mother     = logic;
+    mother_pos = cell.position;
+  }
+
+  for (const auto& imp: importances_) {
+    bool found = false;
+    for (const G4VPhysicalVolume* cell: cells_)
+      found = found || cell->GetName() == imp.first;
+    if (!found) {
+      G4String msg = "Unknown importance biasing cell " + imp.first + "!";
+      G4Exception("[ImportanceParallelWorld]", "Construct()",
+                  FatalErrorInArgument, msg.c_str());
+    }
+  }
+}
+
+
+
+void ImportanceParallelWorld::ConstructSD()
+{
+  // The importance store is thread-local, so it is filled here,
+  // where it is done for each thread once the geometry is built.
+  // Cells without a user-defined importance double the one of their mother.
+  G4IStore* store = G4IStore::GetInstance(GetName());
+
+  store->AddImportanceGeometryCell(1., *GetWorld());
+
+  G4double importance = 1.;
+  for (const G4VPhysicalVolume* cell: cells_) {
+    auto it = importances_.find(cell->GetName());
+    importance = (it != importances_.end()) ? it->second : 2. * importance;
+    store->AddImportanceGeometryCell(importance, *cell);
+  }
+}
@@ -0,0 +1,58 @@
+// ----------------------------------------------------------------------------
+// nexus | ImportanceParallelWorld.h
+//
+// Parallel world used for geometry-importance biasing. It is made of the
+// nested box cells defined by the geometry (e.g., the layers of the
+// shielding), each of which is given an importance with a messenger
+// command. The importance of the world outside the cells is 1.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef IMPORTANCE_PARALLEL_WORLD_H
+#define IMPORTANCE_PARALLEL_WORLD_H
+
+#include <G4VUserParallelWorld.hh>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+class G4GenericMessenger;
+class G4VPhysicalVolume;
+
+
+namespace nexus {
+
+  class GeometryBase;
+
+  class ImportanceParallelWorld: public G4VUserParallelWorld
+  {
+  public:
+    /// Constructor. The cells are taken from the given geometry.
+    ImportanceParallelWorld(const G4String& name, const GeometryBase* geometry);
+    /// Destructor
+    ~ImportanceParallelWorld();
+
+    /// Build the cells in the parallel world
+    virtual void Construct();
+
+    /// Fill the importance store of the current thread
+    virtual void ConstructSD();
+
+  private:
+    /// Set the importance of a cell, given as "<cell name> <importance>"
+    void SetImportance(G4String);
+
+  private:
+    std::unique_ptr<G4GenericMessenger> msg_;
+
+    const GeometryBase* geometry_;
+
+    std::vector<G4VPhysicalVolume*> cells_; ///< From the outermost to the innermost
+    std::map<G4String, G4double> importances_; ///< Set by the user, by cell name
+  };
+
+} // namespace nexus
+
+#endif
@@ -1,7 +1,8 @@
 // ----------------------------------------------------------------------------
 // nexus | NexusApp.cc
 //
-// This class is the run manager of the nexus simulation. It takes care of
+// This class is the application manager of the nexus simulation. It creates
+// the Geant4 run manager (sequential or multithreaded) and takes care of
 // setting up the simulation (geometry, physics lists, generators, actions),
 // so that it is ready to be run.
 //
@@ -13,31 +14,61 @@
 #include "BatchSession.h"
 #include "GeometryBase.h"
 #include "DetectorConstruction.h"
-#include "PrimaryGeneration.h"
+#include "ActionInitialization.h"
+#include "WorkerInitialization.h"
+#include "PersistencyManagerBase.h"
+#include "ImportanceParallelWorld.h"
 #include "FactoryBase.h"
+#include "MaterialPropertiesCache.h"
+#include "StartupProfiler.h"
 
 #include <G4GenericPhysicsList.hh>
+#include <G4GeometrySampler.hh>
+#include <G4ImportanceBiasing.hh>
+#include <G4RunManagerFactory.hh>
 #include <G4UImanager.hh>
 #include <G4StateManager.hh>
-#include <G4VPrimaryGenerator.hh>
 #include <G4VPersistencyManager.hh>
-#include <G4UserRunAction.hh>
-#include <G4UserEventAction.hh>
-#include <G4UserTrackingAction.hh>
-#include <G4UserSteppingAction.hh>
-#include <G4UserStackingAction.hh>
+#include <G4Version.hh>
+
+#include <algorithm>
 
 using namespace nexus;
 using std::make_unique;
 using std::unique_ptr;
 
 
-NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
+G4long NexusApp::job_event_offset_ = 0;
+
+
+NexusApp::NexusApp(G4String init_macro, G4int nthreads, G4int subevent_size):
+                                         master_output_(true), gen_name_(""),
                                          geo_name_(""), pm_name_(""),
                                          runact_name_(""), evtact_name_(""),
                                          stepact_name_(""), trkact_name_(""),
-                                         stkact_name_(""), pman_(false)
+                                         stkact_name_(""), biased_particle_("")
 {
+  // Create the Geant4 run manager. Unless several threads are requested,
+  // the sequential one is used.
+  if (subevent_size > 0) {
+#if G4VERSION_NUMBER >= 1120
+    runmgr_.reset(G4RunManagerFactory::CreateRunManager(G4RunManagerType::SubEvt));
+    runmgr_->SetNumberOfThreads(std::max(nthreads, 2));
+    runmgr_->RegisterSubEventType(0, subevent_size);
+#else
+    G4Exception("[NexusApp]", "NexusApp()", FatalException,
+                "The sub-event mode requires Geant4 11.2 or later.");
+#endif
+  }
+  else if (nthreads > 1) {
+    master_output_ = false;
+    runmgr_.reset(G4RunManagerFactory::CreateRunManager(G4RunManagerType::Default));
+    runmgr_->SetNumberOfThreads(nthreads);
+  }
+  else {
+    runmgr_.reset(G4RunManagerFactory::CreateRunManager(G4RunManagerType::SerialOnly));
+  }
+
   // Create and configure a generic messenger for the app
   msg_ = make_unique<G4GenericMessenger>(this, "/nexus/", "Nexus control commands.");
 
@@ -71,6 +102,11 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
   msg_->DeclareProperty("RegisterTrackingAction", trkact_name_, "");
   msg_->DeclareProperty("RegisterStackingAction", stkact_name_, "");
 
+  // Define the command to enable the geometry-importance biasing
+  // of the given particle in the cells defined by the geometry
+  msg_->DeclareProperty("importance_biasing", biased_particle_,
+                        "Particle for geometry-importance biasing (none if empty).");
+
 
   /////////////////////////////////////////////////////////
 
@@ -84,60 +120,77 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
   // processing the init macro, where the physics lists are registered
   auto pl = make_unique<G4GenericPhysicsList>();
 
-  BatchSession(init_macro.c_str()).SessionStart();
+  StartupProfiler& profiler = StartupProfiler::Instance();
 
-  // Set the physics list in the run manager
-  this->SetUserInitialization(pl.release());
+  profiler.Start("init_macro");
+  BatchSession(init_macro.c_str()).SessionStart();
+  profiler.Stop();
 
   // Set the detector construction instance in the run manager
   auto dc = make_unique<DetectorConstruction>();
   if (geo_name_.empty()) {
     G4Exception("[NexusApp]", "NexusApp()", FatalException, "A geometry must be specified.");
   }
+  profiler.Start("geometry_creation");
   dc->SetGeometry(ObjFactory<GeometryBase>::Instance().CreateObject(geo_name_));
-  this->SetUserInitialization(dc.release());
-
-  // Set the primary generation instance in the run manager
-  auto pg = make_unique<PrimaryGeneration>();
-  if (gen_name_.empty()) {
-    G4Exception("[NexusApp]", "NexusApp()", FatalException, "A generator must be specified.");
+  profiler.Stop();
+
+  // The importance biasing takes place in a parallel world made of
+  // the cells of the geometry, whose importances are set in the
+  // configuration macros. The tracks split by the biasing carry a weight.
+  if (!biased_particle_.empty()) {
+    const G4String world_name = "ImportanceWorld";
+    dc->RegisterParallelWorld(new ImportanceParallelWorld(world_name, dc->GetGeometry()));
+    sampler_ = make_unique<G4GeometrySampler>(world_name, biased_particle_);
+    sampler_->SetParallel(true);
+    pl->RegisterPhysics(new G4ImportanceBiasing(sampler_.get(), world_name));
   }
-  pg->SetGenerator(ObjFactory<G4VPrimaryGenerator>::Instance().CreateObject(gen_name_));
-  this->SetUserAction(pg.release());
-
 
-  // Set the persistency manager, if needed
-  if (!pm_name_.empty()) {
-    pm_ = ObjFactory<PersistencyManagerBase>::Instance().CreateObject(pm_name_);
-    pm_->SetMacros(init_macro, macros_, delayed_);
-    pman_ = true;
-  }
-
-  // Set the user action instances, if any, in the run manager
-  if (!runact_name_.empty()) {
-    auto runact = ObjFactory<G4UserRunAction>::Instance().CreateObject(runact_name_);
-    this->SetUserAction(runact.release());
-  }
+  // Set the physics list in the run manager
+  runmgr_->SetUserInitialization(pl.release());
 
-  if (!evtact_name_.empty()) {
-    auto evtact = ObjFactory<G4UserEventAction>::Instance().CreateObject(evtact_name_);
-    this->SetUserAction(evtact.release());
-  }
+  runmgr_->SetUserInitialization(dc.release());
 
-  if (!stkact_name_.empty()) {
-    auto stkact = ObjFactory<G4UserStackingAction>::Instance().CreateObject(stkact_name_);
-    this->SetUserAction(stkact.release());
+  if (gen_name_.empty()) {
+    G4Exception("[NexusApp]", "NexusApp()", FatalException, "A generator must be specified.");
   }
 
-  if (!trkact_name_.empty()) {
-    auto trkact = ObjFactory<G4UserTrackingAction>::Instance().CreateObject(trkact_name_);
-    this->SetUserAction(trkact.release());
+  // The sub-event mode needs a stacking action that fills the sub-event
+  // stack, and an event action that merges the hits of the sub-events
+  if (subevent_size > 0) {
+    if (stkact_name_.empty())
+      stkact_name_ = "SubEventStackingAction";
+    else if (stkact_name_ != "SubEventStackingAction") {
+      G4String msg = "The sub-event mode requires SubEventStackingAction, but "
+        + stkact_name_ + " is registered.";
+      G4Exception("[NexusApp]", "NexusApp()", FatalException, msg);
+    }
+    if (evtact_name_.empty())
+      G4Exception("[NexusApp]", "NexusApp()", FatalException,
+                  "The sub-event mode requires an event action to merge the sub-events.");
   }
 
-  if (!stepact_name_.empty()) {
-    auto stepact = ObjFactory<G4UserSteppingAction>::Instance().CreateObject(stepact_name_);
-    this->SetUserAction(stepact.release());
-  }
+  // The primary generator, the persistency manager (if needed) and the
+  // user actions (if any) are created by the action initialization,
+  // once per thread in multithreaded mode
+  auto ai = make_unique<ActionInitialization>();
+  ai->SetGeneratorName(gen_name_);
+  ai->SetPersistencyManagerName(pm_name_);
+  ai->SetRunActionName(runact_name_);
+  ai->SetEventActionName(evtact_name_);
+  ai->SetSteppingActionName(stepact_name_);
+  ai->SetTrackingActionName(trkact_name_);
+  ai->SetStackingActionName(stkact_name_);
+  ai->SetMacros(init_macro, macros_, delayed_);
+  ai->SetSubEventMode(subevent_size > 0);
+
+  if (runmgr_->GetRunManagerType() != G4RunManager::sequentialRM)
+    runmgr_->SetUserInitialization(new WorkerInitialization());
+
+  // In sequential mode, the generator and the actions are created here
+  profiler.Start("actions");
+  runmgr_->SetUserInitialization(ai.release());
+  profiler.Stop();
 
 
   /////////////////////////////////////////////////////////
@@ -152,10 +205,19 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
 
 NexusApp::~NexusApp()
 {
-  // Close output file before finishing
-  if (pman_) {
-    pm_->CloseFile();
+  // Close output file before finishing. In multithreaded mode,
+  // this is done by each worker thread when it ends.
+  if (master_output_) {
+    PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
+      (G4VPersistencyManager::GetPersistencyManager());
+    if (pm) {
+      pm->CloseFile();
+      delete pm;
+    }
   }
+
+  runmgr_.reset();
+  sampler_.reset();
 }
 
 
@@ -176,25 +238,37 @@ void NexusApp::RegisterDelayedMacro(G4String macro)
 
 
 
-void NexusApp::Initialize()
+void NexusApp::Initialize(G4bool open_output)
 {
   // Execute all command macro files before initializing the app
   // so that all objects get configured
   // G4UImanager* UI = G4UImanager::GetUIpointer();
 
+  StartupProfiler& profiler = StartupProfiler::Instance();
+
+  profiler.Start("config_macros");
   for (unsigned int i=0; i<macros_.size(); i++) {
     ExecuteMacroFile(macros_[i].data());
   }
+  profiler.Stop();
 
-  G4RunManager::Initialize();
+  // The geometry and the physics list are built here
+  // (and, in multithreaded mode, the worker threads started)
+  profiler.Start("run_manager_initialization");
+  runmgr_->Initialize();
+  profiler.Stop();
 
-  if (pman_) {
-    pm_->OpenFile();
-  }
+  MaterialPropertiesCache::PrintReport();
+
+  profiler.Start("open_output");
+  if (open_output) OpenOutput();
+  profiler.Stop();
 
+  profiler.Start("delayed_macros");
   for (unsigned int j=0; j<delayed_.size(); j++) {
     ExecuteMacroFile(delayed_[j].data());
   }
+  profiler.Stop();
 
   // Execute command to enable triggering of sensitive detectors.
   // If the optical physics is not loaded, it is not applied,
@@ -205,6 +279,29 @@ void NexusApp::Initialize()
 
 
 
+void NexusApp::OpenOutput()
+{
+  // In multithreaded mode, the output files are opened by the worker threads
+  if (!master_output_) return;
+
+  PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
+    (G4VPersistencyManager::GetPersistencyManager());
+  if (pm) pm->OpenFile();
+}
+
+
+
+void NexusApp::BeamOn(G4int nevents)
+{
+  // The physics tables are built at the start of the first run.
+  // The stage ends when the first event begins.
+  StartupProfiler::Instance().Start("run_initialization");
+  runmgr_->BeamOn(nevents);
+  StartupProfiler::Instance().Finish();
+}
+
+
+
 void NexusApp::ExecuteMacroFile(const char* filename)
 {
   G4UImanager* UI = G4UImanager::GetUIpointer();
@@ -1,7 +1,8 @@
 // ----------------------------------------------------------------------------
 // nexus | NexusApp.h
 //
-// This class is the run manager of the nexus simulation. It takes care of
+// This class is the application manager of the nexus simulation. It creates
+// the Geant4 run manager (sequential or multithreaded) and takes care of
 // setting up the simulation (geometry, physics lists, generators, actions),
 // so that it is ready to be run.
 //
@@ -11,27 +12,49 @@
 #ifndef NEXUS_APP_H
 #define NEXUS_APP_H
 
-#include "PersistencyManagerBase.h"
-
 #include <G4RunManager.hh>
 
+#include <memory>
+
 class G4GenericMessenger;
+class G4GeometrySampler;
 
 
 namespace nexus {
 
-  class NexusApp: public G4RunManager
+  class NexusApp
   {
   public:
-    /// Constructor
-    NexusApp(G4String init_macro);
+    /// Constructor. A multithreaded run manager is used
+    /// if more than one thread is requested. If a sub-event size is
+    /// given as well, the electroluminescence photons of each event
+    /// are tracked by the worker threads in batches of that size.
+    NexusApp(G4String init_macro, G4int nthreads=1, G4int subevent_size=0);
     /// Destructor
     ~NexusApp();
 
-    virtual void Initialize();
+    /// Initialize the run manager. The opening of the output file
+    /// can be deferred (see OpenOutput) when the application is going
+    /// to be forked into several jobs.
+    void Initialize(G4bool open_output=true);
+
+    /// Open the output file, if it is written by this thread
+    void OpenOutput();
+
+    /// Run the given number of events
+    void BeamOn(G4int nevents);
+
+    /// Returns the Geant4 run manager
+    G4RunManager* GetRunManager() const;
 
-    /// Returns the number of events to be processed in the current run
-    G4int GetNumberOfEventsToBeProcessed() const;
+    /// Set the number of events simulated by the jobs
+    /// that precede this one, once the application is forked
+    static void SetJobEventOffset(G4long);
+
+    /// Returns the number of events simulated by the jobs that
+    /// precede this one (0 if the application is not forked into jobs).
+    /// The generators reading their events from a file skip them.
+    static G4long GetJobEventOffset();
 
   private:
     void RegisterMacro(G4String);
@@ -45,6 +68,8 @@ namespace nexus {
     void SetRandomSeed(G4int);
 
   private:
+    std::unique_ptr<G4RunManager> runmgr_;
+    G4bool master_output_; ///< Whether the output is written by the master thread
     std::unique_ptr<G4GenericMessenger> msg_;
     G4String gen_name_; ///< Name of the chosen primary generator
     G4String geo_name_;  ///< Name of the chosen geometry
@@ -54,20 +79,26 @@ namespace nexus {
     G4String stepact_name_; ///< Name of the chosen stepping action
     G4String trkact_name_; ///< Name of the chosen tracking action
     G4String stkact_name_; ///< Name of the chosen stacking action
+    G4String biased_particle_; ///< Particle of the importance biasing, if any
 
-    G4bool pman_; ///< True if the persistency manager is set
+    std::unique_ptr<G4GeometrySampler> sampler_; ///< Sampler of the importance biasing
 
     std::vector<G4String> macros_;
     std::vector<G4String> delayed_;
 
-    std::unique_ptr<PersistencyManagerBase> pm_;
-
+    static G4long job_event_offset_;
   };
 
   // INLINE DEFINITIONS ////////////////////////////////////
 
-  inline G4int NexusApp::GetNumberOfEventsToBeProcessed() const
-  { return numberOfEventToBeProcessed; }
+  inline G4RunManager* NexusApp::GetRunManager() const
+  { return runmgr_.get(); }
+
+  inline void NexusApp::SetJobEventOffset(G4long offset)
+  { job_event_offset_ = offset; }
+
+  inline G4long NexusApp::GetJobEventOffset()
+  { return job_event_offset_; }
 
 } // namespace nexus
 
@@ -8,6 +8,10 @@
 // ----------------------------------------------------------------------------
 
 #include "PrimaryGeneration.h"
+#include "TrajectoryMap.h"
+#include "EventAbortManager.h"
+#include "StartupProfiler.h"
+#include "ThinningTrackingAction.h"
 
 #include <G4Event.hh>
 #include <G4VPrimaryGenerator.hh>
@@ -36,5 +40,12 @@ void PrimaryGeneration::GeneratePrimaries(G4Event* event)
     G4Exception("[PrimaryGeneration]", "GeneratePrimaries()",
                 FatalException, "Generator not set!");
 
+  // The start-up of the application ends with the first event
+  StartupProfiler::Instance().Finish();
+
+  TrajectoryMap::BeginEvent();
+  EventAbortManager::Instance().BeginEvent();
+  ThinningTrackingAction::Register();
+
   generator_->GeneratePrimaryVertex(event);
 }
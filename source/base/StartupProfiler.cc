@@ -0,0 +1,174 @@
+// ----------------------------------------------------------------------------
+// nexus | StartupProfiler.cc
+//
+// This class measures the wall time, CPU time and increase of the peak
+// resident memory of the stages of the start-up of the application (macro
+// processing, construction of the geometry and its components, physics
+// initialization, etc.), until the first event begins. Stages may be nested.
+// The report is printed at the start of the run and stored in the
+// configuration table of the output file.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "StartupProfiler.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include <sys/resource.h>
+
+
+namespace nexus {
+
+  StartupProfiler& StartupProfiler::Instance()
+  {
+    static StartupProfiler instance;
+    return instance;
+  }
+
+
+
+  StartupProfiler::StartupProfiler(): finished_(false)
+  {
+  }
+
+
+
+  StartupProfiler::~StartupProfiler()
+  {
+  }
+
+
+
+  G4double StartupProfiler::CPUTime()
+  {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+      1.e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+  }
+
+
+
+  G4double StartupProfiler::PeakRSS()
+  {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024. * 1024.); // in bytes
+#else
+    return usage.ru_maxrss / 1024.; // in kilobytes
+#endif
+  }
+
+
+
+  void StartupProfiler::Start(const G4String& name)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (finished_) return;
+
+    Stage stage;
+    stage.name  = open_.empty() ? name : stages_[open_.back()].name + "/" + name;
+    stage.depth = open_.size();
+    stage.wall  = stage.cpu = stage.rss = 0.;
+    stage.wall_start = std::chrono::steady_clock::now();
+    stage.cpu_start  = CPUTime();
+    stage.rss_start  = PeakRSS();
+
+    open_.push_back(stages_.size());
+    stages_.push_back(stage);
+  }
+
+
+
+  void StartupProfiler::Stop()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    StopStage();
+  }
+
+
+
+  void StartupProfiler::StopStage()
+  {
+    if (open_.empty()) return;
+
+    Stage& stage = stages_[open_.back()];
+    stage.wall = std::chrono::duration<G4double>
+      (std::chrono::steady_clock::now() - stage.wall_start).count();
+    stage.cpu = CPUTime() - stage.cpu_start;
+    stage.rss = PeakRSS() - stage.rss_start;
+
+    open_.pop_back();
+  }
+
+
+
+  void StartupProfiler::Finish()
+  {
+    if (finished_.load(std::memory_order_acquire)) return;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (finished_.load(std::memory_order_relaxed)) return;
+      while (!open_.empty()) StopStage();
+      finished_.store(true, std::memory_order_release);
+    }
+
+    Print();
+  }
+
+
+
+  std::vector<std::pair<G4String, G4String>> StartupProfiler::GetSummary() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<std::pair<G4String, G4String>> summary;
+
+    for (const Stage& stage: stages_) {
+      std::ostringstream value;
+      value << std::fixed << std::setprecision(3)
+            << "wall " << stage.wall << " s, cpu " << stage.cpu
+            << " s, peak rss +" << std::setprecision(1) << stage.rss << " MB";
+      summary.push_back({"startup:" + stage.name, value.str()});
+    }
+
+    return summary;
+  }
+
+
+
+  void StartupProfiler::Print() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (stages_.empty()) return;
+
+    std::ostringstream report;
+    report << std::fixed
+           << "[StartupProfiler] Start-up stages\n"
+           << "  " << std::left << std::setw(50) << "stage" << std::right
+           << std::setw(10) << "wall (s)" << std::setw(10) << "cpu (s)"
+           << std::setw(16) << "peak rss (MB)" << "\n";
+
+    for (const Stage& stage: stages_) {
+      G4String name = stage.name.substr(stage.name.rfind('/') + 1);
+      std::ostringstream rss;
+      rss << std::fixed << std::setprecision(1) << "+" << stage.rss;
+      report << "  " << std::left << std::setw(50)
+             << (std::string(2 * stage.depth, ' ') + name) << std::right
+             << std::setprecision(3) << std::setw(10) << stage.wall
+             << std::setw(10) << stage.cpu << std::setw(16) << rss.str() << "\n";
+    }
+
+    report << "  Peak resident memory: " << std::setprecision(1)
+           << PeakRSS() << " MB\n";
+
+    G4cout << report.str();
+  }
+
+} // end namespace nexus
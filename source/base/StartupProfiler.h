@@ -0,0 +1,94 @@
+// ----------------------------------------------------------------------------
+// nexus | StartupProfiler.h
+//
+// This class measures the wall time, CPU time and increase of the peak
+// resident memory of the stages of the start-up of the application (macro
+// processing, construction of the geometry and its components, physics
+// initialization, etc.), until the first event begins. Stages may be nested.
+// The report is printed at the start of the run and stored in the
+// configuration table of the output file.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+#include <globals.hh>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+namespace nexus {
+
+  class StartupProfiler
+  {
+  public:
+    /// Return the single instance of the class
+    static StartupProfiler& Instance();
+
+    /// Start a stage, nested in the stage being measured (if any)
+    void Start(const G4String& name);
+    /// Stop the innermost stage being measured
+    void Stop();
+
+    /// Measure a stage consisting of a call to the given function
+    template <typename F>
+    static void Measure(const G4String& name, F&& function);
+
+    /// Stop the stages being measured and print the report.
+    /// Afterwards, no more stages are measured. It is called at the
+    /// start of every event, so later calls return without locking.
+    void Finish();
+
+    /// Measurements of the stages as (key, value) pairs
+    /// of the configuration table of the output file
+    std::vector<std::pair<G4String, G4String>> GetSummary() const;
+
+    void Print() const;
+
+    /// Peak resident memory of the process, in megabytes
+    static G4double PeakRSS();
+
+  private:
+    StartupProfiler();
+    ~StartupProfiler();
+    StartupProfiler(const StartupProfiler&) = delete;
+
+    void StopStage();
+
+    /// CPU time of the process, in seconds
+    static G4double CPUTime();
+
+  private:
+    struct Stage {
+      G4String name; ///< Names of the enclosing stages and its own, joined by '/'
+      G4int depth;
+      G4double wall, cpu, rss;
+      std::chrono::steady_clock::time_point wall_start;
+      G4double cpu_start, rss_start;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<Stage> stages_;  ///< Stages in the order in which they started
+    std::vector<size_t> open_;   ///< Stages being measured, from the outermost
+    std::atomic<G4bool> finished_;
+  };
+
+  // INLINE DEFINITIONS ////////////////////////////////////
+
+  template <typename F>
+  void StartupProfiler::Measure(const G4String& name, F&& function)
+  {
+    Instance().Start(name);
+    function();
+    Instance().Stop();
+  }
+
+} // namespace nexus
+
+#endif
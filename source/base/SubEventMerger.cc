@@ -0,0 +1,118 @@
+// ----------------------------------------------------------------------------
+// nexus | SubEventMerger.cc
+//
+// This class merges the hits of a sub-event, tracked by a worker thread in
+// sub-event mode, into the event processed by the master thread. The sensor
+// hits are added up by sensor, and the ionization hits are copied. Once all
+// the sub-events are merged, the hits are sorted so that the result does not
+// depend on the order in which they were merged. It is used by the
+// MergeSubEvent and EndOfEventAction methods of every nexus event action.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SubEventMerger.h"
+
+#include "IonizationHit.h"
+#include "SensorHit.h"
+
+#include <G4Event.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4Exception.hh>
+
+#include <algorithm>
+#include <map>
+
+
+namespace nexus {
+
+  void SubEventMerger::Merge(G4Event* master_event, const G4Event* sub_event)
+  {
+    G4HCofThisEvent* master_hce = master_event->GetHCofThisEvent();
+    G4HCofThisEvent* sub_hce    = sub_event->GetHCofThisEvent();
+    if (!master_hce || !sub_hce) return;
+
+    for (size_t i=0; i<sub_hce->GetCapacity(); ++i) {
+
+      G4VHitsCollection* sub_hc = sub_hce->GetHC(i);
+      G4VHitsCollection* master_hc = master_hce->GetHC(i);
+      if (!sub_hc || !master_hc) continue;
+
+      SensorHitsCollection* sub_shc = dynamic_cast<SensorHitsCollection*>(sub_hc);
+      if (sub_shc) {
+        SensorHitsCollection* master_shc =
+          dynamic_cast<SensorHitsCollection*>(master_hc);
+        if (!master_shc) {
+          G4String msg = "Sensor hits collection " + sub_hc->GetName() +
+            " of the sub-event does not match the collection of the event.";
+          G4Exception("[SubEventMerger]", "Merge()", FatalException, msg.c_str());
+        }
+
+        std::map<G4int, SensorHit*> hits;
+        for (size_t j=0; j<master_shc->entries(); ++j)
+          hits[(*master_shc)[j]->GetSensorID()] = (*master_shc)[j];
+
+        // Counts are integer sums, so the result does
+        // not depend on the order of the sub-events
+        for (size_t j=0; j<sub_shc->entries(); ++j) {
+          const SensorHit* hit = (*sub_shc)[j];
+          auto it = hits.find(hit->GetSensorID());
+          if (it != hits.end()) it->second->Merge(*hit);
+          else master_shc->insert(new SensorHit(*hit));
+        }
+        continue;
+      }
+
+      IonizationHitsCollection* sub_ihc =
+        dynamic_cast<IonizationHitsCollection*>(sub_hc);
+      if (sub_ihc) {
+        IonizationHitsCollection* master_ihc =
+          dynamic_cast<IonizationHitsCollection*>(master_hc);
+        if (!master_ihc) {
+          G4String msg = "Ionization hits collection " + sub_hc->GetName() +
+            " of the sub-event does not match the collection of the event.";
+          G4Exception("[SubEventMerger]", "Merge()", FatalException, msg.c_str());
+        }
+
+        for (size_t j=0; j<sub_ihc->entries(); ++j)
+          master_ihc->insert(new IonizationHit(*(*sub_ihc)[j]));
+      }
+    }
+  }
+
+
+
+  void SubEventMerger::SortHits(const G4Event* event)
+  {
+    G4HCofThisEvent* hce = event->GetHCofThisEvent();
+    if (!hce) return;
+
+    for (size_t i=0; i<hce->GetCapacity(); ++i) {
+
+      G4VHitsCollection* hc = hce->GetHC(i);
+
+      // The sensor hits are sorted by sensor ID, so that their
+      // order does not depend on the order of the sub-events
+      SensorHitsCollection* shc = dynamic_cast<SensorHitsCollection*>(hc);
+      if (shc) {
+        std::vector<SensorHit*>* v = shc->GetVector();
+        std::sort(v->begin(), v->end(),
+                  [](const SensorHit* a, const SensorHit* b)
+                  { return a->GetSensorID() < b->GetSensorID(); });
+        continue;
+      }
+
+      // Each track is tracked within a single sub-event, so sorting
+      // the hits by track ID (keeping the order of the hits of each
+      // track) makes the output independent of the merging order
+      IonizationHitsCollection* ihc = dynamic_cast<IonizationHitsCollection*>(hc);
+      if (ihc) {
+        std::vector<IonizationHit*>* v = ihc->GetVector();
+        std::stable_sort(v->begin(), v->end(),
+                         [](IonizationHit* a, IonizationHit* b)
+                         { return a->GetTrackID() < b->GetTrackID(); });
+      }
+    }
+  }
+
+} // namespace nexus
@@ -0,0 +1,43 @@
+// ----------------------------------------------------------------------------
+// nexus | SubEventMerger.h
+//
+// This class merges the hits of a sub-event, tracked by a worker thread in
+// sub-event mode, into the event processed by the master thread. The sensor
+// hits are added up by sensor, and the ionization hits are copied. Once all
+// the sub-events are merged, the hits are sorted so that the result does not
+// depend on the order in which they were merged. It is used by the
+// MergeSubEvent and EndOfEventAction methods of every nexus event action.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SUBEVENT_MERGER_H
+#define SUBEVENT_MERGER_H
+
+class G4Event;
+
+
+namespace nexus {
+
+  class SubEventMerger
+  {
+  public:
+    /// Merge the sensor and ionization hits of a sub-event
+    /// into the event processed by the master thread
+    static void Merge(G4Event* master_event, const G4Event* sub_event);
+
+    /// Sort the hits of an event processed by the master thread,
+    /// once all its sub-events have been merged
+    static void SortHits(const G4Event* event);
+
+  private:
+    // Constructors, destructor and assignement op are hidden
+    // so that no instance of the class can be created.
+    SubEventMerger();
+    SubEventMerger(const SubEventMerger&);
+    ~SubEventMerger();
+  };
+
+} // namespace nexus
+
+#endif
@@ -20,12 +20,12 @@
 using namespace nexus;
 
 
-G4Allocator<Trajectory> TrjAllocator;
+G4ThreadLocal G4Allocator<Trajectory>* TrjAllocator = nullptr;
 
 
 Trajectory::Trajectory(const G4Track* track):
   G4VTrajectory(), pdef_(0), trackId_(-1), parentId_(-1),
-  initial_time_(0.), final_time_(0), length_(0.), edep_(0.),
+  initial_time_(0.), final_time_(0), length_(0.), edep_(0.), weighted_edep_(0.), weight_(1.), primary_weight_(1.),
   record_trjpoints_(true), trjpoints_(0)
 {
   pdef_     = track->GetDefinition();
@@ -41,6 +41,15 @@ Trajectory::Trajectory(const G4Track* track):
   initial_position_ = track->GetVertexPosition();
   initial_time_ = track->GetGlobalTime();
   initial_volume_ = track->GetVolume()->GetName();
+  weight_ = track->GetWeight();
+
+  // The secondaries are tracked after their parent, whose
+  // trajectory (if any) is still in the map
+  G4VTrajectory* parent = TrajectoryMap::Get(parentId_);
+  if (parentId_ != 0 && parent)
+    primary_weight_ = ((Trajectory*) parent)->GetPrimaryWeight();
+  else
+    primary_weight_ = weight_;
 
   trjpoints_ = new TrajectoryPointContainer();
   TrajectoryPoint* first_trj_point = 
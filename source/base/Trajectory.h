@@ -84,6 +84,19 @@ namespace nexus {
     G4double GetEnergyDeposit() const;
     void SetEnergyDeposit(G4double);
 
+    /// Energy deposit with each step weighted with the weight of the
+    /// track at that step relative to that of its primary particle
+    /// (equal to the energy deposit without variance reduction)
+    G4double GetWeightedEnergyDeposit() const;
+    void SetWeightedEnergyDeposit(G4double);
+
+    /// Statistical weight of the track when it was created
+    /// (different from 1 only with variance reduction techniques)
+    G4double GetWeight() const;
+
+    /// Weight of the primary particle the track descends from
+    G4double GetPrimaryWeight() const;
+
     G4String GetInitialVolume() const;
 
     G4String GetFinalVolume() const;
@@ -132,6 +145,9 @@ namespace nexus {
 
     G4double length_;
     G4double edep_;
+    G4double weighted_edep_;
+    G4double weight_;
+    G4double primary_weight_;
 
     G4String creator_process_;
     G4String final_process_;
@@ -149,19 +165,22 @@ namespace nexus {
 
 
 #if defined G4TRACKING_ALLOC_EXPORT
-extern G4DLLEXPORT G4Allocator<nexus::Trajectory> TrjAllocator;
+extern G4DLLEXPORT G4ThreadLocal G4Allocator<nexus::Trajectory>* TrjAllocator;
 #else
-extern G4DLLIMPORT G4Allocator<nexus::Trajectory> TrjAllocator;
+extern G4DLLIMPORT G4ThreadLocal G4Allocator<nexus::Trajectory>* TrjAllocator;
 #endif
 
 
 // INLINE DEFINITIONS //////////////////////////////////////////////
 
 inline void* nexus::Trajectory::operator new(size_t)
-{ return ((void*) TrjAllocator.MallocSingle()); }
+{
+  if (!TrjAllocator) TrjAllocator = new G4Allocator<nexus::Trajectory>;
+  return ((void*) TrjAllocator->MallocSingle());
+}
 
 inline void nexus::Trajectory::operator delete(void* trj)
-{ TrjAllocator.FreeSingle((nexus::Trajectory*) trj); }
+{ TrjAllocator->FreeSingle((nexus::Trajectory*) trj); }
 
 inline G4ParticleDefinition* nexus::Trajectory::GetParticleDefinition()
 { return pdef_; }
@@ -213,6 +232,14 @@ inline G4double nexus::Trajectory::GetEnergyDeposit() const { return edep_; }
 
 inline void nexus::Trajectory::SetEnergyDeposit(G4double e) { edep_ = e; }
 
+inline G4double nexus::Trajectory::GetWeightedEnergyDeposit() const { return weighted_edep_; }
+
+inline void nexus::Trajectory::SetWeightedEnergyDeposit(G4double e) { weighted_edep_ = e; }
+
+inline G4double nexus::Trajectory::GetWeight() const { return weight_; }
+
+inline G4double nexus::Trajectory::GetPrimaryWeight() const { return primary_weight_; }
+
 inline G4String nexus::Trajectory::GetCreatorProcess() const
 { return creator_process_; }
 
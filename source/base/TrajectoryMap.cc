@@ -1,7 +1,8 @@
 // ----------------------------------------------------------------------------
 // nexus | TrajectoryMap.cc
 //
-// This class is a container of particle trajectories.
+// This class is a container of the particle trajectories of the current
+// event, indexed by track ID. Each thread owns its own container.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -11,7 +12,7 @@
 #include <G4VTrajectory.hh>
 
 
-std::map<int, G4VTrajectory*> nexus::TrajectoryMap::map_;
+G4ThreadLocal nexus::TrajectoryMap::Map* nexus::TrajectoryMap::map_ = nullptr;
 
 
 namespace nexus {
@@ -24,30 +25,48 @@ namespace nexus {
 
   TrajectoryMap::~TrajectoryMap()
   {
-    map_.clear();
   }
 
 
 
-  void TrajectoryMap::Clear()
+  void TrajectoryMap::BeginEvent()
   {
-    map_.clear();
+    if (!map_) map_ = new Map;
+    map_->clear();
+  }
+
+
+
+  void TrajectoryMap::EndEvent()
+  {
+    // The trajectories are owned (and deleted) by the trajectory
+    // container of the event, so only the pointers are dropped here
+    if (map_) map_->clear();
   }
 
 
 
   G4VTrajectory* TrajectoryMap::Get(int trackId)
   {
-    std::map<int, G4VTrajectory*>::iterator it = map_.find(trackId);
-    if (it == map_.end()) return 0;
-    else return it->second;
+    if (!map_) return nullptr;
+    Map::const_iterator it = map_->find(trackId);
+    return it == map_->end() ? nullptr : it->second;
+  }
+
+
+
+  const TrajectoryMap::Map& TrajectoryMap::GetMap()
+  {
+    if (!map_) map_ = new Map;
+    return *map_;
   }
 
 
 
   void TrajectoryMap::Add(G4VTrajectory* trj)
   {
-    map_[trj->GetTrackID()] = trj;
+    if (!map_) map_ = new Map;
+    (*map_)[trj->GetTrackID()] = trj;
   }
 
 } // namespace nexus
@@ -1,7 +1,8 @@
 // ----------------------------------------------------------------------------
 // nexus | TrajectoryMap.h
 //
-// This class is a container of particle trajectories.
+// This class is a container of the particle trajectories of the current
+// event, indexed by track ID. Each thread owns its own container.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -9,7 +10,8 @@
 #ifndef TRAJECTORY_MAP_H
 #define TRAJECTORY_MAP_H
 
-#include <map>
+#include <globals.hh>
+#include <unordered_map>
 
 class G4VTrajectory;
 
@@ -19,12 +21,19 @@ namespace nexus {
   class TrajectoryMap
   {
   public:
+    using Map = std::unordered_map<int, G4VTrajectory*>;
+
     /// Return a trajectory given its track ID
     static G4VTrajectory* Get(int trackId);
     /// Add a trajectory to the map
     static void Add(G4VTrajectory*);
-    /// Clear the map
-    static void Clear();
+    /// Return the trajectories of the current event, by track ID
+    static const Map& GetMap();
+
+    /// Prepare the map for a new event
+    static void BeginEvent();
+    /// Forget the trajectories of the event that has just finished
+    static void EndEvent();
 
   private:
     // Constructors, destructor and assignement op are hidden
@@ -34,7 +43,10 @@ namespace nexus {
     ~TrajectoryMap();
 
   private:
-    static std::map<int, G4VTrajectory*> map_;
+    // Only some tracks get a trajectory (e.g., not the optical photons,
+    // which use up most of the track IDs), so the IDs are hashed rather
+    // than used as indices. The buckets are kept from one event to the next.
+    static G4ThreadLocal Map* map_;
   };
 
 } // namespace nexus
@@ -0,0 +1,61 @@
+// ----------------------------------------------------------------------------
+// nexus | WorkerInitialization.cc
+//
+// This class manages the output file of the worker threads in multithreaded
+// mode: it is opened before the first run of the thread (once the
+// configuration commands have been applied) and closed when the thread ends.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "WorkerInitialization.h"
+
+#include "PersistencyManagerBase.h"
+
+#include <G4VPersistencyManager.hh>
+
+using namespace nexus;
+
+
+namespace {
+  G4ThreadLocal G4bool output_open = false;
+}
+
+
+
+WorkerInitialization::WorkerInitialization(): G4UserWorkerInitialization()
+{
+}
+
+
+
+WorkerInitialization::~WorkerInitialization()
+{
+}
+
+
+
+void WorkerInitialization::WorkerRunStart() const
+{
+  if (output_open) return;
+
+  PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
+    (G4VPersistencyManager::GetPersistencyManager());
+  if (!pm) return;
+
+  pm->OpenFile();
+  output_open = true;
+}
+
+
+
+void WorkerInitialization::WorkerStop() const
+{
+  PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
+    (G4VPersistencyManager::GetPersistencyManager());
+  if (!pm) return;
+
+  pm->CloseFile();
+  delete pm;
+  output_open = false;
+}
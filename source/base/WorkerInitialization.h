@@ -0,0 +1,35 @@
+// ----------------------------------------------------------------------------
+// nexus | WorkerInitialization.h
+//
+// This class manages the output file of the worker threads in multithreaded
+// mode: it is opened before the first run of the thread (once the
+// configuration commands have been applied) and closed when the thread ends.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef WORKER_INITIALIZATION_H
+#define WORKER_INITIALIZATION_H
+
+#include <G4UserWorkerInitialization.hh>
+
+
+namespace nexus {
+
+  class WorkerInitialization: public G4UserWorkerInitialization
+  {
+  public:
+    /// Constructor
+    WorkerInitialization();
+    /// Destructor
+    ~WorkerInitialization();
+
+    /// Open the output file of the thread, if not done yet
+    virtual void WorkerRunStart() const;
+    /// Close the output file and delete the persistency manager of the thread
+    virtual void WorkerStop() const;
+  };
+
+} // namespace nexus
+
+#endif
@@ -0,0 +1,145 @@
+// ----------------------------------------------------------------------------
+// nexus | BenchmarkUtils.cc
+//
+// Helpers of the nexus-bench micro-benchmarks. The global operator new is
+// replaced to count the allocations of the process and, with glibc, so are
+// the C allocation functions, so that the allocations made by C libraries
+// such as HDF5 are counted too. Elsewhere, only operator new is counted,
+// which is noted in the reports.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "BenchmarkUtils.h"
+
+#include <Randomize.hh>
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+
+namespace {
+
+  std::atomic<uint64_t> alloc_count(0);
+  std::atomic<uint64_t> alloc_bytes(0);
+
+  void CountAllocation(std::size_t size)
+  {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+
+}
+
+
+#if defined(__GLIBC__)
+
+// The definitions in the executable take precedence over those of
+// the C library, also for the calls made from the shared libraries.
+// The memory is still released by the free of the C library.
+
+extern "C" {
+
+  void* __libc_malloc(std::size_t);
+  void* __libc_calloc(std::size_t, std::size_t);
+  void* __libc_realloc(void*, std::size_t);
+
+  void* malloc(std::size_t size) noexcept
+  {
+    CountAllocation(size);
+    return __libc_malloc(size);
+  }
+
+
+
+  void* calloc(std::size_t n, std::size_t size) noexcept
+  {
+    CountAllocation(n * size);
+    return __libc_calloc(n, size);
+  }
+
+
+
+  void* realloc(void* ptr, std::size_t size) noexcept
+  {
+    CountAllocation(size);
+    return __libc_realloc(ptr, size);
+  }
+
+}
+
+#endif
+
+
+
+// The array forms of the operators are
+// implemented in terms of these ones
+
+void* operator new(std::size_t size)
+{
+  // With glibc, the allocation is counted by malloc
+#if !defined(__GLIBC__)
+  CountAllocation(size);
+#endif
+
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+
+
+namespace nexus {
+
+  namespace bench {
+
+    void ResetRandom()
+    {
+      CLHEP::HepRandom::setTheSeed(20240613);
+    }
+
+
+
+    Allocations GetAllocations()
+    {
+      return {alloc_count.load(std::memory_order_relaxed),
+              alloc_bytes.load(std::memory_order_relaxed)};
+    }
+
+
+
+    void PrintThroughput(const G4String& name, G4double items, G4double time,
+                         const Allocations& allocations)
+    {
+      std::ostringstream report;
+      report << std::setprecision(4)
+             << "[nexus-bench] " << name << ": "
+             << items / time << " items/s, "
+             << allocations.count / items << " allocations ("
+             << allocations.bytes / items << " bytes) per item";
+#if !defined(__GLIBC__)
+      report << " (allocations through operator new only)";
+#endif
+      report << "\n";
+      G4cout << report.str();
+    }
+
+  } // namespace bench
+
+} // namespace nexus
@@ -0,0 +1,84 @@
+// ----------------------------------------------------------------------------
+// nexus | BenchmarkUtils.h
+//
+// Helpers of the nexus-bench micro-benchmarks. The allocations made by the
+// process (including those of C libraries such as HDF5, where glibc allows
+// counting them) are counted, so that the throughput of a benchmarked
+// operation can be reported together with the number of allocations it
+// makes. Benchmarks must include this header
+// (instead of catch.hpp) to enable the BENCHMARK macros of Catch.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef BENCHMARK_UTILS_H
+#define BENCHMARK_UTILS_H
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch.hpp>
+
+#include <globals.hh>
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace nexus {
+
+  namespace bench {
+
+    /// Reset the random engine to a fixed seed, so that the inputs
+    /// of the benchmarks are the same in every execution
+    void ResetRandom();
+
+    /// Number and total size of the allocations made by the process
+    struct Allocations {
+      uint64_t count;
+      uint64_t bytes;
+    };
+
+    Allocations GetAllocations();
+
+    /// Call repeatedly, for at least the given time (in seconds), a function
+    /// returning the number of items it has processed, and print the items
+    /// processed per second and the allocations made per item
+    template <typename F>
+    void Throughput(const G4String& name, F&& function, G4double min_time=0.5);
+
+    void PrintThroughput(const G4String& name, G4double items, G4double time,
+                         const Allocations& allocations);
+
+
+    // INLINE DEFINITIONS ////////////////////////////////////
+
+    template <typename F>
+    void Throughput(const G4String& name, F&& function, G4double min_time)
+    {
+      using Clock = std::chrono::steady_clock;
+
+      // A first call, not measured, so that lazy initializations
+      // are not counted as allocations of the operation
+      function();
+
+      const Allocations start_allocs = GetAllocations();
+      const Clock::time_point start = Clock::now();
+
+      G4double items = 0.;
+      G4double time  = 0.;
+      do {
+        items += function();
+        time = std::chrono::duration<G4double>(Clock::now() - start).count();
+      } while (time < min_time);
+
+      const Allocations end_allocs = GetAllocations();
+
+      PrintThroughput(name, items, time,
+                      {end_allocs.count - start_allocs.count,
+                       end_allocs.bytes - start_allocs.bytes});
+    }
+
+  } // namespace bench
+
+} // namespace nexus
+
+#endif
@@ -0,0 +1,53 @@
+#include "HDF5Writer.h"
+#include "BenchmarkUtils.h"
+
+#include <cstdio>
+
+
+TEST_CASE("HDF5Writer row writes", "[persistency]") {
+
+  // Each call writes a single row of the sensor response, hits or
+  // particles tables, as done by the persistency manager for every
+  // sensor bin, hit and particle of the events
+
+  const G4String filename = "nexus_bench_hdf5writer.h5";
+
+  nexus::HDF5Writer writer;
+  writer.Open(filename, false, false);
+
+  int64_t row = 0;
+
+  auto write_sensor_data = [&writer, &row]() {
+    writer.WriteSensorDataInfo(row / 1000, row % 3500, row % 1200, 1 + row % 7);
+    ++row;
+    return 1.;
+  };
+
+  auto write_hit = [&writer, &row]() {
+    writer.WriteHitInfo(false, row / 1000, row % 50, row % 1000,
+                        0.1 * (row % 900), -0.2 * (row % 900), 1.3 * (row % 900),
+                        0.5 * row, 0.01, "ACTIVE", 3, 1.);
+    ++row;
+    return 1.;
+  };
+
+  auto write_particle = [&writer, &row]() {
+    writer.WriteParticleInfo(false, row / 1000, row % 1000, "e-", 1, row % 1000 == 0,
+                             row % 1000 / 2, 1., 2., 3., 0., 4., 5., 6., 7.,
+                             "ACTIVE", "ACTIVE", 3, 3, 0.1, 0.2, 0.3, 0., 0., 0.,
+                             0.05, 1.2, "eIoni", "eIoni", 4, 4, 1.);
+    ++row;
+    return 1.;
+  };
+
+  BENCHMARK("WriteSensorDataInfo") { return write_sensor_data(); };
+  BENCHMARK("WriteHitInfo")        { return write_hit(); };
+  BENCHMARK("WriteParticleInfo")   { return write_particle(); };
+
+  nexus::bench::Throughput("HDF5Writer::WriteSensorDataInfo", write_sensor_data);
+  nexus::bench::Throughput("HDF5Writer::WriteHitInfo", write_hit);
+  nexus::bench::Throughput("HDF5Writer::WriteParticleInfo", write_particle);
+
+  writer.Close();
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,35 @@
+#include "PersistencyManager.h"
+#include "BenchmarkUtils.h"
+
+#include <vector>
+
+
+TEST_CASE("FindStringIDInMap", "[persistency]") {
+
+  // Each call looks up the ID of a volume, particle or process name,
+  // as done for every particle and hit of the events. Nearly all the
+  // names are already in the map after the first events.
+
+  std::vector<G4String> names = {"e-", "e+", "gamma", "alpha", "Xe136",
+                                 "ACTIVE", "BUFFER", "EL_GAP", "FIELD_CAGE",
+                                 "ENERGY_PLANE", "TRACKING_PLANE", "VESSEL",
+                                 "ICS", "LAB", "eIoni", "eBrem", "compt",
+                                 "phot", "conv", "msc", "none", "RadioactiveDecay"};
+  for (G4int i=0; i<100; ++i)
+    names.push_back("SIPM_BOARD_" + std::to_string(i));
+
+  std::map<G4String, G4int> str_map;
+  G4int counter = 0;
+  for (const G4String& name: names)
+    nexus::PersistencyManager::FindStringIDInMap(str_map, name, counter);
+
+  size_t i = 0;
+  auto find = [&]() {
+    nexus::PersistencyManager::FindStringIDInMap(str_map, names[i++ % names.size()], counter);
+    return 1.;
+  };
+
+  BENCHMARK("FindStringIDInMap") { return find(); };
+
+  nexus::bench::Throughput("PersistencyManager::FindStringIDInMap", find);
+}
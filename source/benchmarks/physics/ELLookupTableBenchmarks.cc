@@ -0,0 +1,47 @@
+#include "ELLookupTable.h"
+#include "BenchmarkUtils.h"
+
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+
+TEST_CASE("ELLookupTable::GetSensorsMap", "[physics]") {
+
+  // Each call finds the sensor map of a point of the EL gap,
+  // in a synthetic table covering the whole 5-mm grid of points
+  // (the table read by the class has a radius of 92.5 mm)
+
+  nexus::bench::ResetRandom();
+
+  const G4String filename = "nexus_bench_el_table.txt";
+  const G4int npoints  = 38 * 38 + 1;
+  const G4int nsensors = 64;
+
+  std::ofstream file(filename);
+  file << "* Synthetic EL table: point, sensor and probabilities of 5 time bins\n";
+  for (G4int p=0; p<npoints; ++p)
+    for (G4int s=0; s<nsensors; ++s)
+      file << p << " " << s << " 0.1 0.2 0.4 0.2 0.1\n";
+  file.close();
+
+  nexus::ELLookupTable table(filename);
+  std::remove(filename.c_str());
+
+  std::vector<G4ThreeVector> points;
+  while (points.size() < 1024) {
+    G4ThreeVector point(92.*mm * (2.*G4UniformRand() - 1.),
+                        92.*mm * (2.*G4UniformRand() - 1.), 0.);
+    if (point.perp() < 92.*mm) points.push_back(point);
+  }
+
+  size_t i = 0;
+  auto find = [&]() { return table.GetSensorsMap(points[i++ % points.size()]).size(); };
+
+  BENCHMARK("GetSensorsMap") { return find(); };
+
+  nexus::bench::Throughput("ELLookupTable::GetSensorsMap", [&find]() { find(); return 1.; });
+}
@@ -0,0 +1,82 @@
+#include "Electroluminescence.h"
+#include "IonizationElectron.h"
+#include "UniformElectricDriftField.h"
+#include "MaterialsList.h"
+#include "OpticalMaterialProperties.h"
+#include "XenonProperties.h"
+#include "BenchmarkUtils.h"
+
+#include <G4Box.hh>
+#include <G4DynamicParticle.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Navigator.hh>
+#include <G4PVPlacement.hh>
+#include <G4Region.hh>
+#include <G4Step.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4Track.hh>
+#include <G4VParticleChange.hh>
+
+
+TEST_CASE("Electroluminescence photon generation", "[physics]") {
+
+  // Each call generates the EL photons of an ionization electron
+  // crossing the EL gap of NEXT-100 (with its default pressure,
+  // EL field and gap size). The throughput is given in photons.
+
+  nexus::bench::ResetRandom();
+
+  const G4double pressure = 13.5 * bar;
+  const G4double temperature = 303. * kelvin;
+  const G4double el_field = 34.5 * kilovolt/cm;
+  const G4double el_gap = 10. * mm;
+
+  // The tables of the process are built, on construction,
+  // for the optical properties of the existing materials
+  G4Material* gxe = materials::GXe(pressure, temperature);
+  gxe->SetMaterialPropertiesTable(opticalprops::GXe(pressure, temperature));
+
+  G4LogicalVolume* el_gap_logic =
+    new G4LogicalVolume(new G4Box("BENCH_EL_GAP", 500.*mm, 500.*mm, el_gap/2.), gxe, "BENCH_EL_GAP");
+  G4VPhysicalVolume* el_gap_phys =
+    new G4PVPlacement(nullptr, G4ThreeVector(), el_gap_logic, "BENCH_EL_GAP", nullptr, false, 0, false);
+
+  nexus::UniformElectricDriftField* field =
+    new nexus::UniformElectricDriftField(-el_gap/2., el_gap/2.);
+  field->SetDriftVelocity(2.5 * mm/microsecond);
+  field->SetLightYield(XenonELLightYield(el_field, pressure));
+  G4Region* region = new G4Region("BENCH_EL_REGION");
+  region->SetUserInformation(field);
+  region->AddRootLogicalVolume(el_gap_logic);
+
+  nexus::Electroluminescence el;
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(el_gap_phys);
+  navigator.LocateGlobalPointAndSetup(G4ThreeVector());
+  G4TouchableHandle touchable = navigator.CreateTouchableHistory();
+
+  G4Track track(new G4DynamicParticle(nexus::IonizationElectron::Definition(),
+                                      G4ThreeVector(0., 0., -1.), 1.*eV),
+                0., G4ThreeVector(0., 0., el_gap/2.));
+  track.SetTouchableHandle(touchable);
+
+  G4Step step;
+  step.GetPreStepPoint()->SetPosition(G4ThreeVector(0., 0., el_gap/2.));
+  step.GetPreStepPoint()->SetGlobalTime(0.);
+  step.GetPostStepPoint()->SetPosition(G4ThreeVector(0., 0., -el_gap/2.));
+  step.GetPostStepPoint()->SetGlobalTime(el_gap / (2.5 * mm/microsecond));
+  step.GetPostStepPoint()->SetTouchableHandle(touchable);
+
+  auto generate = [&]() {
+    G4VParticleChange* change = el.PostStepDoIt(track, step);
+    const G4int nphotons = change->GetNumberOfSecondaries();
+    for (G4int i=0; i<nphotons; ++i) delete change->GetSecondary(i);
+    change->Clear();
+    return (G4double) nphotons;
+  };
+
+  BENCHMARK("PostStepDoIt") { return generate(); };
+
+  nexus::bench::Throughput("Electroluminescence::PostStepDoIt (photons)", generate);
+}
@@ -0,0 +1,39 @@
+#include "UniformElectricDriftField.h"
+#include "BenchmarkUtils.h"
+
+#include <G4LorentzVector.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <vector>
+
+
+TEST_CASE("UniformElectricDriftField::Drift", "[physics]") {
+
+  // Each call drifts an ionization electron from a point
+  // of the NEXT-100 active volume to the anode
+
+  nexus::bench::ResetRandom();
+
+  nexus::UniformElectricDriftField field(0., 1187.*mm);
+  field.SetDriftVelocity(1.*mm/microsecond);
+  field.SetTransverseDiffusion(1.1*mm/sqrt(cm));
+  field.SetLongitudinalDiffusion(0.3*mm/sqrt(cm));
+  field.SetLifetime(12.*ms);
+
+  std::vector<G4LorentzVector> origins;
+  for (G4int i=0; i<1024; ++i)
+    origins.push_back(G4LorentzVector(400.*mm * (2.*G4UniformRand() - 1.),
+                                      400.*mm * (2.*G4UniformRand() - 1.),
+                                      1187.*mm * G4UniformRand(), 0.));
+
+  size_t i = 0;
+  auto drift = [&]() {
+    G4LorentzVector xyzt = origins[i++ % origins.size()];
+    return field.Drift(xyzt);
+  };
+
+  BENCHMARK("Drift") { return drift(); };
+
+  nexus::bench::Throughput("UniformElectricDriftField::Drift", [&drift]() { drift(); return 1.; });
+}
@@ -0,0 +1,143 @@
+#include "SensorSD.h"
+#include "SensorHit.h"
+#include "BenchmarkUtils.h"
+
+#include <G4Box.hh>
+#include <G4DynamicParticle.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Navigator.hh>
+#include <G4NistManager.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4PVPlacement.hh>
+#include <G4SDManager.hh>
+#include <G4Step.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4Track.hh>
+#include <Randomize.hh>
+
+#include <cmath>
+#include <vector>
+
+
+namespace {
+
+  // Touchables of a plane of sensors, with copy numbers from 0 to nsensors-1
+  std::vector<G4TouchableHandle> MakeSensorPlane(G4int nsensors)
+  {
+    G4Material* vacuum = G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+
+    const G4double pitch = 15.55 * mm;
+    const G4int ncolumns = std::ceil(std::sqrt(nsensors));
+    const G4String name = "BENCH_SENSORS_" + std::to_string(nsensors);
+
+    G4LogicalVolume* plane_logic =
+      new G4LogicalVolume(new G4Box(name, ncolumns * pitch, ncolumns * pitch, 1.*cm), vacuum, name);
+    G4VPhysicalVolume* plane_phys =
+      new G4PVPlacement(nullptr, G4ThreeVector(), plane_logic, name, nullptr, false, 0, false);
+
+    G4LogicalVolume* sensor_logic =
+      new G4LogicalVolume(new G4Box("SENSOR", 0.65*mm, 0.65*mm, 0.5*mm), vacuum, "SENSOR");
+
+    std::vector<G4ThreeVector> positions;
+    for (G4int i=0; i<nsensors; ++i) {
+      G4ThreeVector position(pitch * (i % ncolumns - ncolumns/2.),
+                             pitch * (i / ncolumns - ncolumns/2.), 0.);
+      new G4PVPlacement(nullptr, position, sensor_logic, "SENSOR", plane_logic, false, i, false);
+      positions.push_back(position);
+    }
+
+    G4Navigator navigator;
+    navigator.SetWorldVolume(plane_phys);
+
+    std::vector<G4TouchableHandle> touchables;
+    for (const G4ThreeVector& position: positions) {
+      navigator.LocateGlobalPointAndSetup(position);
+      touchables.push_back(navigator.CreateTouchableHistory());
+    }
+
+    return touchables;
+  }
+
+}
+
+
+TEST_CASE("SensorSD::ProcessHits", "[sensdet]") {
+
+  // Each call processes the optical photons detected in an event
+  // by the PMTs of the energy plane or the SiPMs of the tracking
+  // plane of NEXT-100. The throughput is given in photons.
+
+  nexus::bench::ResetRandom();
+
+  const G4int nphotons = 20000;
+
+  for (G4int nsensors: {60, 3584}) {
+
+    std::vector<G4TouchableHandle> touchables = MakeSensorPlane(nsensors);
+
+    nexus::SensorSD* sd = new nexus::SensorSD("/BENCH/SENSORS_" + std::to_string(nsensors));
+    sd->SetDetectorVolumeDepth(0);
+    sd->SetTimeBinning(1.*microsecond);
+    G4SDManager::GetSDMpointer()->AddNewDetector(sd);
+
+    // The photons are shared by the sensors at random, with arrival
+    // times spread over the typical length of an S2 signal
+    std::vector<size_t> sensors;
+    std::vector<G4double> times;
+    for (G4int i=0; i<nphotons; ++i) {
+      sensors.push_back(G4int(G4UniformRand() * nsensors));
+      times.push_back(G4RandGauss::shoot(500.*microsecond, 20.*microsecond));
+    }
+
+    G4Track track(new G4DynamicParticle(G4OpticalPhoton::Definition(),
+                                        G4ThreeVector(0., 0., 1.), 7.2*eV),
+                  0., G4ThreeVector());
+    G4Step step;
+    step.SetTrack(&track);
+
+    auto process_event = [&]() {
+      G4HCofThisEvent* hce =
+        new G4HCofThisEvent(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+      sd->Initialize(hce);
+      for (G4int i=0; i<nphotons; ++i) {
+        step.GetPostStepPoint()->SetTouchableHandle(touchables[sensors[i]]);
+        step.GetPostStepPoint()->SetGlobalTime(times[i]);
+        sd->ProcessHits(&step, nullptr);
+      }
+      sd->EndOfEvent(hce);
+      delete hce;
+      return (G4double) nphotons;
+    };
+
+    const G4String name = "ProcessHits, " + std::to_string(nsensors) + " sensors";
+    BENCHMARK(name.c_str()) { return process_event(); };
+
+    nexus::bench::Throughput("SensorSD::ProcessHits, " + std::to_string(nsensors) +
+                             " sensors (photons)", process_event);
+  }
+}
+
+
+
+TEST_CASE("SensorHit::Fill", "[sensdet]") {
+
+  // Each call adds a photon to the time histogram of a sensor,
+  // with the binning of the SiPMs and the times of an S2 signal
+
+  nexus::bench::ResetRandom();
+
+  std::vector<G4double> times;
+  for (G4int i=0; i<4096; ++i)
+    times.push_back(G4RandGauss::shoot(500.*microsecond, 20.*microsecond));
+
+  nexus::SensorHit hit;
+  hit.SetBinSize(1.*microsecond);
+
+  size_t i = 0;
+  auto fill = [&]() { hit.Fill(times[i++ % times.size()]); return 1.; };
+
+  BENCHMARK("Fill") { return fill(); };
+
+  nexus::bench::Throughput("SensorHit::Fill", fill);
+}
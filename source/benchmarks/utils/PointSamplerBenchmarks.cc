@@ -0,0 +1,39 @@
+#include "BoxPointSampler.h"
+#include "CylinderPointSampler.h"
+#include "SpherePointSampler.h"
+#include "RandomUtils.h"
+#include "BenchmarkUtils.h"
+
+#include <G4SystemOfUnits.hh>
+
+
+TEST_CASE("Point samplers", "[utils]") {
+
+  // Samplers of the size of the NEXT-100 active volume and vessel
+
+  nexus::bench::ResetRandom();
+
+  nexus::CylinderPointSampler cylinder(0., 492.*mm, 600.*mm);
+  nexus::CylinderPointSampler shell(492.*mm, 502.*mm, 600.*mm);
+  nexus::BoxPointSampler box(500.*mm, 500.*mm, 600.*mm, 10.*mm);
+  nexus::SpherePointSampler sphere(0., 600.*mm);
+
+  // Each call generates one vertex
+  auto cylinder_volume = [&cylinder]() { cylinder.GenerateVertex(nexus::VOLUME); return 1.; };
+  auto shell_surface = [&shell]() { shell.GenerateVertex(nexus::INNER_SURF); return 1.; };
+  auto box_volume = [&box]() { box.GenerateVertex(nexus::VOLUME); return 1.; };
+  auto box_surface = [&box]() { box.GenerateVertex(nexus::OUTER_SURF); return 1.; };
+  auto sphere_volume = [&sphere]() { sphere.GenerateVertex(nexus::VOLUME); return 1.; };
+
+  BENCHMARK("CylinderPointSampler VOLUME")     { return cylinder_volume(); };
+  BENCHMARK("CylinderPointSampler INNER_SURF") { return shell_surface(); };
+  BENCHMARK("BoxPointSampler VOLUME")          { return box_volume(); };
+  BENCHMARK("BoxPointSampler OUTER_SURF")      { return box_surface(); };
+  BENCHMARK("SpherePointSampler VOLUME")       { return sphere_volume(); };
+
+  nexus::bench::Throughput("CylinderPointSampler VOLUME", cylinder_volume);
+  nexus::bench::Throughput("CylinderPointSampler INNER_SURF", shell_surface);
+  nexus::bench::Throughput("BoxPointSampler VOLUME", box_volume);
+  nexus::bench::Throughput("BoxPointSampler OUTER_SURF", box_surface);
+  nexus::bench::Throughput("SpherePointSampler VOLUME", sphere_volume);
+}
@@ -6,7 +6,8 @@
 // FORTRAN package, with nexus.
 // It provides the primary vertex of a Xe-136 double beta decay.
 // The possibility of reading a previously generated ascii file with the
-// electron momenta is also allowed.
+// electron momenta is also allowed, as well as reading a binary primary
+// event library converted from it, which allows direct access to any event.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -16,6 +17,7 @@
 #include "DetectorConstruction.h"
 #include "GeometryBase.h"
 #include "FactoryBase.h"
+#include "NexusApp.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4RunManager.hh>
@@ -23,23 +25,45 @@
 #include <G4ParticleDefinition.hh>
 #include "decay0.h"
 #include <iostream>
+
+#include <unistd.h>
+
 using namespace nexus;
 
 REGISTER_CLASS(Decay0Interface, G4VPrimaryGenerator)
 
 
+std::ifstream Decay0Interface::file_;
+G4String Decay0Interface::file_name_;
+std::mutex Decay0Interface::file_mutex_;
+pid_t Decay0Interface::file_pid_ = 0;
+
+
+
 Decay0Interface::Decay0Interface():
   G4VPrimaryGenerator(), msg_(0), decay_file_("th-e1-spectrum.dat"),
-  opened_(false), geom_(0)
+  opened_(false), first_event_(0), sampling_tables_(true), geom_(0), region_handle_(nullptr)
 {
 
   msg_ = new G4GenericMessenger(this, "/Generator/Decay0Interface/",
     "Control commands of the Decay0 interface.");
 
   msg_->DeclareMethod("inputFile", &Decay0Interface::OpenInputFile, "");
-  msg_->DeclareProperty("region", region_, "");
+  msg_->DeclareMethod("libraryFile", &Decay0Interface::OpenLibraryFile,
+                      "Primary event library converted from a Decay0 file.");
+  G4GenericMessenger::Command& first_event_cmd =
+    msg_->DeclareProperty("first_event", first_event_,
+                          "First library event to be read.");
+  first_event_cmd.SetParameterName("first_event", false);
+  first_event_cmd.SetRange("first_event>=0");
+  msg_->DeclareMethod("region", &Decay0Interface::SetRegion, "");
   msg_->DeclareProperty("decay_file", decay_file_,
                         "Name of the file with the decay info");
+  msg_->DeclareProperty("sampling_tables", sampling_tables_,
+                        "Sample the energies from precomputed tables "
+                        "instead of using the rejection method.");
+  msg_->DeclareProperty("tables_cache_dir", tables_cache_dir_,
+                        "Directory where the sampling tables are cached.");
 
   msg_->DeclareMethod("EnergyThreshold", &Decay0Interface::SetEnergyThreshold, ""); // for electrons only.
   msg_->DeclareMethod("Xe136DecayMode", &Decay0Interface::SetXe136DecayMode, "");
@@ -58,7 +82,6 @@ Decay0Interface::Decay0Interface():
 
 Decay0Interface::~Decay0Interface()
 {
-  if (file_.is_open()) file_.close();
   if (fOutDebug_.is_open()) fOutDebug_.close();
   if (decay0_ != 0) delete decay0_;
 }
@@ -73,11 +96,24 @@ void Decay0Interface::OpenInputFile(G4String filename)
      return;
    }
 
+  // The command is executed by the generator of every thread,
+  // but the file is opened only once
+  std::lock_guard<std::mutex> lock(file_mutex_);
+
+  if (file_.is_open() && file_name_ == filename) {
+    opened_ = true;
+    return;
+  }
+
+  if (file_.is_open()) file_.close();
+  file_.clear();
   file_.open(filename.data());
+  file_name_ = filename;
+  file_pid_ = getpid();
 
   if (file_.good()) {
     opened_ = true;
-    ProcessHeader();
+    ProcessHeader(file_);
   }
   else {
     G4Exception("[Decay0Interface]", "SetInputFile()", JustWarning,
@@ -87,16 +123,64 @@ void Decay0Interface::OpenInputFile(G4String filename)
 
 
 
+void Decay0Interface::ReopenInputFile()
+{
+  // A forked job shares the file position with its parent and the other
+  // jobs, so it opens the file on its own before reading any event
+  file_.close();
+  file_.clear();
+  file_.open(file_name_.data());
+  file_pid_ = getpid();
+
+  if (!file_.good()) {
+    G4Exception("[Decay0Interface]", "ReopenInputFile()", FatalException,
+                "Cannot open Decay0 input file.");
+    return;
+  }
+
+  ProcessHeader(file_);
+
+  G4long evt_no;
+  std::vector<LibraryParticle> particles;
+  for (G4long i=0; i<NexusApp::GetJobEventOffset(); ++i)
+    if (!ReadEvent(file_, evt_no, particles)) break;
+}
+
+
+
+void Decay0Interface::OpenLibraryFile(G4String filename)
+{
+  library_.Open(filename);
+}
+
+
+
+void Decay0Interface::SetRegion(G4String region)
+{
+  region_ = region;
+  region_handle_ = geom_->GetRegion(region_);
+}
+
+
+
 /// Read an event from file and create primary particles and
 /// vertices accordingly
 void Decay0Interface::GeneratePrimaryVertex(G4Event* event)
 {
+  if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+
+  if (library_.IsOpen()) {
+    GenerateFromLibrary(event);
+    return;
+  }
+
   const bool runG4 = true;
 //  const bool runG4 = false;
   if (!opened_) {
      if (decay0_ == 0) {
        const std::string XeName("Xe136");
-       decay0_ = new decay0(XeName, Ba136FinalState_, Xe136DecayMode_, decay_file_);
+       decay0_ = new decay0(XeName, Ba136FinalState_, Xe136DecayMode_, decay_file_,
+                            0.0, 4.3, sampling_tables_, tables_cache_dir_);
       // Temporary debugging file, just generate particle and dump them on a file
 //      std::ostringstream fOutStrStr; fOutStrStr << "./Decay0Out_" << Ba136FinalState_ << "_" << Xe136DecayMode_ << "_V1.txt";
 //      std::string fOutStr(fOutStrStr.str());
@@ -125,7 +209,7 @@ void Decay0Interface::GeneratePrimaryVertex(G4Event* event)
         }
      }
      if (runG4 && keepEvt) {
-        particle_position = geom_->GenerateVertex(region_);
+        particle_position = (*region_handle_)();
         for (std::vector<decay0Part>::const_iterator itp = theParts.begin(); itp != theParts.end(); itp++) {
           G4ParticleDefinition* g4code =
              G4ParticleTable::GetParticleTable()->FindParticle(itp->pdgCode_);
@@ -141,53 +225,43 @@ void Decay0Interface::GeneratePrimaryVertex(G4Event* event)
      return;
    }
 
-  //G4cout << "GeneratePrimaryVertex()" << G4endl;
-
-  // reading event-related information
-  G4int entries;     // number of particles in the event
-  G4long evt_no;     // event number
-  G4double evt_time; // initial time in seconds
-
-  file_ >> evt_no >> evt_time >> entries;
-
+  // Each event of the file is read by the generator of one thread only
+  G4long evt_no;
+  std::vector<LibraryParticle> particles;
+  G4bool read;
+  {
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    if (file_pid_ != getpid()) ReopenInputFile();
+    read = ReadEvent(file_, evt_no, particles);
+  }
 
   // abort if end-of-file was reached in last operation
-  if (file_.eof()) {
+  if (!read) {
     G4cout  << "[Decay0Interface] End-of-File reached. "
             << "Aborting the run..." << G4endl;
     G4RunManager::GetRunManager()->AbortRun();
     return;
   }
 
-  //G4cout << "entries: " << entries << G4endl;
-
   // generate a position in the detector
   // (all primary particles will be generated there)
-  particle_position = geom_->GenerateVertex(region_);
+  particle_position = (*region_handle_)();
 
-
-  // reading info for each particle in the event
-  for (G4int i=0; i<entries; i++) {
-    //G4cout << i << G4endl;
-
-    G4int g3code;           // GEANT3 particle code
-    G4double px, py, pz;    // Momentum components in MeV
-
-    file_ >> g3code >> px >> py >> pz >> particle_time;
+  for (const LibraryParticle& p: particles) {
 
     G4ParticleDefinition* g4code =
-      G4ParticleTable::GetParticleTable()->FindParticle(G3toPDG(g3code));
+      G4ParticleTable::GetParticleTable()->FindParticle(p.pdg);
 
     // create a primary particle
     G4PrimaryParticle* particle =
-      new G4PrimaryParticle(g4code, px*MeV, py*MeV, pz*MeV);
+      new G4PrimaryParticle(g4code, p.px*MeV, p.py*MeV, p.pz*MeV);
 
     particle->SetMass(g4code->GetPDGMass());
     particle->SetCharge(g4code->GetPDGCharge());
 
     // create a primary vertex for the particle
     G4PrimaryVertex* vertex =
-      new G4PrimaryVertex(particle_position, particle_time*second);
+      new G4PrimaryVertex(particle_position, p.t*ns);
 
     vertex->SetPrimary(particle);
 
@@ -198,14 +272,121 @@ void Decay0Interface::GeneratePrimaryVertex(G4Event* event)
 
 
 
-void Decay0Interface::ProcessHeader()
+void Decay0Interface::GenerateFromLibrary(G4Event* event)
+{
+  // Each event of the run reads its own library event, counted
+  // from first_event, so that runs can start anywhere in the library.
+  // The events replayed by the preceding forked jobs are skipped
+  uint64_t k = PrimaryEventLibrary::GetReplayIndex(first_event_, event->GetEventID());
+
+  if (k >= library_.GetNumberOfEvents()) {
+    G4cout  << "[Decay0Interface] End of library reached. "
+            << "Aborting the run..." << G4endl;
+    G4RunManager::GetRunManager()->AbortRun();
+    return;
+  }
+
+  const LibraryEvent& evt = library_.GetEvent(k);
+  const LibraryParticle* particles = library_.GetParticles(k);
+
+  // generate a position in the detector
+  // (all primary particles will be generated there)
+  particle_position = (*region_handle_)();
+
+  for (uint32_t i=0; i<evt.nparticles; ++i) {
+    const LibraryParticle& p = particles[i];
+
+    G4ParticleDefinition* g4code =
+      G4ParticleTable::GetParticleTable()->FindParticle(p.pdg);
+
+    G4PrimaryParticle* particle =
+      new G4PrimaryParticle(g4code, p.px*MeV, p.py*MeV, p.pz*MeV);
+    particle->SetMass(g4code->GetPDGMass());
+    particle->SetCharge(g4code->GetPDGCharge());
+    particle->SetWeight(evt.weight);
+
+    G4PrimaryVertex* vertex =
+      new G4PrimaryVertex(particle_position, (evt.time + p.t)*ns);
+    vertex->SetPrimary(particle);
+    event->AddPrimaryVertex(vertex);
+  }
+}
+
+
+
+G4long Decay0Interface::ConvertToLibrary(const G4String& decay0_file,
+                                         const G4String& library_file)
+{
+  std::ifstream file(decay0_file.data());
+  if (!file.good()) {
+    G4Exception("[Decay0Interface]", "ConvertToLibrary()", FatalException,
+                "Cannot open Decay0 input file.");
+    return 0;
+  }
+
+  ProcessHeader(file);
+
+  PrimaryEventLibraryWriter writer;
+  writer.Open(library_file);
+
+  G4long evt_no;
+  std::vector<LibraryParticle> particles;
+
+  while (ReadEvent(file, evt_no, particles)) {
+    LibraryEvent evt = {};
+    evt.event_id = evt_no;
+    evt.time     = 0.;
+    evt.weight   = 1.;
+    writer.AddEvent(evt, particles);
+  }
+
+  writer.Close();
+
+  return writer.GetNumberOfEvents();
+}
+
+
+
+G4bool Decay0Interface::ReadEvent(std::ifstream& file, G4long& evt_no,
+                                  std::vector<LibraryParticle>& particles)
+{
+  G4int entries;     // number of particles in the event
+  G4double evt_time; // initial time in seconds
+
+  file >> evt_no >> evt_time >> entries;
+  if (file.eof() || file.fail()) return false;
+
+  particles.clear();
+
+  for (G4int i=0; i<entries; i++) {
+    G4int g3code;           // GEANT3 particle code
+    G4double px, py, pz;    // Momentum components in MeV
+    G4double time;          // Time in seconds
+
+    file >> g3code >> px >> py >> pz >> time;
+
+    LibraryParticle p = {};
+    p.pdg = G3toPDG(g3code);
+    p.px = px;
+    p.py = py;
+    p.pz = pz;
+    p.t  = time * second / ns;
+    particles.push_back(p);
+  }
+
+  return true;
+}
+
+
+
+void Decay0Interface::ProcessHeader(std::ifstream& file)
 {
   G4String line;
 
-  while (!G4StrUtil::contains(line, "First event")) getline(file_, line);
+  while (!G4StrUtil::contains(line, "First event")) getline(file, line);
 
-  getline(file_, line);
-  getline(file_, line);
+  getline(file, line);
+  getline(file, line);
 }
 
 
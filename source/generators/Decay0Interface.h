@@ -5,7 +5,8 @@
 // interfacing the DECAY0 c++ code, translated from the original
 // FORTRAN package, with nexus.
 // The possibility of reading a previously generated ascii file with the
-// electron momenta is also allowed.
+// electron momenta is also allowed, as well as reading a binary primary
+// event library converted from it, which allows direct access to any event.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -13,8 +14,15 @@
 #ifndef DECAY0_INTERFACE_H
 #define DECAY0_INTERFACE_H
 
+#include "PrimaryEventLibrary.h"
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 #include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <sys/types.h>
 
 class G4GenericMessenger;
 class G4Event;
@@ -23,8 +31,6 @@ class decay0;
 
 namespace nexus {
 
-  class GeometryBase;
-
 
   /// This primary generator sets the G4Event objects according to the
   /// information read from an ascii file produced by the Decay0
@@ -42,25 +48,57 @@ namespace nexus {
     /// and primary vertices accordingly
     void GeneratePrimaryVertex(G4Event*);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
+    /// Convert an ascii file produced by Decay0 into a primary event
+    /// library. Returns the number of events converted.
+    static G4long ConvertToLibrary(const G4String& decay0_file,
+                                   const G4String& library_file);
+
+    /// Return the PDG code equivalent to a given GEANT3 particle code
+    static G4int G3toPDG(const G4int);
+
   private:
     /// Open the Decay0 input file selected by the user
     void OpenInputFile(G4String);
+    /// Open again the Decay0 input file in a forked job and
+    /// skip the events read by the jobs that precede it
+    static void ReopenInputFile();
+    /// Open the primary event library selected by the user
+    void OpenLibraryFile(G4String);
     /// Parse information in the file header
-    void ProcessHeader();
+    static void ProcessHeader(std::ifstream&);
+    /// Read the number and particles of the next event of a
+    /// Decay0 file. Returns false at the end of the file.
+    static G4bool ReadEvent(std::ifstream&, G4long& evt_no,
+                            std::vector<LibraryParticle>&);
 
-    /// Return the PDG code equivalent to a given GEANT3 particle code
-    G4int G3toPDG(const G4int);
+    /// Generate the primary particles of the next event of the library
+    void GenerateFromLibrary(G4Event*);
 
   private:
     G4GenericMessenger* msg_;
 
     G4String decay_file_;
 
-    std::ifstream file_; ///< ASCII file produced by Decay0
+    /// ASCII file produced by Decay0. It is shared by the generators
+    /// of all threads, so that each event of the file is read once.
+    static std::ifstream file_;
+    static G4String file_name_;
+    static std::mutex file_mutex_;
+    static pid_t file_pid_; ///< Process that opened the file
+
     G4String region_; ///< region of generation of vertices in geometry
 
     G4bool opened_;
 
+    PrimaryEventLibrary library_; ///< Binary library of primary events
+    G4long first_event_; ///< First library event to be read
+
+    G4bool sampling_tables_; ///< Sample the Decay0 energies from tables
+    G4String tables_cache_dir_; ///< Directory of the cached sampling tables
+
     int myEventCounter_;
 
     decay0 *decay0_;
@@ -73,6 +111,7 @@ namespace nexus {
 
     std::ofstream fOutDebug_; // for debugging...
     const GeometryBase* geom_;
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
 
 
     inline void SetEnergyThreshold(double e) { energyThreshold_ = e;}
@@ -37,6 +37,7 @@ ECECGenerator::ECECGenerator():
   region_("ACTIVE"),
   msg_  (nullptr),
   geom_ (nullptr),
+  region_handle_(nullptr),
   shell_(nullptr),
   atom_ (nullptr)
 {
@@ -50,8 +51,8 @@ ECECGenerator::ECECGenerator():
 
   msg_->DeclareProperty("shell", shell_name_, "Shell from which the electron is captured.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where vertices will be generated.");
+  msg_->DeclareMethod("region", &ECECGenerator::SetRegion,
+                      "Region of the geometry where vertices will be generated.");
 
 }
 
@@ -125,13 +126,21 @@ G4PrimaryParticle* ECECGenerator::GetPrimaryParticle(G4DynamicParticle* dparticl
 }
 
 
+void ECECGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  region_handle_ = geom_->GetRegion(region_);
+}
+
+
 void ECECGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   if (!atom_) // First time only
     Initialize();
 
   // Generate an initial position for the ion using the geometry
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+  G4ThreeVector position = (*region_handle_)();
 
   // Ion generated at the start-of-event time
   G4double time = 0.;
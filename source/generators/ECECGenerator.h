@@ -12,6 +12,8 @@
 #ifndef ECEC_GENERATOR_H
 #define ECEC_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 #include <G4AtomicShellEnumerator.hh>
 
@@ -26,7 +28,6 @@ class G4UAtomicDeexcitation;
 
 namespace nexus{
 
-  class GeometryBase;
 
   class ECECGenerator: public G4VPrimaryGenerator
   {
@@ -40,6 +41,9 @@ namespace nexus{
     // setting a primary vertex that contains the chosen ion
     void GeneratePrimaryVertex(G4Event*);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
  private:
    void                    Initialize();
    G4AtomicShellEnumerator GetShellID(G4String);
@@ -52,6 +56,7 @@ namespace nexus{
     G4GenericMessenger* msg_;
 
     const GeometryBase* geom_;
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
     const G4AtomicShell* shell_;
     G4UAtomicDeexcitation* atom_;
   };
@@ -34,7 +34,7 @@ REGISTER_CLASS(ElecPositronPairGenerator, G4VPrimaryGenerator)
 ElecPositronPairGenerator::ElecPositronPairGenerator():
 G4VPrimaryGenerator(), msg_(0), particle_definition_(0),
 energy_min_(0.), energy_max_(0.),
-geom_(0)
+geom_(0), region_handle_(nullptr)
 {
   msg_ = new G4GenericMessenger(this, "/Generator/ElecPositronPair/",
     "Control commands of single-particle generator.");
@@ -51,8 +51,8 @@ geom_(0)
   max_energy.SetParameterName("max_energy", false);
   max_energy.SetRange("max_energy>0.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where the vertex will be generated.");
+  msg_->DeclareMethod("region", &ElecPositronPairGenerator::SetRegion,
+                      "Region of the geometry where the vertex will be generated.");
 
   DetectorConstruction* detconst = (DetectorConstruction*) G4RunManager::GetRunManager()->GetUserDetectorConstruction();
   geom_ = detconst->GetGeometry();
@@ -66,6 +66,13 @@ ElecPositronPairGenerator::~ElecPositronPairGenerator()
 }
 
 
+void ElecPositronPairGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  region_handle_ = geom_->GetRegion(region_);
+}
+
+
 void ElecPositronPairGenerator::GeneratePrimaryVertex(G4Event* event)
 {
 
@@ -73,7 +80,8 @@ void ElecPositronPairGenerator::GeneratePrimaryVertex(G4Event* event)
     G4ParticleTable::GetParticleTable()->FindParticle("e-");
 
   // Generate an initial position for the particle using the geometry
-  G4ThreeVector pos = geom_->GenerateVertex(region_);
+  if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+  G4ThreeVector pos = (*region_handle_)();
 
   // Particle generated at start-of-event
   G4double time = 0.;
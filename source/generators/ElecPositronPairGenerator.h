@@ -10,6 +10,8 @@
 #ifndef ELEC_POSITRON_PAIR_GEN_H
 #define ELEC_POSITRON_PAIR_GEN_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4GenericMessenger;
@@ -19,8 +21,6 @@ class G4ParticleDefinition;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class ElecPositronPairGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -34,6 +34,9 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
   private:
     G4GenericMessenger* msg_;
 
@@ -43,6 +46,7 @@ namespace nexus {
     G4double energy_max_; ///< Maximum total kinetic energy
 
     const GeometryBase* geom_; ///< Pointer to the detector geometry
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
 
     G4String region_;
 
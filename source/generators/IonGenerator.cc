@@ -29,7 +29,7 @@ IonGenerator::IonGenerator():
   atomic_number_(0), mass_number_(0), energy_level_(0.),
   decay_at_time_zero_(true),
   region_(""),
-  msg_(nullptr), geom_(nullptr)
+  msg_(nullptr), geom_(nullptr), region_handle_(nullptr)
 {
   msg_ = new G4GenericMessenger(this, "/Generator/IonGenerator/",
                                 "Control commands of the ion gun "
@@ -55,8 +55,8 @@ IonGenerator::IonGenerator():
   msg_->DeclareProperty("decay_at_time_zero", decay_at_time_zero_,
                         "Set to true to make unstable ions decay at t=0.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where vertices will be generated.");
+  msg_->DeclareMethod("region", &IonGenerator::SetRegion,
+                      "Region of the geometry where vertices will be generated.");
 
   // Load the detector geometry, which will be used for the generation of vertices
   const DetectorConstruction* detconst = dynamic_cast<const DetectorConstruction*>
@@ -94,6 +94,13 @@ G4ParticleDefinition* IonGenerator::IonDefinition()
 }
 
 
+void IonGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  region_handle_ = geom_->GetRegion(region_);
+}
+
+
 void IonGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   // Pointer declared as static so that it gets allocated only once
@@ -103,7 +110,8 @@ void IonGenerator::GeneratePrimaryVertex(G4Event* event)
   G4PrimaryParticle* ion = new G4PrimaryParticle(pdef);
 
   // Generate an initial position for the ion using the geometry
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+  G4ThreeVector position = (*region_handle_)();
   // Ion generated at the start-of-event time
   G4double time = 0.;
   // Create a new vertex
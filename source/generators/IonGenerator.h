@@ -11,6 +11,8 @@
 #ifndef ION_GENERATOR_H
 #define ION_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4Event;
@@ -20,7 +22,6 @@ class G4ParticleDefinition;
 
 namespace nexus{
 
-  class GeometryBase;
 
   class IonGenerator: public G4VPrimaryGenerator
   {
@@ -34,6 +35,9 @@ namespace nexus{
     // setting a primary vertex that contains the chosen ion
     void GeneratePrimaryVertex(G4Event*);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
   private:
     G4ParticleDefinition* IonDefinition();
 
@@ -44,6 +48,7 @@ namespace nexus{
     G4String region_;
     G4GenericMessenger* msg_;
     const GeometryBase* geom_;
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
   };
 
 } // end namespace nexus
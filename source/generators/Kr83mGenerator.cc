@@ -36,7 +36,7 @@ namespace nexus {
 
   using namespace CLHEP;
 
-  Kr83mGenerator::Kr83mGenerator() : geom_(0), energy_32_(32.1473*keV),
+  Kr83mGenerator::Kr83mGenerator() : geom_(0), region_handle_(nullptr), energy_32_(32.1473*keV),
                                      energy_9_(9.396*keV),
                                      probGamma_9_(0.0490), lifetime_9_(154.*ns)
   {
@@ -88,8 +88,8 @@ namespace nexus {
      msg_ = new G4GenericMessenger(this, "/Generator/Kr83mGenerator/",
     "Control commands of Kr83 generator.");
 
-     msg_->DeclareProperty("region", region_,
-			   "Set the region of the geometry "
+     msg_->DeclareMethod("region", &Kr83mGenerator::SetRegion,
+			 "Set the region of the geometry "
                            "where the vertex will be generated.");
 
      // Set particle type searching in particle table by name
@@ -114,13 +114,20 @@ namespace nexus {
   {
   }
 
+  void Kr83mGenerator::SetRegion(G4String region)
+  {
+    region_ = region;
+    region_handle_ = geom_->GetRegion(region_);
+  }
+
   void Kr83mGenerator::GeneratePrimaryVertex(G4Event* evt)
   {
     // Add an Ascci ntuple to debug..
    // const int evtNum = evt->GetEventID();
 
     // Ask the geometry to generate a position for the particle
-    G4ThreeVector position = geom_->GenerateVertex(region_);
+    if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+    G4ThreeVector position = (*region_handle_)();
    //
    // First transition (32 kEv) Always one electron. Set it's kinetic energy.
    // Decide if we emit an X-ray..
@@ -11,6 +11,8 @@
 #define Kr83m_GENERATOR_H
 
 #include <vector>
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4Event;
@@ -19,8 +21,6 @@ class G4GenericMessenger;
 
 namespace nexus {
 
-  class GeometryBase;
-
   /// This state decays into the fundamental state of Kr 83 in two steps,
   ///  (JP 1/2- --> Jp 7/2+ -> 9/2+), with transition energies of 32.15 and 9.4 keV
   ///  The life time of 83mKr is long, ~ 1.83 hours, so, infinite for us,
@@ -57,10 +57,14 @@ namespace nexus {
 
     void GeneratePrimaryVertex(G4Event* evt);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
   private:
 
     G4GenericMessenger* msg_;
     const GeometryBase* geom_;
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
 
     G4double energy_32_; // Transition energy from the 1/2- state to the intermediate state, 7/2+
     G4double energy_9_; // ... from the JP 7/2+ to the Kr83 fundamental state.
@@ -36,7 +36,7 @@ REGISTER_CLASS(LambertianGenerator, G4VPrimaryGenerator)
 
 LambertianGenerator::LambertianGenerator():
 G4VPrimaryGenerator(), msg_(0), particle_definition_(0),
-energy_min_(0.), energy_max_(0.), geom_(0), momentum_{},
+energy_min_(0.), energy_max_(0.), geom_(0), region_handle_(nullptr), momentum_{},
 costheta_min_(0), costheta_max_(1.)
 {
   msg_ = new G4GenericMessenger(this, "/Generator/LambertianGenerator/",
@@ -57,8 +57,8 @@ costheta_min_(0), costheta_max_(1.)
   max_energy.SetParameterName("max_energy", false);
   max_energy.SetRange("max_energy>0.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where the vertex will be generated.");
+  msg_->DeclareMethod("region", &LambertianGenerator::SetRegion,
+                      "Region of the geometry where the vertex will be generated.");
 
   msg_->DeclarePropertyWithUnit("momentum", "mm",  momentum_, "Set particle 3-momentum.");
 
@@ -92,6 +92,14 @@ void LambertianGenerator::SetParticleDefinition(G4String particle_name)
 
 
 
+void LambertianGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  region_handle_ = geom_->GetRegion(region_);
+}
+
+
+
 void LambertianGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   // Generate uniform random energy in [E_min, E_max]
@@ -125,7 +133,8 @@ void LambertianGenerator::GeneratePrimaryVertex(G4Event* event)
   }
 
   // Generate an initial position for the particle using the geometry
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+  G4ThreeVector position = (*region_handle_)();
 
   // Particle generated at start-of-event
   G4double time = 0.;
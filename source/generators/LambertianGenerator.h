@@ -12,6 +12,8 @@
 #ifndef LAMBERTIAN_GENERATOR_H
 #define LAMBERTIAN_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4GenericMessenger;
@@ -21,8 +23,6 @@ class G4ParticleDefinition;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class LambertianGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -36,6 +36,9 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
   private:
 
     void SetParticleDefinition(G4String);
@@ -49,6 +52,7 @@ namespace nexus {
     G4double energy_max_; ///< Maximum kinetic energy
 
     const GeometryBase* geom_; ///< Pointer to the detector geometry
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
 
     G4String region_;
 
@@ -8,6 +8,7 @@
 
 #include "MuonGenerator.h"
 #include "DetectorConstruction.h"
+#include "PersistencyManager.h"
 #include "GeometryBase.h"
 #include "AddUserInfoToPV.h"
 #include "FactoryBase.h"
@@ -34,7 +35,8 @@ MuonGenerator::MuonGenerator():
   G4VPrimaryGenerator(), msg_(0), particle_definition_(0),
   use_lsc_dist_(true), axis_rotation_(150), rPhi_(NULL), user_dir_{},
   energy_min_(0.), energy_max_(0.), dist_name_("za"), bInitialize_(false),
-  geom_(0), geom_solid_(0), gen_rad_(223.33*cm)
+  geom_(0), region_handle_(nullptr), geom_solid_(0), gen_rad_(223.33*cm),
+  target_centre_{}, target_rad_(0.), ntrials_(0)
 {
   msg_ = new G4GenericMessenger(this, "/Generator/MuonGenerator/",
 				"Control commands of muongenerator.");
@@ -51,8 +53,8 @@ MuonGenerator::MuonGenerator():
   max_energy.SetParameterName("max_energy", false);
   max_energy.SetRange("max_energy>0.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where the vertex will be generated.");
+  msg_->DeclareMethod("region", &MuonGenerator::SetRegion,
+                      "Region of the geometry where the vertex will be generated.");
 
   msg_->DeclareProperty("use_lsc_dist", use_lsc_dist_,
 			"Distribute muon directions according to file?");
@@ -78,6 +80,20 @@ MuonGenerator::MuonGenerator():
   generation_radius.SetParameterName("gen_rad", false);
   generation_radius.SetRange("gen_rad>0.");
 
+  // Biased mode: the muons are only generated along lines crossing a
+  // sphere around the target volume and carry the corresponding weight
+  G4GenericMessenger::Command& target_centre =
+    msg_->DeclareProperty("bias_target_centre", target_centre_,
+                          "Set centre of the sphere enclosing the target volume");
+  target_centre.SetUnitCategory("Length");
+
+  G4GenericMessenger::Command& target_radius =
+    msg_->DeclareProperty("bias_target_rad", target_rad_,
+                          "Set radius of the sphere enclosing the target volume (0 = no bias)");
+  target_radius.SetUnitCategory("Length");
+  target_radius.SetParameterName("bias_target_rad", false);
+  target_radius.SetRange("bias_target_rad>=0.");
+
   DetectorConstruction* detconst =
     (DetectorConstruction*) G4RunManager::GetRunManager()->GetUserDetectorConstruction();
   geom_ = detconst->GetGeometry();
@@ -163,6 +179,13 @@ void MuonGenerator::SetupAngles()
 }
 
 
+void MuonGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  region_handle_ = geom_->GetRegion(region_);
+}
+
+
 void MuonGenerator::GeneratePrimaryVertex(G4Event* event)
 {
 
@@ -226,41 +249,37 @@ void MuonGenerator::GeneratePrimaryVertex(G4Event* event)
   G4double zenith;
   G4double azimuth;
 
-  // Momentum, zenith, azimuth (and energy) from angular distribution file
-  if (use_lsc_dist_){
-    GetDirection(p_dir, zenith, azimuth, energy, kinetic_energy, mass);
-    //    position = geom_->GenerateVertex(region_);
-  }
-  else {
-
-    // User specified muon direction in some fixed direction
-    if ( user_dir_ != G4ThreeVector{}) {
-      p_dir   = user_dir_.unit();
-      zenith  = p_dir.getTheta();
-      azimuth = p_dir.getPhi() + pi; // change azimuth interval to be between 0, twopi
-    }
-
-    // Sample direction via cos^2 distribution for zenith, uniform azimuth
-    else {
-      zenith  = GetZenith();
-      azimuth = GetAzimuth(); // Returns from 0 to 2pi
-
-      // Calculate the vector components of the muon
-      p_dir.setX(sin(zenith) * sin(azimuth));
-      p_dir.setY(-cos(zenith));
-      p_dir.setZ(-sin(zenith) * cos(azimuth));
-
-      // Rotate about the Y-Axis
-      p_dir *= *rPhi_;
-
-    }
-  }
+  SampleDirection(p_dir, zenith, azimuth, energy, kinetic_energy, mass);
 
   G4ThreeVector position;
   if ((region_ == "HALLA_INNER") || (region_ == "HALLA_OUTER")) {
-    position = ProjectToVertex(p_dir);
+    if (target_rad_ > 0.) {
+      // The acceptance of the target depends on the direction, so a
+      // rejected point also rejects its direction, which is sampled
+      // again for the next trial
+      const G4int max_trials = 1000000;
+      G4ThreeVector point;
+      ntrials_ = 1;
+      while (!PointTowardsTarget(p_dir, point)) {
+        if (ntrials_ == max_trials) {
+          G4String msg = "No muon reached the bias target after "
+            + std::to_string(max_trials) + " trials.";
+          G4Exception("[MuonGenerator]", "GeneratePrimaryVertex()",
+                      FatalException, msg);
+        }
+        ++ntrials_;
+        SampleDirection(p_dir, zenith, azimuth, energy, kinetic_energy, mass);
+      }
+      position = geom_->ProjectToRegion(region_, point, -p_dir);
+    } else {
+      position = ProjectToVertex(p_dir);
+    }
+  } else if (target_rad_ > 0.) {
+    G4Exception("[MuonGenerator]", "GeneratePrimaryVertex()", FatalException,
+                "The biased mode requires the HALLA_INNER or HALLA_OUTER region");
   } else {
-    position = geom_->GenerateVertex(region_);
+    if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+    position = (*region_handle_)();
   }
 
   G4double pmod   = std::sqrt(energy*energy - mass*mass);
@@ -274,6 +293,24 @@ void MuonGenerator::GeneratePrimaryVertex(G4Event* event)
   // Create a new vertex
   G4PrimaryVertex* vertex = new G4PrimaryVertex(position, time);
 
+  // In biased mode, the muons are weighted with the ratio of the areas of
+  // the target and generation discs. The weighted events are then
+  // equivalent to as many unbiased muons as trials, which are counted
+  // for the normalization (they exceed the events if the target disc
+  // sticks out of the generation one).
+  if (target_rad_ > 0.) {
+    G4double ratio = target_rad_ / gen_rad_;
+    vertex->SetWeight(ratio * ratio);
+
+    PersistencyManager* pm = dynamic_cast<PersistencyManager*>
+      (G4VPersistencyManager::GetPersistencyManager());
+    if (pm) {
+      pm->SaveEventWeights(true);
+      pm->AddToRunCounter("muon_bias_trials", ntrials_);
+      pm->AddToRunCounter("muon_bias_accepted", 1);
+    }
+  }
+
   // Create the new primary particle and set it some properties
   G4PrimaryParticle* particle =
     new G4PrimaryParticle(particle_definition_, px, py, pz);
@@ -353,6 +390,42 @@ void MuonGenerator::GetDirection(G4ThreeVector& dir, G4double& zenith,
 }
 
 
+void MuonGenerator::SampleDirection(G4ThreeVector& p_dir, G4double& zenith,
+                                    G4double& azimuth, G4double& energy,
+                                    G4double& kinetic_energy, G4double mass)
+{
+  // Momentum, zenith, azimuth (and energy) from angular distribution file
+  if (use_lsc_dist_){
+    GetDirection(p_dir, zenith, azimuth, energy, kinetic_energy, mass);
+    //    position = geom_->GenerateVertex(region_);
+  }
+  else {
+
+    // User specified muon direction in some fixed direction
+    if ( user_dir_ != G4ThreeVector{}) {
+      p_dir   = user_dir_.unit();
+      zenith  = p_dir.getTheta();
+      azimuth = p_dir.getPhi() + pi; // change azimuth interval to be between 0, twopi
+    }
+
+    // Sample direction via cos^2 distribution for zenith, uniform azimuth
+    else {
+      zenith  = GetZenith();
+      azimuth = GetAzimuth(); // Returns from 0 to 2pi
+
+      // Calculate the vector components of the muon
+      p_dir.setX(sin(zenith) * sin(azimuth));
+      p_dir.setY(-cos(zenith));
+      p_dir.setZ(-sin(zenith) * cos(azimuth));
+
+      // Rotate about the Y-Axis
+      p_dir *= *rPhi_;
+
+    }
+  }
+}
+
+
 G4ThreeVector MuonGenerator::ProjectToVertex(const G4ThreeVector& dir)
 {
   /////////////////////////////////////////////////////////////////////////
@@ -383,6 +456,26 @@ G4ThreeVector MuonGenerator::ProjectToVertex(const G4ThreeVector& dir)
 }
 
 
+G4bool MuonGenerator::PointTowardsTarget(const G4ThreeVector& dir,
+                                         G4ThreeVector& point) const
+{
+  // The point is sampled uniformly in the disc perpendicular to dir
+  // where the lines crossing the target sphere pass, which is centred
+  // on the projection of the target centre. Points outside the
+  // generation disc (which would never be generated without biasing)
+  // are rejected.
+  G4ThreeVector u = dir.orthogonal().unit();
+  G4ThreeVector v = dir.cross(u).unit();
+  G4ThreeVector centre = target_centre_ - target_centre_.dot(dir) * dir;
+
+  G4double radius = target_rad_ * std::sqrt(G4UniformRand());
+  G4double ang    = twopi * G4UniformRand();
+  point = centre + radius * (std::cos(ang) * u + std::sin(ang) * v);
+
+  return point.mag() <= gen_rad_;
+}
+
+
 G4double MuonGenerator::GetZenith() const
 {
   return fRandomGeneral_->fire()*pi/2;
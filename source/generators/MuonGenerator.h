@@ -9,6 +9,8 @@
 #ifndef MUON_GENERATOR_H
 #define MUON_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 #include <G4RotationMatrix.hh>
 #include <Randomize.hh>
@@ -22,8 +24,6 @@ class G4VSolid;
 
 namespace nexus {
 
-  class GeometryBase;
-
 
   class MuonGenerator: public G4VPrimaryGenerator
   {
@@ -38,6 +38,9 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
   private:
 
     // Sets the rotation angle and the spectra to
@@ -51,8 +54,17 @@ namespace nexus {
     void GetDirection(G4ThreeVector& dir, G4double& zenith, G4double& azimuth,
                       G4double& energy, G4double& kinetic_energy, G4double mass);
 
+    // Sample the direction (and, from the file, the energy) of the muon
+    void SampleDirection(G4ThreeVector& dir, G4double& zenith, G4double& azimuth,
+                         G4double& energy, G4double& kinetic_energy, G4double mass);
+
     G4ThreeVector ProjectToVertex(const G4ThreeVector& dir);
 
+    // Sample a point through which a line with direction dir crosses
+    // the bias target sphere. Returns false if the point falls
+    // outside the generation disc and the trial is rejected.
+    G4bool PointTowardsTarget(const G4ThreeVector& dir, G4ThreeVector& point) const;
+
     G4bool CheckOverlap(const G4ThreeVector& vtx, const G4ThreeVector& dir);
 
     /// Load in the Muon Angular/Energy Distribution from CSV file
@@ -88,6 +100,7 @@ namespace nexus {
     G4bool bInitialize_;  ///< Check if initialisation is already done
 
     const GeometryBase* geom_; ///< Pointer to the detector geometry
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
 
     G4VSolid * geom_solid_;
 
@@ -99,6 +112,10 @@ namespace nexus {
 
     G4double gen_rad_; ///< Radius of disc for generation
 
+    G4ThreeVector target_centre_; ///< Centre of the sphere enclosing the bias target
+    G4double target_rad_; ///< Radius of the bias target sphere (no biasing if 0)
+    G4int ntrials_; ///< Trials (directions sampled) of the current event in biased mode
+
   };
 
 } // end namespace nexus
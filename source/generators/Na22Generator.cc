@@ -31,14 +31,14 @@ namespace nexus {
 
   using namespace CLHEP;
 
-  Na22Generator::Na22Generator() : geom_(0)
+  Na22Generator::Na22Generator() : geom_(0), region_handle_(nullptr)
   {
     /// For the moment, only random direction are allowed. To be fixed if needed
      msg_ = new G4GenericMessenger(this, "/Generator/Na22Generator/",
     "Control commands of Na22 generator.");
 
-     msg_->DeclareProperty("region", region_,
-                           "Region of the geometry where the vertex will be generated.");
+     msg_->DeclareMethod("region", &Na22Generator::SetRegion,
+                         "Region of the geometry where the vertex will be generated.");
 
 
     DetectorConstruction* detconst = (DetectorConstruction*)
@@ -50,10 +50,17 @@ namespace nexus {
   {
   }
 
+  void Na22Generator::SetRegion(G4String region)
+  {
+    region_ = region;
+    region_handle_ = geom_->GetRegion(region_);
+  }
+
   void Na22Generator::GeneratePrimaryVertex(G4Event* evt)
   {
     // Ask the geometry to generate a position for the particle
-    G4ThreeVector position = geom_->GenerateVertex(region_);
+    if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+    G4ThreeVector position = (*region_handle_)();
     G4double time = 0.;
     G4PrimaryVertex* vertex =
         new G4PrimaryVertex(position, time);
@@ -11,6 +11,8 @@
 #ifndef NA22_GENERATOR_H
 #define NA22_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4Event;
@@ -18,8 +20,6 @@ class G4GenericMessenger;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class Na22Generator: public G4VPrimaryGenerator
   {
   public:
@@ -30,10 +30,14 @@ namespace nexus {
 
     void GeneratePrimaryVertex(G4Event* evt);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
   private:
 
     G4GenericMessenger* msg_;
     const GeometryBase* geom_;
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
 
     G4String region_;
 
@@ -0,0 +1,230 @@
+// ----------------------------------------------------------------------------
+// nexus | PhaseSpaceGenerator.cc
+//
+// This class is the primary generator of the second stage of two-stage
+// simulations of external backgrounds. It replays the particles recorded by
+// the PhaseSpaceSteppingAction at the boundary of a volume, keeping their
+// positions, momenta, times and weights. The libraries written by the
+// threads of a multithreaded first stage can be added one after the other.
+// Optionally, each event is rotated by a random angle around an axis
+// parallel to z (the axis of the detector), so that a first stage with
+// limited statistics can be reused several times. This is only valid if
+// the recording boundary is symmetric about the axis: the rotated particles
+// must still lie on the boundary of the recording volume, otherwise another
+// angle is drawn, and the run is stopped if none is found.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PhaseSpaceGenerator.h"
+#include "PersistencyManager.h"
+#include "FactoryBase.h"
+
+#include <G4Event.hh>
+#include <G4GenericMessenger.hh>
+#include <G4ParticleTable.hh>
+#include <G4IonTable.hh>
+#include <G4PrimaryParticle.hh>
+#include <G4PrimaryVertex.hh>
+#include <G4RunManager.hh>
+#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
+#include <G4VPhysicalVolume.hh>
+#include <Randomize.hh>
+
+#include <CLHEP/Units/SystemOfUnits.h>
+#include <CLHEP/Units/PhysicalConstants.h>
+
+using namespace nexus;
+using namespace CLHEP;
+
+REGISTER_CLASS(PhaseSpaceGenerator, G4VPrimaryGenerator)
+
+
+PhaseSpaceGenerator::PhaseSpaceGenerator():
+  G4VPrimaryGenerator(), msg_(0), nevents_(0), nsource_(0),
+  first_event_(0), cycle_(false), resample_phi_(false), axis_point_{},
+  volume_("INNER_AIR"), geom_navigator_(0)
+{
+  msg_ = new G4GenericMessenger(this, "/Generator/PhaseSpaceGenerator/",
+                                "Control commands of the phase space generator.");
+
+  msg_->DeclareMethod("file", &PhaseSpaceGenerator::AddFile,
+                      "Phase space library written by the PhaseSpaceSteppingAction. "
+                      "The command can be repeated to replay several libraries.");
+
+  G4GenericMessenger::Command& first_event_cmd =
+    msg_->DeclareProperty("first_event", first_event_,
+                          "First library event to be replayed.");
+  first_event_cmd.SetParameterName("first_event", false);
+  first_event_cmd.SetRange("first_event>=0");
+
+  msg_->DeclareProperty("cycle", cycle_,
+                        "Start over at the end of the libraries instead of "
+                        "aborting the run.");
+
+  msg_->DeclareProperty("resample_phi", resample_phi_,
+                        "Rotate each event by a random angle around the axis. "
+                        "The recording boundary must be symmetric about it.");
+
+  msg_->DeclarePropertyWithUnit("axis_point", "mm", axis_point_,
+                                "Point of the rotation axis, which is parallel to z.");
+
+  msg_->DeclareProperty("volume", volume_,
+                        "Volume whose entrance was recorded, where the "
+                        "rotated particles must be (with resample_phi).");
+
+  geom_navigator_ =
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+}
+
+
+
+PhaseSpaceGenerator::~PhaseSpaceGenerator()
+{
+  delete msg_;
+}
+
+
+
+void PhaseSpaceGenerator::AddFile(G4String filename)
+{
+  auto library = std::make_unique<PrimaryEventLibrary>();
+  library->Open(filename);
+
+  nevents_ += library->GetNumberOfEvents();
+  nsource_ += library->GetNumberOfSourceEvents();
+  libraries_.push_back(std::move(library));
+
+  G4cout << "[PhaseSpaceGenerator] " << nevents_ << " events recorded in "
+         << nsource_ << " source events." << G4endl;
+}
+
+
+
+void PhaseSpaceGenerator::GeneratePrimaryVertex(G4Event* event)
+{
+  if (nevents_ == 0) {
+    G4Exception("[PhaseSpaceGenerator]", "GeneratePrimaryVertex()", FatalException,
+                "No phase space events to replay.");
+    return;
+  }
+
+  // Each event of the run replays its own library event, counted
+  // from first_event, so that runs can start anywhere in the libraries.
+  // The events replayed by the preceding forked jobs are skipped
+  uint64_t k = PrimaryEventLibrary::GetReplayIndex(first_event_, event->GetEventID());
+
+  if (k >= nevents_) {
+    if (!cycle_) {
+      G4cout  << "[PhaseSpaceGenerator] End of phase space reached. "
+              << "Aborting the run..." << G4endl;
+      G4RunManager::GetRunManager()->AbortRun();
+      return;
+    }
+    k %= nevents_;
+  }
+
+  size_t l = 0;
+  while (k >= libraries_[l]->GetNumberOfEvents()) {
+    k -= libraries_[l]->GetNumberOfEvents();
+    ++l;
+  }
+
+  const LibraryEvent& evt = libraries_[l]->GetEvent(k);
+  const LibraryParticle* particles = libraries_[l]->GetParticles(k);
+
+  // The replayed events are weighted
+  PersistencyManager* pm = dynamic_cast<PersistencyManager*>
+    (G4VPersistencyManager::GetPersistencyManager());
+  if (pm) pm->SaveEventWeights(true);
+
+  G4RotationMatrix rotation;
+  if (resample_phi_)
+    rotation = SamplePhiRotation(evt, particles);
+
+  // The weight of each particle is stored in the libraries
+  // written since the per-particle weights were introduced
+  const G4bool has_weights = libraries_[l]->HasWeights();
+
+  for (uint32_t i=0; i<evt.nparticles; ++i) {
+    const LibraryParticle& p = particles[i];
+
+    G4ParticleDefinition* pdef =
+      G4ParticleTable::GetParticleTable()->FindParticle(p.pdg);
+    if (!pdef) pdef = G4IonTable::GetIonTable()->GetIon(p.pdg);
+    if (!pdef) {
+      G4String msg = "Unknown particle with PDG code " + std::to_string(p.pdg)
+        + " in the phase space libraries.";
+      G4Exception("[PhaseSpaceGenerator]", "GeneratePrimaryVertex()",
+                  FatalException, msg);
+      return;
+    }
+
+    G4ThreeVector position(p.x*mm, p.y*mm, p.z*mm);
+    G4ThreeVector momentum(p.px*MeV, p.py*MeV, p.pz*MeV);
+    if (resample_phi_) {
+      position = rotation * (position - axis_point_) + axis_point_;
+      momentum = rotation * momentum;
+    }
+
+    G4PrimaryParticle* particle = new G4PrimaryParticle(pdef);
+    particle->SetMomentum(momentum.x(), momentum.y(), momentum.z());
+    particle->SetWeight(has_weights ? p.weight : evt.weight);
+
+    G4PrimaryVertex* vertex =
+      new G4PrimaryVertex(position, (evt.time + p.t)*ns);
+    vertex->SetPrimary(particle);
+    event->AddPrimaryVertex(vertex);
+  }
+}
+
+
+
+G4RotationMatrix
+PhaseSpaceGenerator::SamplePhiRotation(const LibraryEvent& evt,
+                                       const LibraryParticle* particles)
+{
+  // A rotation around the axis only moves the particles along the
+  // boundary if it is symmetric about the axis. Angles that take any
+  // particle off the boundary are rejected; if the boundary is not
+  // symmetric (e.g., a box), no angle is accepted.
+  const G4int max_trials = 1000;
+
+  for (G4int trial=0; trial<max_trials; ++trial) {
+    G4RotationMatrix rotation;
+    rotation.rotateZ(twopi * G4UniformRand());
+
+    G4bool on_boundary = true;
+    for (uint32_t i=0; i<evt.nparticles && on_boundary; ++i) {
+      const LibraryParticle& p = particles[i];
+      G4ThreeVector position(p.x*mm, p.y*mm, p.z*mm);
+      G4ThreeVector momentum(p.px*MeV, p.py*MeV, p.pz*MeV);
+      position = rotation * (position - axis_point_) + axis_point_;
+      momentum = rotation * momentum;
+      on_boundary = OnRecordingBoundary(position, momentum.unit());
+    }
+
+    if (on_boundary) return rotation;
+  }
+
+  G4String msg = "No rotation around the axis keeps the particles on the boundary of "
+    + volume_ + ". resample_phi requires a recording boundary symmetric about the axis.";
+  G4Exception("[PhaseSpaceGenerator]", "SamplePhiRotation()", FatalException, msg);
+  return G4RotationMatrix();
+}
+
+
+
+G4bool PhaseSpaceGenerator::OnRecordingBoundary(const G4ThreeVector& position,
+                                                const G4ThreeVector& direction) const
+{
+  // The particles were recorded as they entered the volume, so they
+  // must be located in it when moving along their direction
+  G4VPhysicalVolume* volume =
+    geom_navigator_->LocateGlobalPointAndSetup(position, &direction, false, false);
+  if (!volume || volume->GetName() != volume_) return false;
+
+  const G4double tolerance = 1.*micrometer;
+  return geom_navigator_->ComputeSafety(position) < tolerance;
+}
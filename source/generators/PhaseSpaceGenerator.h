@@ -0,0 +1,81 @@
+// ----------------------------------------------------------------------------
+// nexus | PhaseSpaceGenerator.h
+//
+// This class is the primary generator of the second stage of two-stage
+// simulations of external backgrounds. It replays the particles recorded by
+// the PhaseSpaceSteppingAction at the boundary of a volume, keeping their
+// positions, momenta, times and weights. The libraries written by the
+// threads of a multithreaded first stage can be added one after the other.
+// Optionally, each event is rotated by a random angle around an axis
+// parallel to z (the axis of the detector), so that a first stage with
+// limited statistics can be reused several times. This is only valid if
+// the recording boundary is symmetric about the axis: the rotated particles
+// must still lie on the boundary of the recording volume, otherwise another
+// angle is drawn, and the run is stopped if none is found.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PHASE_SPACE_GENERATOR_H
+#define PHASE_SPACE_GENERATOR_H
+
+#include "PrimaryEventLibrary.h"
+
+#include <G4VPrimaryGenerator.hh>
+#include <G4ThreeVector.hh>
+#include <G4RotationMatrix.hh>
+
+#include <memory>
+#include <vector>
+
+class G4Event;
+class G4GenericMessenger;
+class G4Navigator;
+
+
+namespace nexus {
+
+  class PhaseSpaceGenerator: public G4VPrimaryGenerator
+  {
+  public:
+    /// Constructor
+    PhaseSpaceGenerator();
+    /// Destructor
+    ~PhaseSpaceGenerator();
+
+    /// This method is invoked at the beginning of the event. It adds
+    /// the particles of the next library event as primary vertices.
+    void GeneratePrimaryVertex(G4Event*);
+
+  private:
+    /// Add a library to the list of replayed ones
+    void AddFile(G4String);
+
+    /// Random rotation around the axis that keeps all the particles
+    /// of an event on the boundary of the recording volume
+    G4RotationMatrix SamplePhiRotation(const LibraryEvent&,
+                                       const LibraryParticle*);
+    /// Whether a particle entering with the given direction at
+    /// a position is on the boundary of the recording volume
+    G4bool OnRecordingBoundary(const G4ThreeVector& position,
+                               const G4ThreeVector& direction) const;
+
+  private:
+    G4GenericMessenger* msg_;
+
+    std::vector<std::unique_ptr<PrimaryEventLibrary>> libraries_;
+    uint64_t nevents_; ///< Number of events in all libraries
+    uint64_t nsource_; ///< Number of source events of all libraries
+
+    G4long first_event_; ///< First library event to be replayed
+    G4bool cycle_;       ///< Whether to start over at the end of the libraries
+    G4bool resample_phi_;    ///< Whether to rotate the events randomly around the axis
+    G4ThreeVector axis_point_; ///< Point of the rotation axis
+    G4String volume_;          ///< Volume whose entrance was recorded
+
+    G4Navigator* geom_navigator_; ///< Geometry navigator
+  };
+
+} // end namespace nexus
+
+#endif
@@ -14,6 +14,8 @@
 #include "GeometryBase.h"
 #include "OpticalMaterialProperties.h"
 #include "FactoryBase.h"
+#include "ThinningInformation.h"
+#include "PersistencyManager.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4ParticleDefinition.hh>
@@ -23,6 +25,7 @@
 #include <G4Event.hh>
 #include <G4RandomDirection.hh>
 #include <G4OpticalPhoton.hh>
+#include <CLHEP/Random/RandBinomial.h>
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
@@ -33,16 +36,23 @@ REGISTER_CLASS(ScintillationGenerator, G4VPrimaryGenerator)
 
 
 ScintillationGenerator::ScintillationGenerator() :
-  G4VPrimaryGenerator(), msg_(0), geom_(0), nphotons_(1000000)
+  G4VPrimaryGenerator(), msg_(0), geom_(0), region_handle_(nullptr), nphotons_(1000000),
+  photon_fraction_(1.)
 {
   msg_ = new G4GenericMessenger(this, "/Generator/ScintGenerator/",
     "Control commands of scintillation generator.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where the vertex will be generated.");
+  msg_->DeclareMethod("region", &ScintillationGenerator::SetRegion,
+                      "Region of the geometry where the vertex will be generated.");
 
   msg_->DeclareProperty("nphotons", nphotons_, "Number of photons");
 
+  G4GenericMessenger::Command& fraction_cmd =
+    msg_->DeclareMethod("photon_fraction", &ScintillationGenerator::SetPhotonFraction,
+                        "Fraction of photons generated (thinning).");
+  fraction_cmd.SetParameterName("photon_fraction", false);
+  fraction_cmd.SetRange("photon_fraction>0. && photon_fraction<=1.");
+
   geom_navigator_ =
     G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
 
@@ -56,11 +66,24 @@ ScintillationGenerator::~ScintillationGenerator()
   delete msg_;
 }
 
+void ScintillationGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  region_handle_ = geom_->GetRegion(region_);
+}
+
+void ScintillationGenerator::SetPhotonFraction(G4double fraction)
+{
+  photon_fraction_ = fraction;
+  if (photon_fraction_ < 1.) ThinningInformation::EnableThinning();
+}
+
 void ScintillationGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   G4ParticleDefinition* particle_definition = G4OpticalPhoton::Definition();
   // Generate an initial position for the particle using the geometry and set time to 0.
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+  G4ThreeVector position = (*region_handle_)();
   G4double time = 0.;
 
   // Energy is sampled from integral (like it is done in G4Scintillation)
@@ -92,7 +115,18 @@ void ScintillationGenerator::GeneratePrimaryVertex(G4Event* event)
   // Create a new vertex
   G4PrimaryVertex* vertex = new G4PrimaryVertex(position, time);
 
-  for ( G4int i = 0; i<nphotons_; i++)
+  // When thinning, only a binomial fraction of the photons is generated,
+  // each one marked with the inverse of the fraction as thinning weight
+  G4int nphotons = nphotons_;
+  if (photon_fraction_ < 1.) {
+    nphotons = G4int(CLHEP::RandBinomial::shoot(nphotons_, photon_fraction_));
+
+    PersistencyManager* pm = dynamic_cast<PersistencyManager*>
+      (G4VPersistencyManager::GetPersistencyManager());
+    if (pm) pm->SaveEventWeights(true);
+  }
+
+  for ( G4int i = 0; i<nphotons; i++)
     {
       // Generate random direction by default
       G4ThreeVector _momentum_direction = G4RandomDirection();
@@ -109,6 +143,8 @@ void ScintillationGenerator::GeneratePrimaryVertex(G4Event* event)
 
       G4ThreeVector polarization = G4RandomDirection();
       particle->SetPolarization(polarization);
+      if (photon_fraction_ < 1.)
+        particle->SetUserInformation(new ThinningInformation(1. / photon_fraction_));
 
       // Add particle to the vertex and this to the event
       vertex->SetPrimary(particle);
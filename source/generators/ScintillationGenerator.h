@@ -11,6 +11,8 @@
 #ifndef SCINTILLATION_GENERATOR_H
 #define SCINTILLATION_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 #include <G4Navigator.hh>
 #include <G4TransportationManager.hh>
@@ -21,8 +23,6 @@ class G4Event;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class ScintillationGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -36,6 +36,12 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
+    /// Set the fraction of photons generated (thinning if below 1)
+    void SetPhotonFraction(G4double);
+
   private:
 
     void ComputeCumulativeDistribution(const G4PhysicsOrderedFreeVector&,
@@ -44,9 +50,11 @@ namespace nexus {
     G4GenericMessenger* msg_;
     G4Navigator* geom_navigator_; ///< Geometry Navigator
     const GeometryBase* geom_; ///< Pointer to the detector geometry
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
 
     G4String region_;
     G4int    nphotons_;
+    G4double photon_fraction_; ///< Fraction of photons generated (thinning)
 
   };
 
@@ -38,7 +38,7 @@ REGISTER_CLASS(SingleParticleGenerator, G4VPrimaryGenerator)
 
 SingleParticleGenerator::SingleParticleGenerator():
 G4VPrimaryGenerator(), msg_(0), particle_definition_(0),
-energy_min_(0.), energy_max_(0.), geom_(0), momentum_{},
+energy_min_(0.), energy_max_(0.), geom_(0), region_handle_(nullptr), momentum_{},
 costheta_min_(-1.), costheta_max_(1.), phi_min_(0.), phi_max_(2.*pi)
 {
   msg_ = new G4GenericMessenger(this, "/Generator/SingleParticle/",
@@ -59,8 +59,8 @@ costheta_min_(-1.), costheta_max_(1.), phi_min_(0.), phi_max_(2.*pi)
   max_energy.SetParameterName("max_energy", false);
   max_energy.SetRange("max_energy>0.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where the vertex will be generated.");
+  msg_->DeclareMethod("region", &SingleParticleGenerator::SetRegion,
+                      "Region of the geometry where the vertex will be generated.");
 
 
   msg_->DeclarePropertyWithUnit("momentum", "mm",  momentum_, "Particle 3-momentum.");
@@ -100,6 +100,14 @@ void SingleParticleGenerator::SetParticleDefinition(G4String particle_name)
 
 
 
+void SingleParticleGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  region_handle_ = geom_->GetRegion(region_);
+}
+
+
+
 void SingleParticleGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   // Generate uniform random energy in [E_min, E_max]
@@ -134,7 +142,8 @@ void SingleParticleGenerator::GeneratePrimaryVertex(G4Event* event)
   }
 
   // Generate an initial position for the particle using the geometry
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  if (!region_handle_) region_handle_ = geom_->GetRegion(region_);
+  G4ThreeVector position = (*region_handle_)();
 
   // Particle generated at start-of-event
   G4double time = 0.;
@@ -14,6 +14,8 @@
 #ifndef SINGLE_PARTICLE_GENERATOR_H
 #define SINGLE_PARTICLE_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4GenericMessenger;
@@ -23,8 +25,6 @@ class G4ParticleDefinition;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class SingleParticleGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -38,6 +38,9 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+    /// Set the vertex generation region and resolve its handle
+    void SetRegion(G4String);
+
   private:
 
     void SetParticleDefinition(G4String);
@@ -52,6 +55,7 @@ namespace nexus {
     G4double energy_max_; ///< Maximum kinetic energy
 
     const GeometryBase* geom_; ///< Pointer to the detector geometry
+    GeometryBase::RegionHandle region_handle_; ///< Handle of the vertex generation region
 
     G4String region_;
 
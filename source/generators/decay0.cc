@@ -10,8 +10,16 @@
 
 #include "decay0.h"
 
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
 #include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <unistd.h>
 #include <G4RandomDirection.hh>
 #include <Randomize.hh>
 #include <G4GenericMessenger.hh>
@@ -36,6 +44,61 @@ levelE_(Elev), // Ground state, default..
 itrans02_(itr2)
 {
 }
+bool bbAliasTable::build(const std::vector<double> &weights) {
+// Vose's variant of the Walker alias method.
+  prob_.clear();
+  alias_.clear();
+  const size_t n = weights.size();
+  double sum = 0.;
+  for (size_t i=0; i != n; i++) sum += weights[i];
+  if (!(sum > 0.)) return false;
+  std::vector<double> scaled(n);
+  std::vector<size_t> small, large;
+  for (size_t i=0; i != n; i++) {
+    scaled[i] = weights[i]*n/sum;
+    if (scaled[i] < 1.) small.push_back(i);
+    else large.push_back(i);
+  }
+  prob_.assign(n, 1.f);
+  alias_.resize(n);
+  for (size_t i=0; i != n; i++) alias_[i] = i;
+  while (!small.empty() && !large.empty()) {
+    const size_t s = small.back(); small.pop_back();
+    const size_t l = large.back();
+    prob_[s] = static_cast<float>(scaled[s]);
+    alias_[s] = l;
+    scaled[l] -= (1. - scaled[s]);
+    if (scaled[l] < 1.) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // Whatever is left has probability 1 up to rounding errors.
+  return true;
+}
+size_t bbAliasTable::sample(double u1, double u2) const {
+  const size_t i = std::min(prob_.size() - 1,
+                            static_cast<size_t>(u1*prob_.size()));
+  return (u2 < prob_[i]) ? i : alias_[i];
+}
+void bbAliasTable::write(std::ostream &out) const {
+  const uint64_t n = prob_.size();
+  out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  out.write(reinterpret_cast<const char*>(prob_.data()), n*sizeof(float));
+  out.write(reinterpret_cast<const char*>(alias_.data()), n*sizeof(unsigned int));
+}
+bool bbAliasTable::read(std::istream &in) {
+  uint64_t n = 0;
+  if (!in.read(reinterpret_cast<char*>(&n), sizeof(n))) return false;
+  if (n > (1u << 24)) return false; // not a sane table
+  prob_.resize(n);
+  alias_.resize(n);
+  in.read(reinterpret_cast<char*>(prob_.data()), n*sizeof(float));
+  in.read(reinterpret_cast<char*>(alias_.data()), n*sizeof(unsigned int));
+  if (!in) return false;
+  for (size_t i=0; i != n; i++) if (alias_[i] >= n) return false;
+  return true;
+}
 
 decay0::decay0():
 ready_(false),
@@ -43,7 +106,8 @@ emass_(0.51099906),
 nuclideName_("Xe136"),
 fsNum_(0),
 modebb_(0),
-modebbOld_(0)
+modebbOld_(0),
+useTables_(true)
 {
   ebb1_ = 0.;
   ebb2_ = 4.3; // original code, line 628
@@ -52,14 +116,17 @@ modebbOld_(0)
 }
 decay0::decay0(const std::string nuclide, int finalStateNumber,
                int decayModeNumber, std::string fname,
-               double eRangeLow, double eRangeHigh):
+               double eRangeLow, double eRangeHigh,
+               bool useTables, std::string tablesCacheDir):
   fname_(fname),
   ready_(false),
   emass_(0.51099906),
   nuclideName_(nuclide),
   fsNum_(finalStateNumber),
   modebb_(decayModeNumber),
-  modebbOld_(decayModeNumber)
+  modebbOld_(decayModeNumber),
+  useTables_(useTables),
+  tablesCacheDir_(tablesCacheDir)
 {
   ebb1_ = eRangeLow;
   ebb2_ = eRangeHigh; // for mode 4, 2nbbdecay.
@@ -385,8 +452,147 @@ void decay0::initSpectrum() {
 	   }
 	   toallevents_ = r1/r2;
      }
+     tables_.reset();
+     if (useTables_) this->initSamplingTables();
      std::cout << " .... starting the generation " << std::endl;
 }
+void decay0::initSamplingTables() {
+// The tables only depend on the settings in samplingTablesKey and are never
+// modified once built, so the instances of all threads share one copy. It is
+// released when the last instance using it is destroyed.
+  static std::mutex tablesMutex;
+  static std::map<std::string, std::weak_ptr<const bbSamplingTables> > sharedTables;
+  const std::string key = this->samplingTablesKey();
+  std::lock_guard<std::mutex> lock(tablesMutex);
+  tables_ = sharedTables[key].lock();
+  if (tables_) return;
+  std::shared_ptr<bbSamplingTables> tables = std::make_shared<bbSamplingTables>();
+  this->buildSamplingTables(*tables);
+  tables_ = tables;
+  sharedTables[key] = tables_;
+}
+void decay0::buildSamplingTables(bbSamplingTables &t) const {
+// Tabulate the energy spectra so that decay0DoItbb does not need to throw
+// random numbers until acceptance. The e1 table reproduces exactly the
+// distribution sampled by the rejection loop (constant density within each
+// 1 keV bin of spthe1_, bin k starting at (k+1) keV). For the modes where the
+// second energy is random, the conditional distribution of e2 is tabulated
+// in 1 keV bins for each e1 bin, evaluating fe2 at the centres of both bins.
+// The tables end at the endpoint e0 (e1 + e2 <= e0), not at the upper limit
+// of the energy sum if it is larger.
+  const double eLow = (modebb_ == 10) ? ebb1_ : 0.;
+  const double eHigh = std::min(ebb2_, e0_);
+  std::vector<double> weights;
+  for (size_t k=0; k != spthe1_.size(); k++) {
+    const double a = std::max(eLow, static_cast<double>(k+1)/1000.);
+    const double b = std::min(eHigh, static_cast<double>(k+2)/1000.);
+    if ((b <= a) || !(spthe1_[k] > 0.)) continue;
+    t.e1Low_.push_back(a);
+    t.e1High_.push_back(b);
+    weights.push_back(spthe1_[k]*(b - a));
+  }
+  if (!t.e1Table_.build(weights)) {
+    std::cerr << " decay0::initSamplingTables, empty e1 spectrum, "
+              << "using the rejection method " << std::endl;
+    t.e1Low_.clear(); t.e1High_.clear();
+    return;
+  }
+  if ((modebb_ != 4) && (modebb_ != 5) && (modebb_ != 6) && (modebb_ != 8) &&
+      (modebb_ != 13) && (modebb_ != 14) && (modebb_ != 15) && (modebb_ != 16)) return;
+
+  std::string path;
+  if (!tablesCacheDir_.empty()) {
+    std::ostringstream fName;
+    fName << tablesCacheDir_ << "/decay0_" << nuclideName_ << "_mode" << modebb_
+          << "_level" << fsNum_ << "_" << static_cast<int>(std::lround(ebb1_*1000.))
+          << "_" << static_cast<int>(std::lround(eHigh*1000.)) << ".tab";
+    path = fName.str();
+    if (this->readSamplingTables(path, t)) {
+      t.e2FromCache_ = true;
+      std::cout << " decay0::initSamplingTables, e2 tables read from " << path << std::endl;
+      return;
+    }
+  }
+  std::cout << " decay0::initSamplingTables, tabulating the e2 spectra, "
+            << t.e1Low_.size() << " e1 bins " << std::endl;
+  std::vector<double> params(10, 0.);
+  params[0] = emass_;
+  params[1] = bbNucl_.Zdbb_;
+  params[2] = e0_;
+  t.e2Tables_.resize(t.e1Low_.size());
+  for (size_t i=0; i != t.e1Low_.size(); i++) {
+    const double e1 = 0.5*(t.e1Low_[i] + t.e1High_[i]);
+    params[3] = e1;
+    const double re2s = std::max(0., (ebb1_ - e1));
+    const double re2f = eHigh - e1;
+    t.e2Low_.push_back(re2s);
+    t.e2High_.push_back(re2f);
+    const size_t nBins = (re2f > re2s) ? static_cast<size_t>(std::ceil((re2f - re2s)*1000. - 1.e-9)) : 0;
+    std::vector<double> w(nBins, 0.);
+    for (size_t j=0; j != nBins; j++) {
+      const double a = re2s + static_cast<double>(j)/1000.;
+      const double b = std::min(re2f, a + 0.001);
+      w[j] = std::max(0., fe2_modXX(modebb_, 0.5*(a + b), &params[0]))*(b - a);
+    }
+    t.e2Tables_[i].build(w); // left empty if null: the rejection method is used
+  }
+  if (!path.empty()) this->writeSamplingTables(path, t);
+}
+std::string decay0::samplingTablesKey() const {
+// Everything the tables depend on, to share them and to validate a cache file.
+  std::ostringstream key;
+  key.precision(10);
+  key << "decay0-tables-v2 " << nuclideName_ << " " << modebb_ << " " << fsNum_
+      << " " << e0_ << " " << ebb1_ << " " << std::min(ebb2_, e0_) << " " << spthe1_.size();
+  return key.str();
+}
+bool decay0::readSamplingTables(const std::string &path, bbSamplingTables &t) const {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) return false;
+  std::string key;
+  std::getline(in, key);
+  if (key != samplingTablesKey()) {
+    std::cerr << " decay0::readSamplingTables, " << path
+              << " does not match the current settings, rebuilding " << std::endl;
+    return false;
+  }
+  const size_t n = t.e1Low_.size();
+  t.e2Low_.resize(n); t.e2High_.resize(n);
+  t.e2Tables_.resize(n);
+  for (size_t i=0; i != n; i++) {
+    in.read(reinterpret_cast<char*>(&t.e2Low_[i]), sizeof(double));
+    in.read(reinterpret_cast<char*>(&t.e2High_[i]), sizeof(double));
+    if (!in || !t.e2Tables_[i].read(in)) {
+      std::cerr << " decay0::readSamplingTables, " << path
+                << " is corrupted, rebuilding " << std::endl;
+      t.e2Tables_.clear(); t.e2Low_.clear(); t.e2High_.clear();
+      return false;
+    }
+  }
+  return true;
+}
+void decay0::writeSamplingTables(const std::string &path, const bbSamplingTables &t) const {
+// Written under a temporary name and renamed, so that concurrent jobs
+// never read a partially written file.
+  std::ostringstream tmpName;
+  tmpName << path << ".tmp" << getpid() << "_" << reinterpret_cast<uintptr_t>(this);
+  std::ofstream out(tmpName.str(), std::ios::binary);
+  if (!out.is_open()) {
+    std::cerr << " decay0::writeSamplingTables, cannot write " << tmpName.str() << std::endl;
+    return;
+  }
+  out << samplingTablesKey() << '\n';
+  for (size_t i=0; i != t.e2Tables_.size(); i++) {
+    out.write(reinterpret_cast<const char*>(&t.e2Low_[i]), sizeof(double));
+    out.write(reinterpret_cast<const char*>(&t.e2High_[i]), sizeof(double));
+    t.e2Tables_[i].write(out);
+  }
+  out.close();
+  if (!out || std::rename(tmpName.str().c_str(), path.c_str()) != 0) {
+    std::cerr << " decay0::writeSamplingTables, cannot write " << path << std::endl;
+    std::remove(tmpName.str().c_str());
+  }
+}
 //
 // Subroutine GENBBsub generates the events of decay of natural
 // radioactive nuclides and various modes of double beta decay.
@@ -454,7 +660,15 @@ void decay0::decay0DoItbb(std::vector<decay0Part> &outPart) const {
   double e2=0.;
   int numThrow = 0;
 //  std::cerr << " ebb1 " << ebb1_  <<  " ebb2 " << ebb2_ << std::endl;
-  while(true) {
+  size_t e1Bin = 0;
+  const bbSamplingTables *t = tables_.get();
+  if (t && (t->e1Table_.size() != 0)) {
+     const double u1 = G4UniformRand();
+     const double u2 = G4UniformRand();
+     e1Bin = t->e1Table_.sample(u1, u2);
+     e1_ = t->e1Low_[e1Bin] + (t->e1High_[e1Bin] - t->e1Low_[e1Bin])*G4UniformRand();
+  }
+  else while(true) {
      if (modebb_ != 10) e1_ = ebb2_*G4UniformRand();
      else e1_ = ebb1_ + (ebb2_ - ebb1_)*G4UniformRand();
 //     if ((e0_ - e1_) < 0.) continue; //not needed if energy range are set properly.
@@ -477,6 +691,24 @@ void decay0::decay0DoItbb(std::vector<decay0Part> &outPart) const {
 // something else is emitted - energy of second e-/e+ is random
 	double re2s = std::max(0., (ebb1_ - e1_));
 	double re2f = ebb2_ - e1_;
+	bool e2Sampled = false;
+	if (t && (e1Bin < t->e2Tables_.size()) && (t->e2Tables_[e1Bin].size() != 0)) {
+	 // The table was built for the centre of the e1 bin: the values out of
+	 // the range of e2 for the actual value of e1 are drawn again (clamping
+	 // them would pile up events at the limits). The ranges differ by less
+	 // than 1 keV, so a few draws are enough unless the range is tiny; the
+	 // rejection method is used then.
+	 for (int numDraws = 0; numDraws != 100; numDraws++) {
+	   const double u1 = G4UniformRand();
+	   const double u2 = G4UniformRand();
+	   const size_t j = t->e2Tables_[e1Bin].sample(u1, u2);
+	   const double a = t->e2Low_[e1Bin] + static_cast<double>(j)/1000.;
+	   const double b = std::min(t->e2High_[e1Bin], a + 0.001);
+	   e2 = a + (b - a)*G4UniformRand();
+	   if ((e2 >= re2s) && (e2 <= re2f)) { e2Sampled = true; break; }
+	 }
+	}
+	if (!e2Sampled) {
 	double f2max = -1;
 	params[3] = e1_;
 	int ke2s = std::max(0, static_cast<int>(re2s*1000.)-1);
@@ -537,6 +769,7 @@ void decay0::decay0DoItbb(std::vector<decay0Part> &outPart) const {
 	 }
 	 if ( f2max*G4UniformRand() < fe2) break;
         }
+	} // rejection method
       } else if( modebb_ == 10) {
 // energy of X-ray is fixed; no angular correlation
            this->timedParticle(outPart, 2, e1_, e1_, 0., M_PI, 0., twopi, 0., 0.);
@@ -1248,6 +1481,22 @@ double decay0::fe2_mod16(double e2, void *params) {
 	return a;
 }
 // ***********************************************************************
+double decay0::fe2_modXX(size_t mode, double e2, void *params) {
+// probability distribution for energy of second e-/e+ for the modes
+// where it is random
+	switch(mode) {
+	  case 4 : return fe2_mod4(e2, params);
+	  case 5 : return fe2_mod5(e2, params);
+	  case 6 : return fe2_mod6(e2, params);
+	  case 8 : return fe2_mod8(e2, params);
+	  case 13 : return fe2_mod13(e2, params);
+	  case 14 : return fe2_mod14(e2, params);
+	  case 15 : return fe2_mod15(e2, params);
+	  case 16 : return fe2_mod16(e2, params);
+	  default : return 0.;
+	}
+}
+// ***********************************************************************
 
 double decay0::fe1_mod17( double e1, void *params) {
 // probability distribution for energy of first e-/e+ for modebb=17
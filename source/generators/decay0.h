@@ -12,6 +12,8 @@
 #define DECAY0_H
 
 #include <fstream>
+#include <iosfwd>
+#include <memory>
 #include <vector>
 #include <string>
 #include <gsl/gsl_integration.h>
@@ -44,6 +46,30 @@ class bbNuclide {
     std::vector<bbFinalState> allFS_; // Allowed final states.
 };
 
+// Walker alias table: returns an index with probability proportional to the
+// weights it was built from, using two uniform random numbers.
+class bbAliasTable {
+  public:
+    bool build(const std::vector<double> &weights); // false if all weights are null
+    size_t sample(double u1, double u2) const;
+    inline size_t size() const { return prob_.size(); }
+    void write(std::ostream &out) const;
+    bool read(std::istream &in);
+  private:
+    std::vector<float> prob_;
+    std::vector<unsigned int> alias_;
+};
+
+// Sampling tables of the electron energies of a decay. Once built they are
+// only read, so all the decay0 instances with the same settings share them.
+struct bbSamplingTables {
+    bbAliasTable e1Table_;      // one entry per 1 keV bin of spthe1_ in range
+    std::vector<double> e1Low_, e1High_; // e1 interval of each entry of e1Table_
+    std::vector<bbAliasTable> e2Tables_; // 1 keV e2 bins, for each e1 entry
+    std::vector<double> e2Low_, e2High_; // e2 interval of each e2 table
+    bool e2FromCache_ = false;           // e2 tables read from a cache file
+};
+
 struct eta_nme {
   float chi_GTw_, chi_Fw_, chip_GT_, chip_F_, chip_T_,
                   chip_P_, chip_R_;
@@ -56,7 +82,8 @@ class decay0 {
      decay0();
      decay0(const std::string nuclide, int finalStateNumber,
             int decayModeNumber, std::string fname, double eRangeLow=0.0,
-            double eRangeHigh=4.3); // no limits, be default. (for 2nbbdecay. )
+            double eRangeHigh=4.3, // no limits, be default. (for 2nbbdecay. )
+            bool useTables=true, std::string tablesCacheDir="");
      ~decay0();
     void decay0DoIt(std::vector<decay0Part> &outPart) const ;
     void fillInfo(); // to be used if the Nuclide, final state or decay mode is changed...Not advised..
@@ -85,6 +112,13 @@ class decay0 {
 //                               (for modes 4,5,6,8,10 and 13).
     int mode_; //  in common/denrange/
     gsl_integration_workspace *gwk_;  // For integration..
+    // Sampling tables of the electron energies, built once in initSpectrum
+    // (or taken from another instance with the same settings, e.g. in another
+    // thread). If not used (or not available for the mode), the energies are
+    // sampled with the acceptance/rejection method of the original code.
+    bool useTables_;
+    std::string tablesCacheDir_; // if not empty, the e2 tables are cached there
+    std::shared_ptr<const bbSamplingTables> tables_;
 //    eta_nme  .. not supported yet...
     //
     // Internal variable, volatile all declared mutable. Filled and used in DoIt (subroutine bb in decay 0)
@@ -96,6 +130,11 @@ class decay0 {
     mutable std::vector<double> spthe2_;
 
     void initSpectrum(); // Called from fillInfo, initialize array for matrix element, kinematics and so forth.
+    void initSamplingTables(); // Called from initSpectrum, find or build the tables
+    void buildSamplingTables(bbSamplingTables &tables) const; // tabulate e1 and e2|e1
+    std::string samplingTablesKey() const;
+    bool readSamplingTables(const std::string &path, bbSamplingTables &tables) const;
+    void writeSamplingTables(const std::string &path, const bbSamplingTables &tables) const;
     void decay0DoItbb(std::vector<decay0Part> &outPart) const; // Main method, generate the two electrons.
     void Ba136low(std::vector<decay0Part> &outPart) const;  // Baryum 136 de-excitation.
 //    void Xe130low(std::vector<decay0Part> &outPart) const;  // Xenon de-excitation. // we (NEXT) don't care...
@@ -137,6 +176,7 @@ class decay0 {
     static double fe2_mod15(double x, void *p);
     static double fe12_mod16(double x, void *p);
     static double fe2_mod16(double x, void *p);
+    static double fe2_modXX(size_t mode, double x, void *p); // dispatch on mode
     static double fe1_mod17(double x, void *p);
     static double fe12_mod17(double x, void *p);
     static double dshelp1(double x, void *p);
@@ -159,6 +199,8 @@ class decay0 {
     inline size_t GetFinalStateNumber() { return fsNum_;}
     inline size_t GetDecayModeNumber() { return modebb_;}
     inline double GetEffectiveRatioToOfEvents() {return toallevents_; }
+    inline bool UsesSamplingTables() const { return tables_ && tables_->e1Table_.size() != 0; }
+    inline bool SamplingTablesFromCache() const { return tables_ && tables_->e2FromCache_; }
 
 };
 #endif
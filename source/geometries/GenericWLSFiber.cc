@@ -11,6 +11,7 @@
 #include "MaterialsList.h"
 #include "OpticalMaterialProperties.h"
 #include "Visibilities.h"
+#include "WLSFiberInfo.h"
 
 #include <G4Tubs.hh>
 #include <G4Box.hh>
@@ -21,6 +22,7 @@
 #include <G4GenericMessenger.hh>
 #include <G4OpticalSurface.hh>
 #include <G4LogicalSkinSurface.hh>
+#include <G4Region.hh>
 
 
 using namespace nexus;
@@ -48,7 +50,8 @@ GenericWLSFiber::GenericWLSFiber(G4String    name,
   coating_mat_    (coating_mat),
   coating_optProp_(nullptr),
   core_optProp_   (nullptr),
-  visibility_     (visibility)
+  visibility_     (visibility),
+  fast_model_     (false)
 {
 }
 
@@ -190,6 +193,8 @@ void GenericWLSFiber::BuildRoundFiber()
   new G4PVPlacement(nullptr, G4ThreeVector(0., 0., 0.), core_logic,
                     name_, iclad_logic, false, 0, false);
 
+  if (fast_model_) AddFastModelRegion(core_logic);
+
   // VISIBILITIES
   if (visibility_) {
     if (doubleclad_)
@@ -279,6 +284,8 @@ void GenericWLSFiber::BuildSquareFiber()
   new G4PVPlacement(nullptr, G4ThreeVector(0., 0., 0.), core_logic,
                     name_, iclad_logic, false, 0, false);
 
+  if (fast_model_) AddFastModelRegion(core_logic);
+
   // VISIBILITIES
   if (visibility_) {
     if (doubleclad_)
@@ -298,3 +305,15 @@ void GenericWLSFiber::BuildSquareFiber()
       coating_logic->SetVisAttributes(G4VisAttributes::GetInvisible());
   }
 }
+
+
+void GenericWLSFiber::AddFastModelRegion(G4LogicalVolume* core_logic)
+{
+  // The core is the envelope of the fast light transport model,
+  // and the trapping is given by the outermost cladding
+  G4Material* cladding_mat = doubleclad_ ? oclad_mat_ : iclad_mat_;
+
+  G4Region* region = new G4Region(name_ + "_CORE");
+  region->SetUserInformation(new WLSFiberInfo(cladding_mat));
+  region->AddRootLogicalVolume(core_logic);
+}
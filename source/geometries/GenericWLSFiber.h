@@ -52,6 +52,8 @@ namespace nexus {
 
     // Setters
     void SetVisibility(G4bool visibility);
+    // Transport the light trapped in the fiber with the WLSFiberModel
+    void SetFastModel(G4bool fast_model);
 
   private:
 
@@ -59,6 +61,7 @@ namespace nexus {
     void ComputeDimensions();
     void BuildRoundFiber();
     void BuildSquareFiber();
+    void AddFastModelRegion(G4LogicalVolume* core_logic);
 
     G4String    name_;
     G4bool      verbosity_;
@@ -78,6 +81,7 @@ namespace nexus {
     G4MaterialPropertiesTable* core_optProp_;
 
     G4bool      visibility_;
+    G4bool      fast_model_;
   };
 
 
@@ -89,6 +93,8 @@ namespace nexus {
 
   inline void GenericWLSFiber::SetVisibility(G4bool visibility)
   { visibility_ = visibility; }
+  inline void GenericWLSFiber::SetFastModel(G4bool fast_model)
+  { fast_model_ = fast_model; }
   inline void GenericWLSFiber::SetCoatingOpticalProperties(G4MaterialPropertiesTable* ctmp)
   { coating_optProp_ = ctmp; }
   inline void GenericWLSFiber::SetCoreOpticalProperties(G4MaterialPropertiesTable* crmp)
@@ -0,0 +1,101 @@
+// ----------------------------------------------------------------------------
+// nexus | GeometryBase.cc
+//
+// This is an abstract base class for encapsulation of geometries.
+// Geometries may register their vertex generation regions by name, so
+// that the generators resolve them to a handle once, at configuration
+// time, instead of selecting them by name for every event.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "GeometryBase.h"
+
+#include <G4Exception.hh>
+#include <G4Navigator.hh>
+#include <G4TransportationManager.hh>
+
+
+namespace nexus {
+
+  G4ThreeVector GeometryBase::GenerateVertex(const G4String& region) const
+  {
+    if (regions_.empty())
+      return G4ThreeVector(0., 0., 0.);
+
+    return (*GetRegion(region))();
+  }
+
+
+
+  GeometryBase::RegionHandle GeometryBase::GetRegion(const G4String& name) const
+  {
+    auto it = regions_.find(name);
+    if (it != regions_.end())
+      return &it->second;
+
+    if (!regions_.empty()) {
+      G4String msg = "Unknown vertex generation region " + name + "!";
+      G4Exception("[GeometryBase]", "GetRegion()", FatalException, msg.c_str());
+      return nullptr;
+    }
+
+    // Geometries that do not register their regions select them by
+    // name in GenerateVertex(). The generators of all threads may look
+    // them up at the same time, hence the lock.
+    std::lock_guard<std::mutex> lock(fwd_mutex_);
+    RegionSampler& sampler = fwd_regions_[name];
+    if (!sampler)
+      sampler = [this, name]() { return GenerateVertex(name); };
+
+    return &sampler;
+  }
+
+
+
+  G4Navigator* GeometryBase::GetNavigator()
+  {
+    // Created on first use, when the world volume is already known
+    // to the tracking navigator of the thread
+    static G4ThreadLocal G4Navigator* navigator = nullptr;
+
+    if (!navigator) {
+      navigator = new G4Navigator();
+      navigator->SetWorldVolume(G4TransportationManager::GetTransportationManager()
+                                ->GetNavigatorForTracking()->GetWorldVolume());
+    }
+
+    return navigator;
+  }
+
+
+
+  void GeometryBase::RegisterRegion(const G4String& name, RegionSampler sampler)
+  {
+    regions_[name] = sampler;
+  }
+
+
+
+  void GeometryBase::RegisterRegions(const std::vector<G4String>& names)
+  {
+    for (const G4String& name: names)
+      RegisterRegion(name, [this, name]() { return GenerateVertex(name); });
+  }
+
+
+
+  void GeometryBase::ImportRegions(const GeometryBase& geom,
+                                   std::function<G4ThreeVector(const G4ThreeVector&)> transform)
+  {
+    for (const auto& region: geom.regions_) {
+      RegionHandle handle = &region.second;
+      if (transform)
+        RegisterRegion(region.first,
+                       [handle, transform]() { return transform((*handle)()); });
+      else
+        RegisterRegion(region.first, region.second);
+    }
+  }
+
+} // end namespace nexus
@@ -2,6 +2,9 @@
 // nexus | GeometryBase.h
 //
 // This is an abstract base class for encapsulation of geometries.
+// Geometries may register their vertex generation regions by name, so
+// that the generators resolve them to a handle once, at configuration
+// time, instead of selecting them by name for every event.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -12,7 +15,13 @@
 #include <G4ThreeVector.hh>
 #include <CLHEP/Units/SystemOfUnits.h>
 
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
 class G4LogicalVolume;
+class G4Navigator;
 
 namespace nexus {
 
@@ -22,6 +31,19 @@ namespace nexus {
 
   class GeometryBase
   {
+  public:
+    /// Sampler of vertices within a region of the geometry
+    using RegionSampler = std::function<G4ThreeVector()>;
+    /// Handle of a vertex generation region, valid while the geometry exists
+    using RegionHandle = const RegionSampler*;
+
+    /// Box-shaped cell of the parallel world used for importance biasing
+    struct ImportanceCell {
+      G4String name;
+      G4ThreeVector half_length;
+      G4ThreeVector position; ///< Centre of the box in the frame of the geometry
+    };
+
   public:
     /// The volumes (solid, logical and physical) must be defined
     /// in this method, which will be invoked during the detector
@@ -31,15 +53,29 @@ namespace nexus {
     /// Returns the logical volume representing the geometry
     G4LogicalVolume* GetLogicalVolume() const;
 
-    /// Returns a point within a given region of the geometry
+    /// Returns a point within a given region of the geometry.
+    /// By default, it calls the sampler registered for the region.
     virtual G4ThreeVector GenerateVertex(const G4String&) const;
 
+    /// Returns the handle of a vertex generation region, so that
+    /// a point within it is generated with (*handle)(). A fatal
+    /// exception is raised if the geometry registers its regions and
+    /// the name is not among them. Otherwise, the handle forwards
+    /// to GenerateVertex() with the name of the region.
+    RegionHandle GetRegion(const G4String&) const;
+
     /// Returns a point within a region projecting from a
     /// given point backwards along a line.
     virtual G4ThreeVector ProjectToRegion(const G4String&,
 					  const G4ThreeVector&,
 					  const G4ThreeVector&) const;
 
+    /// Returns the cells in which the geometry is divided for
+    /// geometry-importance biasing, from the outermost to the innermost.
+    /// Each cell must contain the following ones. It is called once
+    /// the geometry is constructed and, by default, it returns no cells.
+    virtual std::vector<ImportanceCell> GetImportanceCells() const;
+
     /// Returns the span (maximum dimension) of the geometry
     G4double GetSpan();
 
@@ -78,6 +114,24 @@ namespace nexus {
     /// Sets the 3 dimensions of the geometry (x, y, z)
     void SetDimensions(G4ThreeVector dim);
 
+    /// Returns the navigator used to locate the vertices in the volumes
+    /// of the geometry. The geometries are shared by all threads, so each
+    /// thread creates a navigator of its own the first time it is needed.
+    static G4Navigator* GetNavigator();
+
+    /// Registers a vertex generation region. It must be done in the
+    /// constructor, before the generators look the regions up.
+    void RegisterRegion(const G4String& name, RegionSampler sampler);
+
+    /// Registers vertex generation regions that are selected
+    /// by name in the GenerateVertex() method of the geometry
+    void RegisterRegions(const std::vector<G4String>& names);
+
+    /// Registers the vertex generation regions of a sub-geometry,
+    /// applying an optional transformation to the vertices
+    void ImportRegions(const GeometryBase& geom,
+                       std::function<G4ThreeVector(const G4ThreeVector&)> transform = nullptr);
+
   private:
     /// Copy-constructor (hidden)
     GeometryBase(const GeometryBase&);
@@ -90,6 +144,10 @@ namespace nexus {
     G4ThreeVector dimensions_; ///< XYZ dimensions of a regular geometry
     G4double el_z_; ///< Starting point of EL generation in z
     G4ThreeVector coord_origin_; ///< Origin of coordinates of the mother volume
+
+    std::map<G4String, RegionSampler> regions_; ///< Registered vertex generation regions
+    mutable std::map<G4String, RegionSampler> fwd_regions_; ///< Handles forwarding to GenerateVertex()
+    mutable std::mutex fwd_mutex_;
   };
 
 
@@ -105,14 +163,14 @@ namespace nexus {
   inline void GeometryBase::SetLogicalVolume(G4LogicalVolume* lv)
   { logicVol_ = lv; }
 
-  inline G4ThreeVector GeometryBase::GenerateVertex(const G4String&) const
-  { return G4ThreeVector(0., 0., 0.); }
-
   inline G4ThreeVector GeometryBase::ProjectToRegion(const G4String&,
 						     const G4ThreeVector&,
 						     const G4ThreeVector&) const
   { return G4ThreeVector(0., 0., 0.); }
 
+  inline std::vector<GeometryBase::ImportanceCell> GeometryBase::GetImportanceCells() const
+  { return {}; }
+
   inline void GeometryBase::SetSpan(G4double s) { span_ = s; }
 
   inline G4double GeometryBase::GetSpan() { return span_; }
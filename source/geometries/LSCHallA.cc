@@ -46,6 +46,12 @@ namespace nexus {
     rock_thickn_cmd.SetRange("wall_thickness>=0.");
 
     msg_->DeclareProperty("rock_vis", visibility_, "Rock Visibility");
+
+    // Vertex generation regions
+    RegisterRegion("HALLA_INNER",
+                   [this]() { return hallA_vertex_gen_->GenerateVertex(INNER_SURF); });
+    RegisterRegion("HALLA_OUTER",
+                   [this]() { return hallA_outer_gen_->GenerateVertex(INNER_SURF); });
   }
 
   LSCHallA::~LSCHallA()
@@ -103,22 +109,6 @@ namespace nexus {
                                0, twopi, nullptr, hall_centre);
   }
 
-  G4ThreeVector LSCHallA::GenerateVertex(const G4String& region) const
-  {
-    G4ThreeVector vertex(0., 0., 0.);
-    if (region == "HALLA_INNER")
-      return hallA_vertex_gen_->GenerateVertex(INNER_SURF);
-    else if (region == "HALLA_OUTER")
-      return hallA_outer_gen_->GenerateVertex(INNER_SURF);
-    // Unknown region
-    else {
-      G4Exception("[LSCHallA]", "GenerateVertex()", FatalException,
-		  "Unknown Region!");
-    }
-
-    return vertex;
-  }
-
   G4ThreeVector LSCHallA::ProjectToRegion(const G4String& region,
 					  const G4ThreeVector& point,
 					  const G4ThreeVector& dir) const
@@ -27,9 +27,6 @@ namespace nexus {
     /// Destructor
     ~LSCHallA();
 
-    /// Generate a vertex within a given region of the geometry
-    G4ThreeVector GenerateVertex(const G4String& region) const;
-
     /// Returns a point within a region projecting from a
     /// given point backwards along a line.
     G4ThreeVector ProjectToRegion(const G4String& region,
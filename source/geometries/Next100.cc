@@ -13,6 +13,7 @@
 #include "Next100Ics.h"
 #include "Next100InnerElements.h"
 #include "FactoryBase.h"
+#include "StartupProfiler.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4Box.hh>
@@ -77,6 +78,31 @@ namespace nexus {
   // Inner Elements
   inner_elements_ = new Next100InnerElements(grid_thickness_);
 
+  // Vertex generation regions. Those of the components are
+  // shifted from the coordinates of the vessel to the world ones.
+  auto to_world = [this](const G4ThreeVector& vertex) { return vertex - coord_origin_; };
+  ImportRegions(*shielding_,      to_world);
+  ImportRegions(*vessel_,         to_world);
+  ImportRegions(*ics_,            to_world);
+  ImportRegions(*inner_elements_, to_world);
+
+  // AD_HOC does not need to be shifted because it is passed by the user
+  RegisterRegion("AD_HOC", [this]() { return specific_vertex_; });
+
+  // Lab walls
+  for (G4String region: {"HALLA_INNER", "HALLA_OUTER"}) {
+    RegionHandle walls = hallA_walls_->GetRegion(region);
+    RegisterRegion(region, [this, walls]() {
+      if (!lab_walls_)
+        G4Exception("[Next100]", "GenerateVertex()", FatalException,
+                    "This vertex generation region must be used with lab_walls == true!");
+      G4ThreeVector vertex = (*walls)();
+      while (vertex[1]<(-shielding_->GetHeight()/2.)){
+        vertex = (*walls)();}
+      return vertex - coord_origin_;
+    });
+  }
+
   }
 
 
@@ -98,7 +124,7 @@ namespace nexus {
     // on the outside.
     if (lab_walls_){
       // We want to simulate the walls (for muons in most cases).
-      hallA_walls_->Construct();
+      StartupProfiler::Measure("LSCHallA", [this]{ hallA_walls_->Construct(); });
       hallA_logic_ = hallA_walls_->GetLogicalVolume();
       G4double hallA_length = hallA_walls_->GetLSCHallALength();
       // Since the walls will be displaced need to make the
@@ -128,7 +154,7 @@ namespace nexus {
     vessel_->SetCoordOrigin(G4ThreeVector(fc_displ_x_,
                                           fc_displ_y_,
                                           0.));
-    vessel_->Construct();
+    StartupProfiler::Measure("Next100Vessel", [this]{ vessel_->Construct(); });
     G4LogicalVolume* vessel_logic = vessel_->GetLogicalVolume();
     G4LogicalVolume* vessel_internal_logic  =
       vessel_->GetInternalLogicalVolume();
@@ -141,7 +167,7 @@ namespace nexus {
 
     // SHIELDING
     shielding_->SetCoordOrigin(coord_origin_);
-    shielding_->Construct();
+    StartupProfiler::Measure("Next100Shielding", [this]{ shielding_->Construct(); });
     G4LogicalVolume* shielding_logic     = shielding_->GetLogicalVolume();
     G4LogicalVolume* shielding_air_logic = shielding_->GetAirLogicalVolume();
 
@@ -157,7 +183,7 @@ namespace nexus {
     inner_elements_->SetCoordOrigin(coord_origin_);
     inner_elements_->SetELtoSapphireWDWdistance(gate_sapphire_wdw_distance_);
     inner_elements_->SetELtoTPdistance         (gate_tracking_plane_distance_);
-    inner_elements_->Construct();
+    StartupProfiler::Measure("Next100InnerElements", [this]{ inner_elements_->Construct(); });
 
     // INNER COPPER SHIELDING
     ics_->SetLogicalVolume(vessel_internal_logic);
@@ -165,7 +191,7 @@ namespace nexus {
     ics_->SetELtoSapphireWDWdistance(gate_sapphire_wdw_distance_);
     ics_->SetELtoTPdistance         (gate_tracking_plane_distance_);
     ics_->SetPortZpositions(vessel_->GetPortZpositions());
-    ics_->Construct();
+    StartupProfiler::Measure("Next100Ics", [this]{ ics_->Construct(); });
 
     if (lab_walls_){
       G4ThreeVector castle_pos(0., hallA_walls_->GetLSCHallACastleY(),
@@ -205,89 +231,6 @@ namespace nexus {
   }
 
 
-  G4ThreeVector Next100::GenerateVertex(const G4String& region) const
-  {
-    G4ThreeVector vertex(0.,0.,0.);
-
-    // Shielding regions
-    if ((region == "SHIELDING_LEAD")  ||
-        (region == "SHIELDING_STEEL") ||
-        (region == "INNER_AIR") ||
-        (region == "EXTERNAL") ||
-        (region == "SHIELDING_STRUCT") ||
-        (region == "PEDESTAL") ||
-        (region == "BUBBLE_SEAL") ||
-        (region == "EDPM_SEAL")) {
-      vertex = shielding_->GenerateVertex(region);
-    }
-
-    // Vessel regions
-    else if ((region == "VESSEL")  ||
-             (region == "PORT_1a") ||
-             (region == "PORT_2a") ||
-             (region == "PORT_1b") ||
-             (region == "PORT_2b")) {
-      vertex = vessel_->GenerateVertex(region);
-    }
-
-    // Inner copper shielding
-    else if (region == "ICS"){
-      vertex = ics_->GenerateVertex(region);
-    }
-
-    // Inner elements (photosensors' planes and field cage)
-    else if ((region == "CENTER") ||
-             (region == "ACTIVE") ||
-             (region == "CATHODE_RING") ||
-             (region == "BUFFER") ||
-             (region == "XENON") ||
-             (region == "LIGHT_TUBE") ||
-             (region == "HDPE_TUBE") ||
-             (region == "S2_PMT_LT") ||
-             (region == "S2_SIPM_PSF") ||
-             (region == "EP_COPPER_PLATE") ||
-             (region == "SAPPHIRE_WINDOW") ||
-             (region == "OPTICAL_PAD") ||
-             (region == "PMT_BODY") ||
-             (region == "PMT") ||
-             (region == "PMT_BASE") ||
-             (region == "TP_COPPER_PLATE") ||
-             (region == "SIPM_BOARD") ||
-             (region == "DB_PLUG") ||
-             (region == "FIELD_RING") ||
-             (region == "GATE_RING") ||
-             (region == "ANODE_RING") ||
-             (region == "RING_HOLDER")) {
-      vertex = inner_elements_->GenerateVertex(region);
-    }
-
-    else if (region == "AD_HOC") {
-      // AD_HOC does not need to be shifted because it is passed by the user
-      vertex = specific_vertex_;
-      return vertex;
-    }
-
-    // Lab walls
-    else if ((region == "HALLA_INNER") || (region == "HALLA_OUTER")){
-      if (!lab_walls_)
-        G4Exception("[Next100]", "GenerateVertex()", FatalException,
-                    "This vertex generation region must be used with lab_walls == true!");
-      vertex = hallA_walls_->GenerateVertex(region);
-      while (vertex[1]<(-shielding_->GetHeight()/2.)){
-        vertex = hallA_walls_->GenerateVertex(region);}
-    }
-
-    else {
-      G4Exception("[Next100]", "GenerateVertex()", FatalException,
-		  "Unknown vertex generation region!");
-    }
-
-    vertex = vertex - coord_origin_;
-
-    return vertex;
-  }
-
-
   G4ThreeVector Next100::ProjectToRegion(const G4String& region,
 					 const G4ThreeVector& point,
 					 const G4ThreeVector& dir) const
@@ -309,4 +252,16 @@ namespace nexus {
     return vertex - coord_origin_;
   }
 
+
+  std::vector<GeometryBase::ImportanceCell> Next100::GetImportanceCells() const
+  {
+    // The lead box is placed at the same world position
+    // with and without the lab walls
+    std::vector<ImportanceCell> cells = shielding_->GetImportanceCells();
+    for (ImportanceCell& cell: cells)
+      cell.position -= coord_origin_;
+
+    return cells;
+  }
+
 } //end namespace nexus
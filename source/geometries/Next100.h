@@ -33,15 +33,15 @@ namespace nexus {
     /// Destructor
     ~Next100();
 
-    /// Generate a vertex within a given region of the geometry
-    G4ThreeVector GenerateVertex(const G4String& region) const;
-
     /// Returns a point within a region projecting from a
     /// given point backwards along a line.
     G4ThreeVector ProjectToRegion(const G4String& region,
 				  const G4ThreeVector& point,
 				  const G4ThreeVector& dir) const;
 
+    /// Importance biasing cells of the shielding, in world coordinates
+    std::vector<ImportanceCell> GetImportanceCells() const;
+
 
   private:
     void BuildLab();
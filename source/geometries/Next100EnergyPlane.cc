@@ -11,8 +11,10 @@
 #include "OpticalMaterialProperties.h"
 #include "Visibilities.h"
 #include "CylinderPointSampler.h"
+#include "AcceptanceMapSampler.h"
 
 #include <G4GenericMessenger.hh>
+#include <G4Navigator.hh>
 #include <G4PVPlacement.hh>
 #include <G4VisAttributes.hh>
 #include <G4Material.hh>
@@ -24,7 +26,6 @@
 #include <G4LogicalSkinSurface.hh>
 #include <G4NistManager.hh>
 #include <G4VPhysicalVolume.hh>
-#include <G4TransportationManager.hh>
 #include <Randomize.hh>
 
 namespace nexus {
@@ -80,10 +81,6 @@ namespace nexus {
     ///    in the gas volume, inside the holes excavated in the copper.
 
 
-    /// Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ =
-      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/Next100/",
 				  "Control commands of geometry Next100.");
@@ -92,6 +89,10 @@ namespace nexus {
 
     /// The PMT
     pmt_ = new PmtR11410();
+
+    /// Vertex generation regions
+    RegisterRegions({"EP_COPPER_PLATE", "SAPPHIRE_WINDOW", "OPTICAL_PAD",
+                     "PMT", "PMT_BODY", "PMT_BASE"});
   }
 
 
@@ -419,6 +420,10 @@ namespace nexus {
                                    full_copper_length/2.,
                                    0., twopi, nullptr,
                                    G4ThreeVector(0., 0., full_copper_posz));
+    copper_map_ =
+      new AcceptanceMapSampler([this](){ return copper_gen_->GenerateVertex(VOLUME); },
+                               VolumeAcceptance(GetNavigator, {"EP_COPPER_PLATE"},
+                                                GetCoordOrigin()));
 
     sapphire_window_gen_ = new CylinderPointSampler(sapphire_window_phys);
     optical_pad_gen_     = new CylinderPointSampler(optical_pad_phys);
@@ -430,6 +435,7 @@ namespace nexus {
   Next100EnergyPlane::~Next100EnergyPlane()
   {
     delete copper_gen_;
+    delete copper_map_;
     delete sapphire_window_gen_;
     delete optical_pad_gen_;
     delete pmt_base_gen_;
@@ -443,13 +449,7 @@ namespace nexus {
     // Copper plate
     // As it is full of holes, let's get sure vertices are in the right volume
     if (region == "EP_COPPER_PLATE") {
-      G4VPhysicalVolume *VertexVolume;
-      do {
-        vertex = copper_gen_->GenerateVertex(VOLUME);
-        G4ThreeVector glob_vtx(vertex);
-        glob_vtx = glob_vtx - GetCoordOrigin();
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-      } while (VertexVolume->GetName() != region);
+      vertex = copper_map_->GenerateVertex();
     }
 
     // Sapphire windows
@@ -464,7 +464,7 @@ namespace nexus {
         vertex.setZ(vertex.z() + z_translation);
         G4ThreeVector glob_vtx(vertex);
         glob_vtx = glob_vtx - GetCoordOrigin();
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+        VertexVolume = GetNavigator()->LocateGlobalPointAndSetup(glob_vtx, 0, false);
       } while (VertexVolume->GetName() != region);
     }
 
@@ -10,7 +10,6 @@
 #define NEXT100_ENERGY_PLANE_H
 
 #include <vector>
-#include <G4Navigator.hh>
 #include <G4RotationMatrix.hh>
 
 #include "PmtR11410.h"
@@ -25,6 +24,7 @@ namespace nexus {
   /// This is a class to place all the components of the energy plane
 
   class CylinderPointSampler;
+  class AcceptanceMapSampler;
 
   class Next100EnergyPlane: public GeometryBase
   {
@@ -79,9 +79,6 @@ namespace nexus {
     // Visibility of the energy plane
     G4bool visibility_, verbosity_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
@@ -102,6 +99,7 @@ namespace nexus {
     CylinderPointSampler* sapphire_window_gen_;
     CylinderPointSampler* optical_pad_gen_;
     CylinderPointSampler* pmt_base_gen_;
+    AcceptanceMapSampler* copper_map_; ///< Acceptance map of copper_gen_
 
   };
 
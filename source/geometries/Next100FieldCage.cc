@@ -16,9 +16,10 @@
 #include "XenonProperties.h"
 #include "CylinderPointSampler.h"
 #include "BoxPointSampler.h"
+#include "AcceptanceMapSampler.h"
 #include "HexagonMeshTools.h"
+#include "MeshTransmissionTable.h"
 
-#include <G4Navigator.hh>
 #include <G4SystemOfUnits.hh>
 #include <G4PhysicalConstants.hh>
 #include <G4GenericMessenger.hh>
@@ -39,7 +40,7 @@
 #include <G4UserLimits.hh>
 #include <G4SDManager.hh>
 #include <G4UnitsTable.hh>
-#include <G4TransportationManager.hh>
+#include <G4Region.hh>
 
 #include <cassert>
 
@@ -109,6 +110,7 @@ Next100FieldCage::Next100FieldCage(G4double grid_thickn):
   grid_visibility_ (0),
   verbosity_(0),
   use_dielectric_grid_(0),
+  use_fast_mesh_(false),
   // EL gap generation disk parameters
   el_gap_slice_min_(0.), el_gap_slice_max_(1.),
   sipm_pitch_(0),
@@ -118,10 +120,6 @@ Next100FieldCage::Next100FieldCage(G4double grid_thickn):
   new G4UnitDefinition("kilovolt/cm","kV/cm","Electric field", kilovolt/cm);
   new G4UnitDefinition("mm/sqrt(cm)","mm/sqrt(cm)","Diffusion", mm/sqrt(cm));
 
-  /// Initializing the geometry navigator (used in vertex generation)
-  geom_navigator_ =
-    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
   /// Messenger
   msg_ = new G4GenericMessenger(this, "/Geometry/Next100/",
                                 "Control commands of geometry Next100.");
@@ -130,6 +128,8 @@ Next100FieldCage::Next100FieldCage(G4double grid_thickn):
   msg_->DeclareProperty("field_cage_verbosity", verbosity_, "Field Cage Verbosity");
 
   msg_->DeclareProperty("use_dielectric_grid", use_dielectric_grid_, "Switch on Fake Grids");
+  msg_->DeclareProperty("use_fast_mesh", use_fast_mesh_,
+                        "Replace the holes of the hexagonal meshes with a fast optical model");
 
   G4GenericMessenger::Command& drift_transv_diff_cmd =
     msg_->DeclareProperty("drift_transv_diff", drift_transv_diff_,
@@ -190,6 +190,22 @@ Next100FieldCage::Next100FieldCage(G4double grid_thickn):
 
   msg_->DeclareProperty("photoe_prob", photoe_prob_,
                         "Probability of photon to ie- conversion");
+
+  /// Vertex generation regions
+  RegisterRegion("CENTER", [this]() {
+    return G4ThreeVector(GetCoordOrigin().x(), GetCoordOrigin().y(), active_zpos_); });
+  RegisterRegion("ACTIVE",       [this]() { return active_map_->GenerateVertex(); });
+  RegisterRegion("CATHODE_RING", [this]() { return cathode_gen_->GenerateVertex(VOLUME); });
+  RegisterRegion("BUFFER",       [this]() { return buffer_map_->GenerateVertex(); });
+  RegisterRegion("XENON",        [this]() { return xenon_map_->GenerateVertex(); });
+  RegisterRegion("LIGHT_TUBE",   [this]() { return teflon_map_->GenerateVertex(); });
+  RegisterRegion("HDPE_TUBE",    [this]() { return hdpe_gen_->GenerateVertex(VOLUME); });
+  RegisterRegion("S2_PMT_LT",    [this]() { return el_gap_pmt_gen_->GenerateVertex(VOLUME); });
+  RegisterRegion("S2_SIPM_PSF",  [this]() { return el_gap_sipm_gen_->GenerateVertex(INSIDE); });
+  RegisterRegion("FIELD_RING",   [this]() { return ring_map_->GenerateVertex(); });
+  RegisterRegion("GATE_RING",    [this]() { return gate_gen_->GenerateVertex(VOLUME); });
+  RegisterRegion("ANODE_RING",   [this]() { return anode_gen_->GenerateVertex(VOLUME); });
+  RegisterRegion("RING_HOLDER",  [this]() { return holder_map_->GenerateVertex(); });
 }
 
 
@@ -244,6 +260,29 @@ void Next100FieldCage::Construct()
   BuildELRegion();
   BuildLightTube();
   BuildFieldCage();
+
+  /// Vertex generation in regions that do not fill the volume
+  /// of their point samplers
+  active_map_ = new AcceptanceMapSampler
+    ([this](){ return active_gen_->GenerateVertex(VOLUME); },
+     VolumeAcceptance(GetNavigator, {"ACTIVE"}, GetCoordOrigin()));
+  buffer_map_ = new AcceptanceMapSampler
+    ([this](){ return buffer_gen_->GenerateVertex(VOLUME); },
+     VolumeAcceptance(GetNavigator, {"BUFFER"}, GetCoordOrigin()));
+  xenon_map_ = new AcceptanceMapSampler
+    ([this](){ return xenon_gen_->GenerateVertex(VOLUME); },
+     VolumeAcceptance(GetNavigator, {"ACTIVE", "BUFFER", "EL_GAP"},
+                      GetCoordOrigin()));
+  teflon_map_ = new AcceptanceMapSampler
+    ([this](){ return teflon_gen_->GenerateVertex(VOLUME); },
+     VolumeAcceptance(GetNavigator, {"LIGHT_TUBE_DRIFT", "LIGHT_TUBE_BUFFER"},
+                      GetCoordOrigin()));
+  ring_map_ = new AcceptanceMapSampler
+    ([this](){ return ring_gen_->GenerateVertex(VOLUME); },
+     VolumeAcceptance(GetNavigator, {"FIELD_RING"}, GetCoordOrigin()));
+  holder_map_ = new AcceptanceMapSampler
+    ([this](){ return holder_gen_->GenerateVertex(VOLUME); },
+     VolumeAcceptance(GetNavigator, {"STAVE"}, GetCoordOrigin()));
 }
 
 
@@ -431,11 +470,17 @@ void Next100FieldCage::BuildCathode()
       G4Tubs* grid_solid = new G4Tubs("CATHODE_GRID", 0., cathode_ext_diam_/2.0 , grid_thickn_/2., 0., twopi);
       cathode_grid_logic = new G4LogicalVolume(grid_solid, steel_, "CATHODE_MESH_LOGIC");
 
-      // Define a hexagonal prism
-      G4ExtrudedSolid* hex_prism = CreateHexagon(grid_thickn_/2.0, hex_circumradius);
-      cathode_hex_logic  = new G4LogicalVolume(hex_prism, gas_, "MESH_HEX_GAS");
+      if (use_fast_mesh_) {
+        cathode_hex_logic = BuildFastMesh("CATHODE_MESH", cathode_mesh_diam_,
+                                          cathode_int_diam_, cathode_grid_logic);
+      }
+      else {
+        // Define a hexagonal prism
+        G4ExtrudedSolid* hex_prism = CreateHexagon(grid_thickn_/2.0, hex_circumradius);
+        cathode_hex_logic  = new G4LogicalVolume(hex_prism, gas_, "MESH_HEX_GAS");
 
-      PlaceHexagons(n_hex, cathode_mesh_diam_, grid_thickn_, cathode_grid_logic, cathode_hex_logic, cathode_int_diam_);
+        PlaceHexagons(n_hex, cathode_mesh_diam_, grid_thickn_, cathode_grid_logic, cathode_hex_logic, cathode_int_diam_);
+      }
 
       new G4PVPlacement(0, G4ThreeVector(GetCoordOrigin().x(),
                                          GetCoordOrigin().y(), cathode_grid_zpos),
@@ -675,12 +720,18 @@ void Next100FieldCage::BuildELRegion()
     G4Tubs* grid_solid = new G4Tubs("EL_GRID", 0., gate_ext_diam_/2.0 , grid_thickn_/2., 0., twopi);
     el_grid_logic = new G4LogicalVolume(grid_solid, steel_, "EL_GRID");
 
-    // Define a hexagonal prism
-    G4ExtrudedSolid* hex_prism = CreateHexagon(grid_thickn_/2.0, hex_circumradius);
-    el_hex_logic  = new G4LogicalVolume(hex_prism, gas_, "MESH_HEX_GAS");
+    if (use_fast_mesh_) {
+      el_hex_logic = BuildFastMesh("EL_MESH", el_mesh_diam_,
+                                   gate_int_diam_, el_grid_logic);
+    }
+    else {
+      // Define a hexagonal prism
+      G4ExtrudedSolid* hex_prism = CreateHexagon(grid_thickn_/2.0, hex_circumradius);
+      el_hex_logic  = new G4LogicalVolume(hex_prism, gas_, "MESH_HEX_GAS");
 
-    // Place GXe hexagons in the disk to make the mesh
-    PlaceHexagons(n_hex, el_mesh_diam_, grid_thickn_, el_grid_logic, el_hex_logic, gate_int_diam_);
+      // Place GXe hexagons in the disk to make the mesh
+      PlaceHexagons(n_hex, el_mesh_diam_, grid_thickn_, el_grid_logic, el_hex_logic, gate_int_diam_);
+    }
 
     // Add optical surface
     G4OpticalSurface* gas_mesh_opsur = new G4OpticalSurface("GAS_EL_MESH_OPSURF");
@@ -728,6 +779,11 @@ void Next100FieldCage::BuildELRegion()
     G4Region* el_region = new G4Region("EL_REGION");
     el_region->SetUserInformation(el_field);
     el_region->AddRootLogicalVolume(el_gap_logic);
+
+    // The envelopes of the fast meshes are regions of their own,
+    // but the ionization electrons must keep drifting through them
+    if (use_fast_mesh_ && !use_dielectric_grid_)
+      el_hex_logic->GetRegion()->SetUserInformation(el_field);
   }
 
   // Vertex generator
@@ -806,6 +862,27 @@ void Next100FieldCage::BuildELRegion()
 }
 
 
+G4LogicalVolume* Next100FieldCage::BuildFastMesh(const G4String& name, G4double mesh_diam,
+                                                 G4double int_diam, G4LogicalVolume* grid_logic)
+{
+  // The holes of the mesh are replaced by a single gas disk, the envelope
+  // of the fast optical model, which is a region with the transmission
+  // table of the mesh attached to it
+  G4Tubs* mesh_solid = new G4Tubs(name, 0., int_diam/2., grid_thickn_/2., 0., twopi);
+  G4LogicalVolume* mesh_logic = new G4LogicalVolume(mesh_solid, gas_, name);
+
+  new G4PVPlacement(0, G4ThreeVector(), mesh_logic, name, grid_logic, false, 0, false);
+
+  G4Region* mesh_region = new G4Region(name);
+  mesh_region->AddRootLogicalVolume(mesh_logic);
+
+  MeshTransmissionTable::Register(mesh_region,
+    new MeshTransmissionTable(mesh_diam, grid_thickn_, opticalprops::Steel()));
+
+  return mesh_logic;
+}
+
+
 void Next100FieldCage::BuildLightTube()
 {
   /// DRIFT PART ///
@@ -1064,119 +1141,12 @@ Next100FieldCage::~Next100FieldCage()
   delete gate_gen_;
   delete anode_gen_;
   delete holder_gen_;
-}
-
-
-G4ThreeVector Next100FieldCage::GenerateVertex(const G4String& region) const
-{
-  G4ThreeVector vertex(0., 0., 0.);
-
-  if (region == "CENTER") {
-    vertex = G4ThreeVector(GetCoordOrigin().x(), GetCoordOrigin().y(),
-                           active_zpos_);
-  }
-
-  else if (region == "ACTIVE") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = active_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
-  }
-
-  else if (region == "CATHODE_RING") {
-    vertex = cathode_gen_->GenerateVertex(VOLUME);
-  }
-
-  else if (region == "BUFFER") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = buffer_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
-  }
-
-  else if (region == "XENON") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = xenon_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (
-    VertexVolume->GetName() != "ACTIVE" &&
-    VertexVolume->GetName() != "BUFFER" &&
-    VertexVolume->GetName() != "EL_GAP");
-  }
-
-  else if (region == "LIGHT_TUBE") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = teflon_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (
-    VertexVolume->GetName() != "LIGHT_TUBE_DRIFT" &&
-    VertexVolume->GetName() != "LIGHT_TUBE_BUFFER" );
-  }
-
-  else if (region == "HDPE_TUBE") {
-    vertex = hdpe_gen_->GenerateVertex(VOLUME);
-  }
-
-  else if (region == "S2_PMT_LT") {
-    vertex = el_gap_pmt_gen_->GenerateVertex(VOLUME);
-  }
-
-  else if (region == "S2_SIPM_PSF") {
-    vertex = el_gap_sipm_gen_->GenerateVertex(INSIDE);
-  }
-
-  else if (region == "FIELD_RING") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = ring_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
-  }
-
-  else if (region == "GATE_RING") {
-    vertex = gate_gen_->GenerateVertex(VOLUME);
-  }
-
-  else if (region == "ANODE_RING") {
-    vertex = anode_gen_->GenerateVertex(VOLUME);
-  }
-
-  else if (region == "RING_HOLDER"){
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = holder_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != "STAVE");
- }
-
-  else {
-    G4Exception("[Next100FieldCage]", "GenerateVertex()", FatalException,
-    "Unknown vertex generation region!");
-  }
-
-  return vertex;
+  delete active_map_;
+  delete buffer_map_;
+  delete xenon_map_;
+  delete teflon_map_;
+  delete ring_map_;
+  delete holder_map_;
 }
 
 
@@ -16,12 +16,12 @@ class G4Material;
 class G4LogicalVolume;
 class G4VPhysicalVolume;
 class G4GenericMessenger;
-class G4Navigator;
 
 namespace nexus {
 
   class CylinderPointSampler;
   class BoxPointSampler;
+  class AcceptanceMapSampler;
 
 
   class Next100FieldCage: public GeometryBase
@@ -30,7 +30,6 @@ namespace nexus {
     Next100FieldCage(G4double grid_thickn);
     ~Next100FieldCage();
     void Construct() override;
-    G4ThreeVector GenerateVertex(const G4String& region) const override;
 
     G4ThreeVector GetActivePosition() const;
 
@@ -47,6 +46,8 @@ namespace nexus {
     void BuildELRegion();
     void BuildLightTube();
     void BuildFieldCage();
+    G4LogicalVolume* BuildFastMesh(const G4String& name, G4double mesh_diam,
+                                   G4double int_diam, G4LogicalVolume* grid_logic);
 
     // Dimensions
     G4double gate_sapphire_wdw_dist_;
@@ -87,6 +88,8 @@ namespace nexus {
 
     // Use fake mesh
     G4bool use_dielectric_grid_;
+    // Use the fast optical model of the hexagonal meshes
+    G4bool use_fast_mesh_;
 
     // Fraction of EL gap in which to generate points. e.g (0, 0.5)
     // would generate points in the first half of the EL gap
@@ -113,12 +116,17 @@ namespace nexus {
     CylinderPointSampler* anode_gen_;
     CylinderPointSampler* holder_gen_;
 
+    // Acceptance maps of the generators of regions defined by rejection
+    AcceptanceMapSampler* active_map_;
+    AcceptanceMapSampler* buffer_map_;
+    AcceptanceMapSampler* xenon_map_;
+    AcceptanceMapSampler* teflon_map_;
+    AcceptanceMapSampler* ring_map_;
+    AcceptanceMapSampler* holder_map_;
+
     // SiPM pitch for ELgap vertex generation
     G4double sipm_pitch_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
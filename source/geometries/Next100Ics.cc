@@ -10,6 +10,7 @@
 #include "MaterialsList.h"
 #include "Visibilities.h"
 #include "CylinderPointSampler.h"
+#include "AcceptanceMapSampler.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4SubtractionSolid.hh>
@@ -21,7 +22,6 @@
 #include <G4NistManager.hh>
 #include <G4Material.hh>
 #include <Randomize.hh>
-#include <G4TransportationManager.hh>
 
 
 namespace nexus {
@@ -36,13 +36,12 @@ namespace nexus {
     visibility_ (0)
   {
 
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/Next100/", "Control commands of geometry Next100.");
     msg_->DeclareProperty("ics_vis", visibility_, "ICS Visibility");
 
+    /// Vertex generation regions
+    RegisterRegion("ICS", [this]() { return ics_map_->GenerateVertex(); });
   }
 
   void Next100Ics::SetLogicalVolume(G4LogicalVolume* mother_logic)
@@ -196,31 +195,16 @@ namespace nexus {
       new CylinderPointSampler(in_rad_, in_rad_ + thickness_, length/2.,
                                0.*deg, 360.*deg,
                                0, G4ThreeVector(0., 0., ics_z_pos));
+    ics_map_ =
+      new AcceptanceMapSampler([this](){ return ics_gen_->GenerateVertex(VOLUME); },
+                               VolumeAcceptance(GetNavigator, {"ICS"}, GetCoordOrigin()));
   }
 
 
   Next100Ics::~Next100Ics()
   {
     delete ics_gen_;
-  }
-
-
-  G4ThreeVector Next100Ics::GenerateVertex(const G4String& region) const
-  {
-    G4ThreeVector vertex(0., 0., 0.);
-
-    if (region=="ICS"){
-      G4VPhysicalVolume* VertexVolume;
-      do {
-        vertex = ics_gen_->GenerateVertex(VOLUME);
-
-        G4ThreeVector glob_vtx(vertex);
-        glob_vtx = glob_vtx - GetCoordOrigin();
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-      } while (VertexVolume->GetName() != "ICS");
-    }
-
-    return vertex;
+    delete ics_map_;
   }
 
 
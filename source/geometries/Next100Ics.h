@@ -11,7 +11,6 @@
 
 #include "GeometryBase.h"
 
-#include <G4Navigator.hh>
 
 class G4GenericMessenger;
 
@@ -19,6 +18,7 @@ class G4GenericMessenger;
 namespace nexus {
 
   class CylinderPointSampler;
+  class AcceptanceMapSampler;
 
   class Next100Ics: public GeometryBase
   {
@@ -36,9 +36,6 @@ namespace nexus {
     void SetELtoSapphireWDWdistance(G4double);
     void SetPortZpositions(G4double port_positions[]);
 
-    /// Generate a vertex within a given region of the geometry
-    G4ThreeVector GenerateVertex(const G4String& region) const;
-
     /// Builder
     void Construct();
 
@@ -57,9 +54,7 @@ namespace nexus {
 
     // Vertex generator
     CylinderPointSampler* ics_gen_;
-
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
+    AcceptanceMapSampler* ics_map_; ///< Acceptance map of ics_gen_
 
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
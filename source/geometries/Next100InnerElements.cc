@@ -11,6 +11,7 @@
 #include "Next100FieldCage.h"
 #include "Next100EnergyPlane.h"
 #include "Next100TrackingPlane.h"
+#include "StartupProfiler.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4LogicalVolume.hh>
@@ -38,6 +39,11 @@ namespace nexus {
     // Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/Next100/",
                                   "Control commands of geometry Next100.");
+
+    // Vertex generation regions
+    ImportRegions(*field_cage_);
+    ImportRegions(*energy_plane_);
+    ImportRegions(*tracking_plane_);
   }
 
 
@@ -67,13 +73,13 @@ namespace nexus {
     field_cage_->SetCoordOrigin(coord_origin);
     field_cage_->SetELtoSapphireWDWdistance(gate_sapphire_wdw_distance_);
     field_cage_->SetSiPMPitch(tracking_plane_->GetSiPMPitch());
-    field_cage_->Construct();
+    StartupProfiler::Measure("Next100FieldCage", [this]{ field_cage_->Construct(); });
 
     // Energy Plane
     energy_plane_->SetMotherLogicalVolume(mother_logic_);
     energy_plane_->SetCoordOrigin(coord_origin);
     energy_plane_->SetELtoSapphireWDWdistance(gate_sapphire_wdw_distance_);
-    energy_plane_->Construct();
+    StartupProfiler::Measure("Next100EnergyPlane", [this]{ energy_plane_->Construct(); });
 
     pmt_pos_ = energy_plane_->GetPMTPosInGas();
 
@@ -81,7 +87,7 @@ namespace nexus {
     tracking_plane_->SetMotherPhysicalVolume(mother_phys_);
     tracking_plane_->SetCoordOrigin(coord_origin);
     tracking_plane_->SetELtoTPdistance(gate_tracking_plane_distance_);
-    tracking_plane_->Construct();
+    StartupProfiler::Measure("Next100TrackingPlane", [this]{ tracking_plane_->Construct(); });
 
     tracking_plane_->GetSiPMPosInGas(sipm_pos_);
   }
@@ -94,48 +100,4 @@ namespace nexus {
     delete tracking_plane_;
   }
 
-
-  G4ThreeVector Next100InnerElements::GenerateVertex(const G4String& region) const
-  {
-    G4ThreeVector vertex(0.,0.,0.);
-
-    // Field Cage regions
-    if ((region == "CENTER") ||
-        (region == "ACTIVE") ||
-        (region == "CATHODE_RING") ||
-        (region == "BUFFER") ||
-        (region == "XENON")  ||
-        (region == "S2_PMT_LT") ||
-        (region == "S2_SIPM_PSF") ||
-        (region == "LIGHT_TUBE") ||
-        (region == "HDPE_TUBE") ||
-        (region == "FIELD_RING") ||
-        (region == "GATE_RING") ||
-        (region == "ANODE_RING") ||
-        (region == "RING_HOLDER")) {
-      vertex = field_cage_->GenerateVertex(region);
-    }
-    // Energy Plane regions
-    else if ((region == "EP_COPPER_PLATE") ||
-             (region == "SAPPHIRE_WINDOW") ||
-             (region == "OPTICAL_PAD") ||
-             (region == "PMT") ||
-             (region == "PMT_BODY") ||
-             (region == "PMT_BASE")) {
-      vertex = energy_plane_->GenerateVertex(region);
-    }
-    // Tracking Plane regions
-    else if ((region == "TP_COPPER_PLATE") ||
-             (region == "SIPM_BOARD") ||
-             (region == "DB_PLUG")) {
-      vertex = tracking_plane_->GenerateVertex(region);
-    }
-    else {
-      G4Exception("[Next100InnerElements]", "GenerateVertex()", FatalException,
-        "Unknown vertex generation region!");
-    }
-
-    return vertex;
-  }
-
 } // end namespace nexus
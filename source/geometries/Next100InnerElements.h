@@ -52,9 +52,6 @@ namespace nexus {
     /// Return the positions of the PMTs in their mother volume (gas)
     std::vector<G4ThreeVector> GetPMTPosInGas() const;
 
-    /// Generate a vertex within a given region of the geometry
-    G4ThreeVector GenerateVertex(const G4String& region) const;
-
     /// Builder
     void Construct();
 
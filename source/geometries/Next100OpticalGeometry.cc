@@ -74,6 +74,12 @@ namespace nexus {
 
 
     inner_elements_ = new Next100InnerElements(grid_thickness_);
+
+    // Vertex generation regions
+    ImportRegions(*inner_elements_,
+                  [this](const G4ThreeVector& vertex) { return vertex - coord_origin_; });
+    // AD_HOC does not need to be shifted because it is passed by the user
+    RegisterRegion("AD_HOC", [this]() { return specific_vertex_; });
   }
 
 
@@ -154,22 +160,4 @@ namespace nexus {
 
   }
 
-
-  G4ThreeVector Next100OpticalGeometry::GenerateVertex(const G4String& region) const
-  {
-    G4ThreeVector vertex(0.,0.,0.);
-    if (region == "AD_HOC") {
-      // AD_HOC does not need to be shifted because it is passed by the user
-      vertex = specific_vertex_;
-      return vertex;
-    }
-    else {
-      vertex = inner_elements_->GenerateVertex(region);
-    }
-
-    vertex = vertex - coord_origin_;
-    return vertex;
-  }
-
-
 } // end namespace nexus
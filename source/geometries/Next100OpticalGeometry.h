@@ -30,9 +30,6 @@ namespace nexus {
     /// Destructor
     ~Next100OpticalGeometry();
 
-    /// Returns a vertex in a region of the geometry
-    G4ThreeVector GenerateVertex(const G4String& region) const;
-
     /// Builder
     void Construct();
 
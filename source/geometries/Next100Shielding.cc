@@ -10,6 +10,7 @@
 #include "MaterialsList.h"
 #include "Visibilities.h"
 #include "BoxPointSampler.h"
+#include "AcceptanceMapSampler.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4SubtractionSolid.hh>
@@ -22,7 +23,6 @@
 #include <G4NistManager.hh>
 #include <G4Material.hh>
 #include <Randomize.hh>
-#include <G4TransportationManager.hh>
 #include <G4RotationMatrix.hh>
 #include <G4UserLimits.hh>
 
@@ -66,7 +66,8 @@ namespace nexus {
     edpm_seal_thickn_   {1. * mm},
 
     visibility_ {0},
-    verbosity_{false}
+    verbosity_{false},
+    importance_slices_{4}
 
   {
     // The shielding is made of two boxes.
@@ -83,9 +84,15 @@ namespace nexus {
     msg_->DeclareProperty("shielding_vis", visibility_, "Shielding Visibility");
     msg_->DeclareProperty("shielding_verbosity", verbosity_, "Verbosity");
 
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+    G4GenericMessenger::Command& slices_cmd =
+      msg_->DeclareProperty("shielding_importance_slices", importance_slices_,
+                            "Number of importance biasing cells in the lead.");
+    slices_cmd.SetParameterName("shielding_importance_slices", false);
+    slices_cmd.SetRange("shielding_importance_slices>0");
 
+    // Vertex generation regions
+    RegisterRegions({"SHIELDING_LEAD", "SHIELDING_STEEL", "INNER_AIR", "EXTERNAL",
+                     "SHIELDING_STRUCT", "PEDESTAL", "BUBBLE_SEAL", "EDPM_SEAL"});
   }
 
 
@@ -419,6 +426,19 @@ namespace nexus {
     inner_air_gen_ = new BoxPointSampler(shield_x_/2., shield_y_/2., shield_z_/2., 0,
                                          G4ThreeVector(0., 0., 0.), 0);
 
+    lead_map_ =
+      new AcceptanceMapSampler([this](){ return lead_gen_->GenerateVertex(VOLUME); },
+                               VolumeAcceptance(GetNavigator, {"LEAD_BOX"},
+                                                GetCoordOrigin()));
+    steel_map_ =
+      new AcceptanceMapSampler([this](){ return steel_gen_->GenerateVertex(VOLUME); },
+                               VolumeAcceptance(GetNavigator, {"STEEL_BOX"},
+                                                GetCoordOrigin()));
+    inner_air_map_ =
+      new AcceptanceMapSampler([this](){ return inner_air_gen_->GenerateVertex(INSIDE); },
+                               VolumeAcceptance(GetNavigator, {"INNER_AIR"},
+                                                GetCoordOrigin()));
+
 
     // STEEL STRUCTURE GENERATORS
     lat_roof_gen_ =
@@ -606,6 +626,9 @@ namespace nexus {
     delete lead_gen_;
     delete steel_gen_;
     delete inner_air_gen_;
+    delete lead_map_;
+    delete steel_map_;
+    delete inner_air_map_;
     delete external_gen_;
     delete lat_roof_gen_;
     delete front_roof_gen_;
@@ -640,38 +663,48 @@ namespace nexus {
     return G4ThreeVector(0., -(steel_thickn_ + beam_thickn_2_)/2., 0.);
   }
 
+  std::vector<GeometryBase::ImportanceCell> Next100Shielding::GetImportanceCells() const
+  {
+    std::vector<ImportanceCell> cells;
+
+    // The steel box is not centred in the lead one, so the slices
+    // are interpolated between the two of them, which keeps them nested
+    G4ThreeVector lead_half (lead_x_/2., lead_y_/2., lead_z_/2.);
+    G4ThreeVector steel_half(shield_x_/2. + steel_thickn_,
+                             shield_y_/2. + steel_thickn_,
+                             shield_z_/2. + steel_thickn_);
+    G4ThreeVector steel_pos(0., -beam_thickn_2_/2., 0.);
+
+    for (G4int i=0; i<importance_slices_; ++i) {
+      G4double f = G4double(i) / importance_slices_;
+      cells.push_back({"SHIELDING_LEAD_" + std::to_string(i),
+                       (1. - f) * lead_half + f * steel_half,
+                       f * steel_pos});
+    }
+
+    cells.push_back({"SHIELDING_STEEL", steel_half, steel_pos});
+
+    cells.push_back({"INNER_AIR",
+                     G4ThreeVector(shield_x_/2., shield_y_/2. + steel_thickn_/2., shield_z_/2.),
+                     GetAirDisplacement()});
+
+    return cells;
+  }
+
   G4ThreeVector Next100Shielding::GenerateVertex(const G4String& region) const
   {
     G4ThreeVector vertex(0., 0., 0.);
 
     if (region == "SHIELDING_LEAD") {
-        G4VPhysicalVolume *VertexVolume;
-        do {
-          vertex = lead_gen_->GenerateVertex(VOLUME);
-          G4ThreeVector glob_vtx(vertex);
-          glob_vtx = glob_vtx - GetCoordOrigin();
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-        } while (VertexVolume->GetName() != "LEAD_BOX");
+        vertex = lead_map_->GenerateVertex();
     }
 
     else if (region == "SHIELDING_STEEL") {
-      G4VPhysicalVolume *VertexVolume;
-      do {
-        vertex = steel_gen_->GenerateVertex(VOLUME);
-        G4ThreeVector glob_vtx(vertex);
-        glob_vtx = glob_vtx - GetCoordOrigin();
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-      } while (VertexVolume->GetName() != "STEEL_BOX");
+      vertex = steel_map_->GenerateVertex();
     }
 
     else if (region == "INNER_AIR") {
-      G4VPhysicalVolume *VertexVolume;
-      do {
-        vertex = inner_air_gen_->GenerateVertex(INSIDE);
-        G4ThreeVector glob_vtx(vertex);
-        glob_vtx = glob_vtx - GetCoordOrigin();
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-      } while (VertexVolume->GetName() != "INNER_AIR");
+      vertex = inner_air_map_->GenerateVertex();
     }
 
     else if (region == "EXTERNAL") {
@@ -11,7 +11,6 @@
 
 #include "GeometryBase.h"
 
-#include <G4Navigator.hh>
 
 class G4GenericMessenger;
 
@@ -20,6 +19,7 @@ class G4GenericMessenger;
 namespace nexus {
 
   class BoxPointSampler;
+  class AcceptanceMapSampler;
 
   class Next100Shielding: public GeometryBase
   {
@@ -53,6 +53,10 @@ namespace nexus {
     /// Retrieve dimensions
     G4ThreeVector GetDimensions() const;
 
+    /// Importance biasing cells: the lead divided in slices
+    /// of equal thickness, the steel box and the inner air
+    std::vector<ImportanceCell> GetImportanceCells() const;
+
 
   private:
 
@@ -72,6 +76,7 @@ namespace nexus {
 
     G4bool visibility_;
     G4bool verbosity_;
+    G4int importance_slices_; ///< Number of importance biasing cells in the lead
 
     G4double lead_x_, lead_y_, lead_z_;
 
@@ -80,6 +85,11 @@ namespace nexus {
     BoxPointSampler* steel_gen_;
     BoxPointSampler* inner_air_gen_;
     BoxPointSampler* external_gen_;
+
+    // Acceptance maps of the generators of regions defined by rejection
+    AcceptanceMapSampler* lead_map_;
+    AcceptanceMapSampler* steel_map_;
+    AcceptanceMapSampler* inner_air_map_;
     BoxPointSampler* lat_roof_gen_;
     BoxPointSampler* front_roof_gen_;
     BoxPointSampler* struct_x_gen_;
@@ -115,9 +125,6 @@ namespace nexus {
     G4double perc_edpm_lateral_vol_;
 
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
@@ -15,12 +15,14 @@
 #include "BoxPointSampler.h"
 #include "Visibilities.h"
 #include "Next100SiPM.h"
+#include "ArrayParameterisation.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4Box.hh>
 #include <G4Tubs.hh>
 #include <G4LogicalVolume.hh>
 #include <G4PVPlacement.hh>
+#include <G4PVParameterised.hh>
 #include <G4Material.hh>
 #include <G4NistManager.hh>
 #include <G4OpticalSurface.hh>
@@ -101,12 +103,15 @@ void Next100SiPMBoard::Construct()
 
 
   // TEFLON MASK /////////////////////////////////////////////////////
+  // The WLS coating is placed on top of the mask, next to it, so that
+  // the holes are the only daughters of the mask and can be parameterised.
 
   G4String mask_name = "SIPM_BOARD_MASK";
-  G4double mask_zpos = board_thickness_/2.;
+  G4double wls_thickness = 1. * um;
+  G4double mask_zpos = board_thickness_/2. - wls_thickness/2.;
 
   G4Box* mask_solid_vol =
-    new G4Box(mask_name, size_/2., size_/2., mask_thickness_/2.);
+    new G4Box(mask_name, size_/2., size_/2., (mask_thickness_ - wls_thickness)/2.);
 
   G4Material* teflon = G4NistManager::Instance()->FindOrBuildMaterial("G4_TEFLON");
   // teflon is the material used in the sipm-board masks which are covered by
@@ -131,8 +136,7 @@ void Next100SiPMBoard::Construct()
   // WLS COATING /////////////////////////////////////////////////////
 
   G4String mask_wls_name = "SIPM_BOARD_MASK_WLS";
-  G4double wls_thickness = 1. * um;
-  G4double mask_wls_zpos = mask_thickness_/2. - wls_thickness/2.;
+  G4double mask_wls_zpos = (board_thickness_ + mask_thickness_)/2. - wls_thickness/2.;
 
   G4Box* mask_wls_solid_vol =
     new G4Box(mask_wls_name, size_/2., size_/2., wls_thickness/2.);
@@ -145,7 +149,7 @@ void Next100SiPMBoard::Construct()
 
   G4VPhysicalVolume* mask_wls_phys_vol =
     new G4PVPlacement(nullptr, G4ThreeVector(0., 0., mask_wls_zpos),
-                      mask_wls_logic_vol, mask_wls_name, mask_logic_vol, false, 0, false);
+                      mask_wls_logic_vol, mask_wls_name, board_logic_vol, false, 0, false);
 
   G4OpticalSurface* mask_wls_opsurf =
     new G4OpticalSurface(mask_wls_name+"_OPSURF",
@@ -160,7 +164,6 @@ void Next100SiPMBoard::Construct()
 
   G4String mask_hole_name   = "SIPM_BOARD_MASK_HOLE";
   G4double mask_hole_length = mask_thickness_ - wls_thickness;
-  G4double mask_hole_zpos   = - mask_thickness_/2. + mask_hole_length/2.;
   G4double mask_hole_x = 6.0 * mm;
   G4double mask_hole_y = 5.0 * mm;
 
@@ -242,9 +245,7 @@ void Next100SiPMBoard::Construct()
   // Placing now 8x8 replicas of the gas hole and SiPM
 
   G4double zpos = board_thickness_ + sipm_thickn/2.;
-  G4VPhysicalVolume* mask_hole_phys_vol;
-
-  G4int counter = 0;
+  std::vector<G4ThreeVector> hole_positions;
 
   for (auto i=0; i<8; i++) {
 
@@ -257,27 +258,25 @@ void Next100SiPMBoard::Construct()
       G4ThreeVector sipm_position(xpos, ypos, zpos);
       sipm_positions_.push_back(sipm_position);
 
-      // Placement of the WLS gas hole
-      new G4PVPlacement(nullptr, G4ThreeVector(xpos, ypos, 0.),
-                        mask_wls_hole_logic_vol, mask_wls_hole_name,
-                        mask_wls_logic_vol, false, counter, false);
-      // Placement of the hole+SiPM
-      mask_hole_phys_vol =
-        new G4PVPlacement(nullptr, G4ThreeVector(xpos, ypos, mask_hole_zpos),
-                          mask_hole_logic_vol, mask_hole_name, mask_logic_vol,
-                          false, counter, false);
-
-      new G4LogicalBorderSurface(mask_wall_wls_name+"_OPSURF",
-                                 mask_hole_phys_vol, wall_wls_phys_vol,
-                                 mask_wls_opsurf);
-      new G4LogicalBorderSurface(mask_wls_name+"_OPSURF",
-                                 wall_wls_phys_vol, mask_hole_phys_vol,
-                                 mask_wls_opsurf);
-
-      counter++;
+      hole_positions.push_back(G4ThreeVector(xpos, ypos, 0.));
     }
   }
 
+  // The copy number of each hole (i.e., the SiPM id within the board)
+  // is its index in the list of positions
+  PlaceArray(mask_wls_hole_name, mask_wls_hole_logic_vol,
+             mask_wls_logic_vol, hole_positions);
+
+  G4VPhysicalVolume* mask_hole_phys_vol =
+    PlaceArray(mask_hole_name, mask_hole_logic_vol, mask_logic_vol, hole_positions);
+
+  new G4LogicalBorderSurface(mask_wall_wls_name+"_OPSURF",
+                             mask_hole_phys_vol, wall_wls_phys_vol,
+                             mask_wls_opsurf);
+  new G4LogicalBorderSurface(mask_wls_name+"_OPSURF",
+                             wall_wls_phys_vol, mask_hole_phys_vol,
+                             mask_wls_opsurf);
+
   // VERTEX GENERATOR ////////////////////////////////////////////////
 
   vtxgen_ = new BoxPointSampler(size_/2., size_/2., (board_thickness_+mask_thickness_)/2.,
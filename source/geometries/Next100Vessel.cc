@@ -25,7 +25,7 @@
 #include <G4NistManager.hh>
 #include <G4Material.hh>
 #include <Randomize.hh>
-#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
 #include <G4UnitsTable.hh>
 #include <G4SubtractionSolid.hh>
 
@@ -92,10 +92,6 @@ namespace nexus {
     /// This way, the inner part of the EP flange emerges as the part of
     // the inner volume of the vessel which is not occupied by xenon.
 
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ =
-      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ =
       new G4GenericMessenger(this, "/Geometry/Next100/", "Control commands of Next100 geometry.");
@@ -126,6 +122,9 @@ namespace nexus {
     e_lifetime_cmd.SetRange("e_lifetime>0.");
 
     msg_->DeclareProperty("th_source", th_source_,  "Th-228 source used: old_source or new_source");
+
+    // Vertex generation regions
+    RegisterRegions({"VESSEL", "PORT_1a", "PORT_2a", "PORT_1b", "PORT_2b"});
   }
 
 
@@ -533,7 +532,7 @@ namespace nexus {
           G4ThreeVector glob_vtx(vertex);
           // this->GetCoordOrigin() only has x and y set
           glob_vtx = glob_vtx - GetCoordOrigin() - G4ThreeVector(0, 0, gate_z_pos_);
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+          VertexVolume = GetNavigator()->LocateGlobalPointAndSetup(glob_vtx, 0, false);
         } while (VertexVolume->GetName() != "VESSEL");
       }
       else if (rand < (perc_endcap_vol_ + perc_ep_flange_vol_ + perc_tp_flange_vol_)){// Tracking flange
@@ -547,7 +546,7 @@ namespace nexus {
           G4ThreeVector glob_vtx(vertex);
           // this->GetCoordOrigin() only has x and y set
           glob_vtx = glob_vtx - GetCoordOrigin() - G4ThreeVector(0, 0, gate_z_pos_);
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+          VertexVolume = GetNavigator()->LocateGlobalPointAndSetup(glob_vtx, 0, false);
         } while (VertexVolume->GetName() != "VESSEL");
       }
     }
@@ -37,6 +37,9 @@ NextDemo::NextDemo():
   msg_->DeclarePropertyWithUnit("specific_vertex", "mm",  specific_vertex_,
       "Set generation vertex.");
 
+  // Vertex generation regions
+  RegisterRegions({"AD_HOC", "CALIBRATION_SOURCE",
+                   "ACTIVE", "TP_PLATE", "SIPM_BOARD", "EL_GAP"});
 }
 
 
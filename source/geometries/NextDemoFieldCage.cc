@@ -33,7 +33,7 @@
 #include <G4SDManager.hh>
 #include <G4NistManager.hh>
 #include <G4UnitsTable.hh>
-#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
 
 
 namespace nexus {
@@ -95,10 +95,6 @@ namespace nexus {
     new G4UnitDefinition("kilovolt/cm","kV/cm","Electric field", kilovolt/cm);
     new G4UnitDefinition("mm/sqrt(cm)","mm/sqrt(cm)","Diffusion", mm/sqrt(cm));
 
-    /// Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ =
-      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger ///
     msg_ = new G4GenericMessenger(this, "/Geometry/NextDemo/", +
                                   "Control commands of geometry NextDemo.");
@@ -690,7 +686,7 @@ namespace nexus {
          G4ThreeVector glob_vtx(vertex);
          glob_vtx = glob_vtx + G4ThreeVector(0, 0, -GetELzCoord());
          VertexVolume =
-           geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+           GetNavigator()->LocateGlobalPointAndSetup(glob_vtx, 0, false);
        } while (VertexVolume->GetName() != region);
      }
      else if (region == "EL_GAP") {
@@ -20,12 +20,14 @@
 #include "OpticalMaterialProperties.h"
 #include "BoxPointSamplerLegacy.h"
 #include "Visibilities.h"
+#include "ArrayParameterisation.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4Box.hh>
 #include <G4Tubs.hh>
 #include <G4LogicalVolume.hh>
 #include <G4PVPlacement.hh>
+#include <G4PVParameterised.hh>
 #include <G4RotationMatrix.hh>
 #include <G4Material.hh>
 #include <G4NistManager.hh>
@@ -287,17 +289,15 @@ void NextDemoSiPMBoard::Construct()
 
 
   /// Placing the Holes with SiPMs & membranes inside
-  G4VPhysicalVolume* hole_phys;
-  for (G4int sipm_id=0; sipm_id<num_sipms_; sipm_id++) {
-    hole_phys = new G4PVPlacement(nullptr, sipm_positions_[sipm_id], hole_logic,
-                                  hole_name, mask_logic, false, sipm_id, false);
-
-    if (hole_coated_ && (hole_type_ == "rectangular")){
-      new G4LogicalBorderSurface("HOLE_COATING_GAS_OPSURF", hole_coating_phys,
-                                 hole_phys, coating_opsurf);
-      new G4LogicalBorderSurface("GAS_HOLE_COATING_OPSURF", hole_phys,
-                                 hole_coating_phys, coating_opsurf);
-    }
+  /// (the copy number of each hole is the SiPM id)
+  G4VPhysicalVolume* hole_phys =
+    PlaceArray(hole_name, hole_logic, mask_logic, sipm_positions_);
+
+  if (hole_coated_ && (hole_type_ == "rectangular")){
+    new G4LogicalBorderSurface("HOLE_COATING_GAS_OPSURF", hole_coating_phys,
+                               hole_phys, coating_opsurf);
+    new G4LogicalBorderSurface("GAS_HOLE_COATING_OPSURF", hole_phys,
+                               hole_coating_phys, coating_opsurf);
   }
 
 
@@ -334,13 +334,13 @@ void NextDemoSiPMBoard::Construct()
         G4LogicalVolume* board_coating_hole_logic =
                 new G4LogicalVolume(board_coating_hole_solid, mother_gas, "BOARD_COATING_HOLE");
 
-        G4ThreeVector position (0., 0., 0.);
-        for (G4int sipm_id=0; sipm_id<num_sipms_; sipm_id++){
-          position.setX(sipm_positions_[sipm_id].x());
-          position.setY(sipm_positions_[sipm_id].y());
-          new G4PVPlacement(nullptr, position, board_coating_hole_logic,
-                           "BOARD_COATING_HOLE", coating_logic, false, sipm_id, false);
-        }
+        std::vector<G4ThreeVector> positions;
+        for (G4int sipm_id=0; sipm_id<num_sipms_; sipm_id++)
+          positions.push_back(G4ThreeVector(sipm_positions_[sipm_id].x(),
+                                            sipm_positions_[sipm_id].y(), 0.));
+
+        PlaceArray("BOARD_COATING_HOLE", board_coating_hole_logic,
+                   coating_logic, positions);
       }
     }
   }
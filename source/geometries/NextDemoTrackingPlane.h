@@ -15,7 +15,6 @@
 
 class G4VPhysicalVolume;
 class G4GenericMessenger;
-class G4Navigator;
 
 namespace nexus {
 
@@ -62,9 +61,6 @@ namespace nexus {
     G4VPhysicalVolume*  mother_phys_;
 
     G4GenericMessenger* msg_;
-
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
   };
 
   inline void NextDemoTrackingPlane::SetConfig(G4String config)
@@ -21,6 +21,7 @@
 #include "CylinderPointSampler.h"
 #include "Visibilities.h"
 #include "FactoryBase.h"
+#include "StartupProfiler.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4LogicalVolume.hh>
@@ -72,6 +73,11 @@ NextFlex::NextFlex():
 
   // Tracking Plane
   tracking_plane_ = new NextFlexTrackingPlane();
+
+  // Vertex generation regions
+  RegisterRegions({"AD_HOC", "ICS",
+                   "ACTIVE", "BUFFER", "EL_GAP", "LIGHT_TUBE", "FIBER_CORE",
+                   "EP_COPPER", "EP_WINDOWS", "TP_COPPER"});
 }
 
 
@@ -219,7 +225,7 @@ void NextFlex::Construct()
   field_cage_->SetMotherLogicalVolume(gas_logic_vol);
   field_cage_->SetFirstLeftSensorID(FIRST_LEFT_FIBER_SENSOR_ID);
   field_cage_->SetFirstRightSensorID(FIRST_RIGHT_FIBER_SENSOR_ID);
-  field_cage_->Construct();
+  StartupProfiler::Measure("NextFlexFieldCage", [this]{ field_cage_->Construct(); });
 
   // Energy Plane
   energy_plane_->SetMotherLogicalVolume(gas_logic_vol);
@@ -227,7 +233,7 @@ void NextFlex::Construct()
   energy_plane_->SetDiameter(field_cage_->Get_ACTIVE_diam());
   energy_plane_->SetOriginZ(field_cage_->Get_BUFFER_finalZ());
   energy_plane_->SetFirstSensorID(FIRST_ENERGY_SENSOR_ID);
-  energy_plane_->Construct();
+  StartupProfiler::Measure("NextFlexEnergyPlane", [this]{ energy_plane_->Construct(); });
 
   // Tracking Plane
   tracking_plane_->SetMotherLogicalVolume(gas_logic_vol);
@@ -235,7 +241,7 @@ void NextFlex::Construct()
   tracking_plane_->SetDiameter(field_cage_->Get_ACTIVE_diam());
   tracking_plane_->SetOriginZ(field_cage_->Get_EL_GAP_iniZ());
   tracking_plane_->SetFirstSensorID(FIRST_TRACKING_SENSOR_ID);
-  tracking_plane_->Construct();
+  StartupProfiler::Measure("NextFlexTrackingPlane", [this]{ tracking_plane_->Construct(); });
 
   // The ICS
   BuildICS(gas_logic_vol);
@@ -17,6 +17,7 @@
 #include "GenericPhotosensor.h"
 #include "SensorSD.h"
 #include "Visibilities.h"
+#include "WLSFiberInfo.h"
 
 #include <G4UnitsTable.hh>
 #include <G4GenericMessenger.hh>
@@ -33,6 +34,7 @@
 #include <G4LogicalBorderSurface.hh>
 #include <G4UserLimits.hh>
 #include <G4Transform3D.hh>
+#include <G4Region.hh>
 
 
 using namespace nexus;
@@ -61,6 +63,7 @@ NextFlexFieldCage::NextFlexFieldCage():
   gate_transparency_       (0.95),               // Gate transparency
   photoe_prob_             (0),                  // OpticalPhotoElectric Probability
   fiber_claddings_         (2),                  // Number of fiber claddings (0, 1 or 2)
+  fiber_fast_model_        (false),              // Fast light transport along the fibers
   fiber_sensor_binning_    (100. * ns),          // Size of fiber sensors time binning
   wls_mat_name_            ("TPB"),              // UV wls material name
   fiber_mat_name_          ("EJ280"),            // Fiber core material name
@@ -219,6 +222,9 @@ void NextFlexFieldCage::DefineConfigurationParameters()
   fiber_claddings_cmd.SetParameterName("fiber_claddings", false);
   fiber_claddings_cmd.SetRange("fiber_claddings>=0 && fiber_claddings<=2");
 
+  msg_->DeclareProperty("fiber_fast_model", fiber_fast_model_,
+                        "Transport the light trapped in the fibers with a fast model.");
+
   G4GenericMessenger::Command& fiber_sensor_binning_cmd =
     msg_->DeclareProperty("fiber_sensor_time_binning", fiber_sensor_binning_,
                           "Time bin size of fiber sensors.");
@@ -831,6 +837,18 @@ void NextFlexFieldCage::BuildFibers()
   // Updating info
   if (fiber_claddings_ == 0) out_logic_volume = core_logic;
 
+  // Fast light transport: the core is the envelope of the model, and the
+  // trapping is given by the outermost cladding (or the surrounding gas)
+  if (fiber_fast_model_) {
+    G4Material* cladding_mat = mother_logic_->GetMaterial();
+    if      (fiber_claddings_ >= 2) cladding_mat = oClad_mat_;
+    else if (fiber_claddings_ == 1) cladding_mat = iClad_mat_;
+
+    G4Region* fiber_region = new G4Region("FIBER_CORE");
+    fiber_region->SetUserInformation(new WLSFiberInfo(cladding_mat));
+    fiber_region->AddRootLogicalVolume(core_logic);
+  }
+
   // Vertex generator
   fiber_gen_ =
     new CylinderPointSampler(inner_rad, outer_rad, fiber_length/2., 0., twopi,
@@ -133,6 +133,7 @@ namespace nexus {
     // FIBERS
     G4double fiber_thickness_;
     G4int    fiber_claddings_;
+    G4bool   fiber_fast_model_;
     G4double fiber_extra_length_;
     G4double fiber_inner_rad_;
     G4double fiber_light_tube_gap_;
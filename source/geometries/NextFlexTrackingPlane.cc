@@ -22,7 +22,7 @@
 #include <G4GenericMessenger.hh>
 #include <G4Tubs.hh>
 #include <G4SubtractionSolid.hh>
-#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
 #include <G4RotationMatrix.hh>
 
 #include <G4LogicalVolume.hh>
@@ -71,10 +71,6 @@ NextFlexTrackingPlane::NextFlexTrackingPlane():
 
   // Hard-wired dimensions & components
   wls_thickness_  = 1. * um;
-
-  // Initializing the geometry navigator (used in vertex generation)
-  geom_navigator_ =
-    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
 }
 
 
@@ -496,7 +492,7 @@ G4ThreeVector NextFlexTrackingPlane::GenerateVertex(const G4String& region) cons
     G4VPhysicalVolume *VertexVolume;
     do {
       vertex       = copper_gen_->GenerateVertex(VOLUME);
-      VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(vertex, 0, false);
+      VertexVolume = GetNavigator()->LocateGlobalPointAndSetup(vertex, 0, false);
     } while (VertexVolume->GetName() != region);
   }
 
@@ -133,6 +133,23 @@ namespace nexus {
 
     extra_ = new ExtraVessel();
 
+    // Vertex generation regions
+    RegisterRegions({"LAB", "EXTERNAL_PORT_ANODE", "EXTERNAL_PORT_AXIAL",
+                     "SOURCE_PORT_AXIAL_EXT", "SOURCE_PORT_LATERAL_EXT",
+                     "SOURCE_PORT_LATERAL_DISK", "SOURCE_PORT_UP_DISK", "SOURCE_DISK",
+                     "SHIELDING_LEAD", "SHIELDING_STEEL", "INNER_AIR",
+                     "SHIELDING_STRUCT", "EXTERNAL", "PEDESTAL_BOARD", "EXTRA_VESSEL",
+                     "HALLA_INNER", "HALLA_OUTER",
+                     "MINI_CASTLE", "RN_MINI_CASTLE", "MINI_CASTLE_STEEL",
+                     "VESSEL", "SOURCE_PORT_ANODE", "SOURCE_PORT_UP", "SOURCE_PORT_AXIAL",
+                     "INTERNAL_PORT_ANODE", "INTERNAL_PORT_UPPER", "INTERNAL_PORT_AXIAL",
+                     "ICS",
+                     "CENTER", "CARRIER_PLATE", "ENCLOSURE_BODY", "ENCLOSURE_WINDOW",
+                     "OPTICAL_PAD", "PMT_BODY", "PMT_BASE", "INT_ENCLOSURE_SURF",
+                     "PMT_SURF", "DRIFT_TUBE", "ANODE_QUARTZ", "HDPE_TUBE", "XENON",
+                     "ACTIVE", "BUFFER", "EL_GAP", "EL_TABLE", "CATHODE",
+                     "TRACKING_FRAMES", "SUPPORT_PLATE", "DICE_BOARD", "DB_PLUG",
+                     "AD_HOC"});
   }
 
   NextNew::~NextNew()
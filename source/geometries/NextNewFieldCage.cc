@@ -31,7 +31,7 @@
 #include <G4SDManager.hh>
 #include <G4RunManager.hh>
 #include <G4UnitsTable.hh>
-#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
 
 #include <CLHEP/Units/SystemOfUnits.h>
 
@@ -764,15 +764,13 @@ void NextNewFieldCage::BuildBuffer()
       vertex = hdpe_tube_gen_->GenerateVertex("BODY_VOL");
     }
     else if (region == "XENON") {
-      G4Navigator *geom_navigator =
-        G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
       G4String volume_name;
       do {
         vertex = xenon_gen_->GenerateVertex("BODY_VOL");
         G4ThreeVector glob_vtx(vertex);
         CalculateGlobalPos(glob_vtx);
         volume_name =
-          geom_navigator->LocateGlobalPointAndSetup(glob_vtx, 0, false)->GetName();
+          GetNavigator()->LocateGlobalPointAndSetup(glob_vtx, 0, false)->GetName();
       } while (volume_name == "CATHODE_GRID" || volume_name == "EL_GRID_GATE");
     }
     else if (region == "BUFFER") {
@@ -56,9 +56,6 @@ namespace nexus {
     BoxPointSamplerLegacy* mini_castle_external_surf_gen_;
     BoxPointSamplerLegacy* steel_box_gen_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Position of the pedestal surface in y
     G4double pedestal_surf_y_;
 
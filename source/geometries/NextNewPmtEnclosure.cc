@@ -47,9 +47,6 @@ namespace nexus{
     pmt_base_z_ (50. *mm), //distance from window
     visibility_(1)
   {
-    /// Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/NextNew/", "Control commands of geometry NextNew.");
     msg_->DeclareProperty("enclosure_vis", visibility_, "Vessel Visibility");
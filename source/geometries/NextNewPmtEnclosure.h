@@ -72,9 +72,6 @@ namespace nexus{
     G4double flange_perc_;
     G4double int_surf_perc_, int_cap_surf_perc_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
@@ -75,9 +75,6 @@ namespace nexus {
     G4double perc_struc_x_vol_;
 
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
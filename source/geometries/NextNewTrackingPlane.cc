@@ -14,6 +14,7 @@
 #include "BoxPointSamplerLegacy.h"
 
 #include <G4PVPlacement.hh>
+#include <G4Navigator.hh>
 #include <G4VisAttributes.hh>
 #include <G4Material.hh>
 #include <G4LogicalVolume.hh>
@@ -63,8 +64,6 @@ namespace nexus {
 
     visibility_ (1)
   {
-    /// Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/NextNew/", "Control commands of geometry NextNew.");
     msg_->DeclareProperty("tracking_plane_vis", visibility_, "Tracking Plane Visibility");
@@ -236,7 +235,7 @@ namespace nexus {
           // First rotate, then shift
           glob_vtx.rotate(pi, G4ThreeVector(0., 1., 0.));
           glob_vtx = glob_vtx + G4ThreeVector(0, 0, GetELzCoord());
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+          VertexVolume = GetNavigator()->LocateGlobalPointAndSetup(glob_vtx, 0, false);
         } while (VertexVolume->GetName() != "SUPPORT_PLATE");
       }
       // Generating in the flange
@@ -100,9 +100,6 @@ namespace nexus {
     G4double perc_endcap_vol_;
     G4double perc_tube_vol_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
@@ -50,6 +50,10 @@ NextTonScale::NextTonScale():
   outer_plane_gen_(nullptr), external_gen_(nullptr), muon_gen_(nullptr)
 {
   DefineConfigurationParameters();
+
+  // Vertex generation regions
+  RegisterRegions({"AD_HOC", "ACTIVE", "FIELD_CAGE", "CATHODE", "READOUT_PLANE",
+                   "INNER_SHIELDING", "OUTER_PLANE", "VESSEL", "MUONS", "EXTERNAL"});
 }
 
 
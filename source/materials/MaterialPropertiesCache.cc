@@ -0,0 +1,91 @@
+// ----------------------------------------------------------------------------
+// nexus | MaterialPropertiesCache.cc
+//
+// Cache of the optical property tables that are computed when the materials
+// are built (refractive indices, emission spectra, etc.). Each table is built
+// once per set of parameters and shared by all the materials that request
+// it, instead of being computed again for each of them.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "MaterialPropertiesCache.h"
+
+#include <iomanip>
+
+
+namespace nexus {
+
+  std::mutex MaterialPropertiesCache::mutex_;
+  std::map<G4String, G4MaterialPropertiesTable*> MaterialPropertiesCache::shared_;
+  std::map<G4String, MaterialPropertiesCache::Usage> MaterialPropertiesCache::usage_;
+
+
+
+  G4MaterialPropertiesTable* MaterialPropertiesCache::Load(const G4String& table)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Usage& usage = usage_[table];
+
+    auto shared = shared_.find(table);
+    if (shared != shared_.end()) {
+      ++usage.shared;
+      return shared->second;
+    }
+
+    // The time spent until the table is saved is that of building it
+    usage.start = std::chrono::steady_clock::now();
+    return nullptr;
+  }
+
+
+
+  void MaterialPropertiesCache::Save(const G4String& table,
+                                     G4MaterialPropertiesTable* mpt)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (shared_.count(table)) return;
+    shared_[table] = mpt;
+
+    Usage& usage = usage_[table];
+    if (usage.start != std::chrono::steady_clock::time_point())
+      usage.time = std::chrono::duration<G4double>
+        (std::chrono::steady_clock::now() - usage.start).count();
+  }
+
+
+
+  void MaterialPropertiesCache::PrintReport()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (usage_.empty()) return;
+
+    G4double total = 0.;
+    const auto precision = G4cout.precision();
+
+    G4cout << "[MaterialPropertiesCache] Optical property tables:" << G4endl;
+    for (const auto& table: usage_) {
+      const Usage& usage = table.second;
+      G4cout << "  " << std::left << std::setw(60) << table.first << std::right
+             << " built in " << std::fixed << std::setprecision(2)
+             << std::setw(8) << usage.time * 1.e3
+             << " ms, shared " << usage.shared << " times" << G4endl;
+      total += usage.time;
+    }
+    G4cout << "  Total time: " << std::setprecision(2) << total * 1.e3 << " ms"
+           << std::defaultfloat << std::setprecision(precision) << G4endl;
+  }
+
+
+
+  void MaterialPropertiesCache::Clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shared_.clear();
+    usage_.clear();
+  }
+
+} // end namespace nexus
@@ -0,0 +1,75 @@
+// ----------------------------------------------------------------------------
+// nexus | MaterialPropertiesCache.h
+//
+// Cache of the optical property tables that are computed when the materials
+// are built (refractive indices, emission spectra, etc.). Each table is built
+// once per set of parameters and shared by all the materials that request
+// it, instead of being computed again for each of them.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef MATERIAL_PROPERTIES_CACHE_H
+#define MATERIAL_PROPERTIES_CACHE_H
+
+#include <globals.hh>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+class G4MaterialPropertiesTable;
+
+
+namespace nexus {
+
+  class MaterialPropertiesCache
+  {
+  public:
+    /// Shared instance of the given table, nullptr if it has not
+    /// been built yet (in which case the caller has to build it)
+    static G4MaterialPropertiesTable* Load(const G4String& table);
+    /// Share a table that has just been built
+    static void Save(const G4String& table, G4MaterialPropertiesTable*);
+
+    /// Print the tables that have been requested, with the time
+    /// spent building them and the number of times they were shared
+    static void PrintReport();
+    /// Forget the shared tables. They are not deleted,
+    /// since they belong to the materials that use them.
+    static void Clear();
+
+    /// Name of a table computed with the given parameters
+    template <typename... Args>
+    static G4String TableName(const G4String& function, Args... args);
+
+  private:
+    /// Requests of a table since the start of the job
+    struct Usage {
+      G4double time = 0.; ///< Time spent building it (in seconds)
+      G4int shared = 0;   ///< Number of times it was reused
+      std::chrono::steady_clock::time_point start;
+    };
+
+  private:
+    static std::mutex mutex_;
+    static std::map<G4String, G4MaterialPropertiesTable*> shared_;
+    static std::map<G4String, Usage> usage_;
+  };
+
+  // INLINE DEFINITIONS ////////////////////////////////////
+
+  template <typename... Args>
+  G4String MaterialPropertiesCache::TableName(const G4String& function, Args... args)
+  {
+    std::ostringstream name;
+    name.precision(12);
+    name << function;
+    ((name << " " << args), ...);
+    return name.str();
+  }
+
+} // namespace nexus
+
+#endif
@@ -1,7 +1,9 @@
 // ----------------------------------------------------------------------------
 // nexus | OpticalMaterialProperties.cc
 //
-// Optical properties of relevant materials.
+// Optical properties of relevant materials. The tables that are computed
+// from formulas are built once per set of parameters and shared through
+// the MaterialPropertiesCache.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -9,6 +11,7 @@
 #include "OpticalMaterialProperties.h"
 #include "XenonProperties.h"
 #include "SellmeierEquation.h"
+#include "MaterialPropertiesCache.h"
 
 #include <G4MaterialPropertiesTable.hh>
 
@@ -39,6 +42,9 @@ namespace opticalprops {
 
   G4MaterialPropertiesTable* FusedSilica()
   {
+    const G4String table = MaterialPropertiesCache::TableName("FusedSilica");
+    if (auto cached = MaterialPropertiesCache::Load(table)) return cached;
+
     // Optical properties of Suprasil 311/312(c) synthetic fused silica.
     // Obtained from http://heraeus-quarzglas.com
 
@@ -101,6 +107,7 @@ namespace opticalprops {
 
     mpt->AddProperty("ABSLENGTH", abs_energy, absLength);
 
+    MaterialPropertiesCache::Save(table, mpt);
     return mpt;
   }
 
@@ -247,6 +254,9 @@ namespace opticalprops {
 
   G4MaterialPropertiesTable* ITO()
   {
+    const G4String table = MaterialPropertiesCache::TableName("ITO");
+    if (auto cached = MaterialPropertiesCache::Load(table)) return cached;
+
     // Input data: complex refraction index obtained from:
     // https://refractiveindex.info/?shelf=other&book=In2O3-SnO2&page=Moerland
     // Only valid in [1000 - 400] nm
@@ -293,6 +303,7 @@ namespace opticalprops {
     //         << "  Abs Length: " << std::setw(5) << abs_length[i] / nm << " nm" << G4endl;
     //}
 
+    MaterialPropertiesCache::Save(table, mpt);
     return mpt;
   }
 
@@ -300,6 +311,9 @@ namespace opticalprops {
 
   G4MaterialPropertiesTable* PEDOT()
   {
+    const G4String table = MaterialPropertiesCache::TableName("PEDOT");
+    if (auto cached = MaterialPropertiesCache::Load(table)) return cached;
+
     // Input data: complex refraction index obtained from:
     // https://refractiveindex.info/?shelf=other&book=PEDOT-PSS&page=Chen
     // Only valid in [1097 - 302] nm
@@ -346,6 +360,7 @@ namespace opticalprops {
     //         << "  Abs Length: " << std::setw(5) << abs_length[i] / nm << " nm" << G4endl;
     //}
 
+    MaterialPropertiesCache::Save(table, mpt);
     return mpt;
   }
 
@@ -353,6 +368,9 @@ namespace opticalprops {
 
   G4MaterialPropertiesTable* GlassEpoxy()
   {
+    const G4String table = MaterialPropertiesCache::TableName("GlassEpoxy");
+    if (auto cached = MaterialPropertiesCache::Load(table)) return cached;
+
     // Optical properties of Optorez 1330 glass epoxy.
     // Obtained from http://refractiveindex.info and
     // https://www.zeonex.com/Optics.aspx.html#glass-like
@@ -400,6 +418,7 @@ namespace opticalprops {
     };
     mpt->AddProperty("ABSLENGTH", abs_energy, absLength);
 
+    MaterialPropertiesCache::Save(table, mpt);
     return mpt;
   }
 
@@ -407,6 +426,9 @@ namespace opticalprops {
 
   G4MaterialPropertiesTable* Sapphire()
   {
+    const G4String table = MaterialPropertiesCache::TableName("Sapphire");
+    if (auto cached = MaterialPropertiesCache::Load(table)) return cached;
+
     // Input data: Sellmeier equation coeficients extracted from:
     // https://refractiveindex.info/?shelf=3d&book=crystals&page=sapphire
     // C[i] coeficients at line 362 are squared.
@@ -463,6 +485,7 @@ namespace opticalprops {
     };
     mpt->AddProperty("ABSLENGTH", abs_energy, absLength);
 
+    MaterialPropertiesCache::Save(table, mpt);
     return mpt;
   }
 
@@ -523,6 +546,9 @@ namespace opticalprops {
   G4MaterialPropertiesTable* GAr(G4double sc_yield,
                                 G4double e_lifetime)
   {
+    const G4String table = MaterialPropertiesCache::TableName("GAr", sc_yield, e_lifetime);
+    if (auto cached = MaterialPropertiesCache::Load(table)) return cached;
+
     // An argon gas proportional scintillation counter with UV avalanche photodiode scintillation
     // readout C.M.B. Monteiro, J.A.M. Lopes, P.C.P.S. Simoes, J.M.F. dos Santos, C.A.N. Conde
     //
@@ -590,6 +616,7 @@ namespace opticalprops {
     mpt->AddConstProperty("RESOLUTIONSCALE",    1.0);
     mpt->AddConstProperty("ATTACHMENT",         e_lifetime, 1);
 
+    MaterialPropertiesCache::Save(table, mpt);
     return mpt;
   }
 
@@ -601,6 +628,9 @@ namespace opticalprops {
                                 G4int    sc_yield,
                                 G4double e_lifetime)
   {
+    const G4String table = MaterialPropertiesCache::TableName("GXe", pressure, sc_yield, e_lifetime);
+    if (auto cached = MaterialPropertiesCache::Load(table)) return cached;
+
     G4MaterialPropertiesTable* mpt = new G4MaterialPropertiesTable();
 
     // REFRACTIVE INDEX
@@ -654,6 +684,7 @@ namespace opticalprops {
     mpt->AddConstProperty("SCINTILLATIONYIELD2", .9);
     mpt->AddConstProperty("ATTACHMENT",         e_lifetime, 1);
 
+    MaterialPropertiesCache::Save(table, mpt);
     return mpt;
   }
 
@@ -662,6 +693,9 @@ namespace opticalprops {
   /// Liquid xenon ///
   G4MaterialPropertiesTable* LXe()
   {
+    const G4String table = MaterialPropertiesCache::TableName("LXe");
+    if (auto cached = MaterialPropertiesCache::Load(table)) return cached;
+
     /// The time constants are taken from E. Hogenbirk et al 2018 JINST 13 P10031
     G4MaterialPropertiesTable* LXe_mpt = new G4MaterialPropertiesTable();
 
@@ -719,6 +753,7 @@ namespace opticalprops {
 
     LXe_mpt->AddProperty("RAYLEIGH", rayleigh_energy, rayleigh_length);
 
+    MaterialPropertiesCache::Save(table, LXe_mpt);
     return LXe_mpt;
   }
 
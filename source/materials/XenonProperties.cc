@@ -297,8 +297,9 @@ G4double GetGasDensity(G4double pressure, G4double temperature)
   // Interpolate to calculate the density
   // at a given pressure and temperature
   G4double density = 5.324 * kg/m3;
-  std::vector<std::vector<G4double>> data;
-  std::pair<G4int, G4int> nkeys = MakeXeDensityDataTable(data);
+  // The data file is only read on the first call
+  static std::vector<std::vector<G4double>> data;
+  static const std::pair<G4int, G4int> nkeys = MakeXeDensityDataTable(data);
   G4int npressures = nkeys.first;
   G4int ntemps     = nkeys.second;
 
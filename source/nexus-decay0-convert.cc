@@ -0,0 +1,30 @@
+// ----------------------------------------------------------------------------
+// nexus | nexus-decay0-convert.cc
+//
+// This program converts an ascii file produced by Decay0 into a binary
+// primary event library, which can be read by the Decay0Interface
+// generator with direct access to any event.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "Decay0Interface.h"
+
+#include <globals.hh>
+
+using namespace nexus;
+
+
+G4int main(int argc, char** argv)
+{
+  if (argc != 3) {
+    G4cerr << "\nUsage: ./nexus-decay0-convert <decay0_file> <library_file>\n" << G4endl;
+    return EXIT_FAILURE;
+  }
+
+  G4long nevents = Decay0Interface::ConvertToLibrary(argv[1], argv[2]);
+
+  G4cout << nevents << " events written to " << argv[2] << G4endl;
+
+  return EXIT_SUCCESS;
+}
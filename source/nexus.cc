@@ -8,32 +8,156 @@
 
 #include "NexusApp.h"
 #include "NexusExceptionHandler.h"
+#include "HDF5Merger.h"
 
 #include <G4StateManager.hh>
 #include <G4UImanager.hh>
+#include <G4UIcommandTree.hh>
 #include <G4UIExecutive.hh>
 #include <G4VisExecutive.hh>
 #include <G4SteppingVerbose.hh>
 
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <vector>
+
 #include <getopt.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using namespace nexus;
 
 
 void PrintUsage()
 {
-  G4cerr  << "\nUsage: ./nexus [-b|i] [-n number] <init_macro>\n" << G4endl;
+  G4cerr  << "\nUsage: ./nexus [-b|i] [-n number] [-t threads] [-s size] [-j jobs [-m]] <init_macro>\n" << G4endl;
   G4cerr  << "Available options:" << G4endl;
   G4cerr  << "   -b, --batch           : Run in batch mode (default)\n"
           << "   -i, --interactive     : Run in interactive mode\n"
           << "   -o, --overlap-check   : Turn warnings into exceptions and increase precision in overlap check\n"
           << "   -n, --nevents         : Number of events to simulate\n"
-          << "   -p, --precision       : Number of significant figures in verbosity"
+          << "   -p, --precision       : Number of significant figures in verbosity\n"
+          << "   -t, --threads         : Number of worker threads (default 1, sequential mode)\n"
+          << "   -s, --subevents       : Track the EL photons of each event in batches of this size\n"
+          << "                           on the worker threads (requires Geant4 11.2 or later)\n"
+          << "   -j, --jobs            : Split the events among this number of forked processes\n"
+          << "   -m, --merge           : Merge the output files of the jobs at the end"
           << G4endl;
   exit(EXIT_FAILURE);
 }
 
 
+/// Seed of a job, derived from the seed of the application
+/// so that the jobs generate independent random sequences
+long JobSeed(long seed, G4int job)
+{
+  uint64_t z = (uint64_t)seed + 0x9E3779B97F4A7C15ULL * (job + 1);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (long)(z % 2147483646) + 1;
+}
+
+
+/// Fork the (already initialized) application into njobs processes
+/// that simulate disjoint sets of events, each one with its own seed
+/// and output file. The parent process waits for the jobs and merges
+/// their output files if requested. Returns the exit status of the
+/// calling process.
+G4int RunJobs(NexusApp* app, G4int njobs, G4int nevents, G4bool merge)
+{
+  G4UImanager* UI = G4UImanager::GetUIpointer();
+
+  // These commands only exist if a persistency manager is registered
+  G4String output_file = UI->GetCurrentValues("/nexus/persistency/output_file");
+  G4String start_id_str = UI->GetCurrentValues("/nexus/persistency/start_id");
+  G4bool output = !output_file.empty();
+  long long start_id = start_id_str.empty() ? 0 : std::stoll(start_id_str);
+  long seed = CLHEP::HepRandom::getTheSeed();
+
+  njobs = std::max(1, std::min(njobs, nevents));
+
+  std::vector<pid_t> pids;
+  std::vector<G4String> job_files;
+  long long first_event = start_id;
+
+  for (G4int job=0; job<njobs; ++job) {
+
+    G4int job_events = nevents / njobs + (job < nevents % njobs ? 1 : 0);
+    G4String job_file = output_file + "_job" + std::to_string(job);
+    job_files.push_back(job_file + ".h5");
+
+    // Avoid duplicating buffered output in the children
+    G4cout << std::flush;
+    fflush(stdout);
+
+    pid_t pid = fork();
+
+    if (pid < 0) {
+      G4cerr << "ERROR: cannot fork job " << job << G4endl;
+      njobs = job;
+      break;
+    }
+
+    if (pid == 0) {
+      if (output) {
+        UI->ApplyCommand("/nexus/persistency/output_file " + job_file);
+        UI->ApplyCommand("/nexus/persistency/start_id " + std::to_string(first_event));
+      }
+      NexusApp::SetJobEventOffset(first_event - start_id);
+
+      // The other files written by the jobs are renamed like
+      // the output file, so that they do not overwrite each other
+      for (const G4String& cmd: {"/nexus/persistency/telemetry_file",
+                                 "/Actions/CPUAccounting/json_file"}) {
+        if (!UI->GetTree()->FindPath(cmd)) continue;
+        G4String file = UI->GetCurrentValues(cmd);
+        if (!file.empty())
+          UI->ApplyCommand(cmd + " " + file + "_job" + std::to_string(job));
+      }
+
+      CLHEP::HepRandom::setTheSeed(JobSeed(seed, job));
+      G4cout << "Job " << job << ": " << job_events << " events starting at ID "
+             << first_event << ", seed " << CLHEP::HepRandom::getTheSeed() << G4endl;
+
+      app->OpenOutput();
+      app->BeamOn(job_events);
+      return EXIT_SUCCESS;
+    }
+
+    pids.push_back(pid);
+    first_event += job_events;
+  }
+
+  G4bool success = (G4int)pids.size() == njobs && njobs > 0;
+  for (size_t job=0; job<pids.size(); ++job) {
+    int status = 0;
+    waitpid(pids[job], &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+      G4cerr << "ERROR: job " << job << " failed." << G4endl;
+      success = false;
+    }
+  }
+
+  if (!success) return EXIT_FAILURE;
+
+  if (merge && output) {
+    std::vector<std::string> inputs(job_files.begin(), job_files.end());
+    HDF5Merger merger;
+    if (!merger.Merge(inputs, output_file + ".h5")) {
+      G4cerr << "ERROR: the job output files could not be merged: "
+             << merger.GetError() << G4endl;
+      return EXIT_FAILURE;
+    }
+    G4cout << "Output of " << njobs << " jobs merged into "
+           << output_file << ".h5" << G4endl;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
 G4int main(int argc, char** argv)
 {
   ////////////////////////////////////////////////////////////////////
@@ -47,6 +171,10 @@ G4int main(int argc, char** argv)
   G4bool overlap_check = false;
   G4int nevents = 0;
   G4int precision = -1;
+  G4int nthreads = 1;
+  G4int subevent_size = 0;
+  G4int njobs = 1;
+  G4bool merge = false;
 
   static struct option long_options[] =
   {
@@ -55,6 +183,10 @@ G4int main(int argc, char** argv)
     {"overlaps",    no_argument,       0, 'o'},
     {"precision",   required_argument, 0, 'p'},
     {"nevents",     required_argument, 0, 'n'},
+    {"threads",     required_argument, 0, 't'},
+    {"subevents",   required_argument, 0, 's'},
+    {"jobs",        required_argument, 0, 'j'},
+    {"merge",       no_argument,       0, 'm'},
     {0, 0, 0, 0}
   };
 
@@ -64,7 +196,7 @@ G4int main(int argc, char** argv)
 
     //  int option_index = 0;
     opterr = 0;
-    c = getopt_long(argc, argv, "biop:n:", long_options, 0);
+    c = getopt_long(argc, argv, "biop:n:t:s:j:m", long_options, 0);
 
     if (c==-1) break; // Exit if we are done reading options
 
@@ -90,6 +222,22 @@ G4int main(int argc, char** argv)
         nevents = atoi(optarg);
         break;
 
+      case 't':
+        nthreads = atoi(optarg);
+        break;
+
+      case 's':
+        subevent_size = atoi(optarg);
+        break;
+
+      case 'j':
+        njobs = atoi(optarg);
+        break;
+
+      case 'm':
+        merge = true;
+        break;
+
       case '?':
         break;
 
@@ -112,6 +260,19 @@ G4int main(int argc, char** argv)
 
   if (macro_filename == "") PrintUsage();
 
+  // Jobs are forked from a sequential application in batch mode
+  if (njobs > 1 && (!batch || nthreads > 1 || subevent_size > 0)) {
+    G4cerr << "ERROR: --jobs cannot be combined with --interactive, "
+           << "--threads or --subevents." << G4endl;
+    PrintUsage();
+  }
+
+  // The events are split among the jobs, so their number must be given
+  if (njobs > 1 && nevents <= 0) {
+    G4cerr << "ERROR: --jobs requires a positive number of events (--nevents)." << G4endl;
+    PrintUsage();
+  }
+
   ////////////////////////////////////////////////////////////////////
 
   G4SteppingVerbose::UseBestUnit(precision);
@@ -120,8 +281,10 @@ G4int main(int argc, char** argv)
     G4StateManager::GetStateManager()->SetExceptionHandler(new NexusExceptionHandler());
   }
 
-  NexusApp* app = new NexusApp(macro_filename);
-  app->Initialize();
+  NexusApp* app = new NexusApp(macro_filename, nthreads, subevent_size);
+
+  // In job mode, the output file of each job is opened after forking
+  app->Initialize(njobs == 1);
 
   G4UImanager* UI = G4UImanager::GetUIpointer();
 
@@ -130,6 +293,16 @@ G4int main(int argc, char** argv)
     UI->ApplyCommand("/geometry/test/run");
   }
 
+  if (njobs > 1) {
+    // Build the physics tables before forking, so that
+    // the jobs share them (copy-on-write) instead of each one
+    // building its own
+    app->BeamOn(0);
+    G4int status = RunJobs(app, njobs, nevents, merge);
+    delete app;
+    return status;
+  }
+
   // if (seed < 0) CLHEP::HepRandom::setTheSeed(time(0));
   // else CLHEP::HepRandom::setTheSeed(seed);
 
@@ -0,0 +1,247 @@
+// ----------------------------------------------------------------------------
+// nexus | HDF5Merger.cc
+//
+// This class merges the h5 nexus output files of several jobs of the same
+// production into a single file. The event tables are concatenated, the
+// configuration is taken from the first file (adding up the event counters)
+// and the sensor positions are merged.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "HDF5Merger.h"
+#include "hdf5_functions.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+
+using namespace nexus;
+
+
+namespace {
+
+  // Configuration parameters that are counters of events of each job
+  const std::set<std::string> summed_keys =
+    {"num_events", "saved_events", "interacting_events",
+     "aborted_events_energy", "aborted_events_veto",
+     "muon_bias_trials", "muon_bias_accepted"};
+
+  // Number of rows copied at once when concatenating tables
+  const hsize_t block_rows = 32768;
+
+  hsize_t NumberOfRows(hid_t dataset)
+  {
+    hid_t space = H5Dget_space(dataset);
+    hsize_t dims[1] = {0};
+    H5Sget_simple_extent_dims(space, dims, NULL);
+    H5Sclose(space);
+    return dims[0];
+  }
+
+  void ReadRows(hid_t dataset, hid_t memtype, hsize_t first, hsize_t n, void* buffer)
+  {
+    hsize_t count[1] = {n};
+    hid_t memspace = H5Screate_simple(1, count, NULL);
+    hid_t file_space = H5Dget_space(dataset);
+    hsize_t start[1] = {first};
+    H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+    H5Dread(dataset, memtype, memspace, file_space, H5P_DEFAULT, buffer);
+    H5Sclose(file_space);
+    H5Sclose(memspace);
+  }
+
+  void AppendRows(hid_t dataset, hid_t memtype, hsize_t first, hsize_t n, const void* buffer)
+  {
+    hsize_t dims[1] = {first + n};
+    H5Dset_extent(dataset, dims);
+
+    hsize_t count[1] = {n};
+    hid_t memspace = H5Screate_simple(1, count, NULL);
+    hid_t file_space = H5Dget_space(dataset);
+    hsize_t start[1] = {first};
+    H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+    H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, buffer);
+    H5Sclose(file_space);
+    H5Sclose(memspace);
+  }
+
+
+  void MergeConfiguration(const std::vector<hid_t>& inputs, hid_t group)
+  {
+    hsize_t memtype = createRunType();
+
+    // Configuration of the first file, keeping the original order of the keys
+    std::vector<run_info_t> rows;
+    std::map<std::string, long long> counters;
+
+    for (size_t i=0; i<inputs.size(); ++i) {
+      if (H5Lexists(inputs[i], "/MC/configuration", H5P_DEFAULT) <= 0) continue;
+      hid_t dataset = H5Dopen(inputs[i], "/MC/configuration", H5P_DEFAULT);
+
+      hsize_t n = NumberOfRows(dataset);
+      std::vector<run_info_t> buffer(n);
+      if (n > 0) ReadRows(dataset, memtype, 0, n, buffer.data());
+      H5Dclose(dataset);
+
+      for (const auto& row: buffer) {
+        std::string key(row.param_key);
+        if (summed_keys.count(key))
+          counters[key] += std::atoll(row.param_value);
+      }
+      if (i == 0) rows = buffer;
+    }
+
+    std::string table_name = "configuration";
+    hid_t table = createTable(group, table_name, memtype);
+
+    hsize_t irow = 0;
+    for (auto& row: rows) {
+      std::string key(row.param_key);
+      if (summed_keys.count(key)) {
+        std::string value = std::to_string(counters[key]);
+        memset(row.param_value, 0, CONFLEN);
+        strcpy(row.param_value, value.c_str());
+      }
+      writeRun(&row, table, memtype, irow++);
+    }
+
+    H5Dclose(table);
+  }
+
+  void MergeSensorPositions(const std::vector<hid_t>& inputs, hid_t group)
+  {
+    hsize_t memtype = createSensorPosType();
+
+    std::string table_name = "sns_positions";
+    hid_t table = createTable(group, table_name, memtype);
+
+    // Each job only stores the sensors that were hit
+    std::set<unsigned int> ids;
+    hsize_t irow = 0;
+
+    for (hid_t file: inputs) {
+      if (H5Lexists(file, "/MC/sns_positions", H5P_DEFAULT) <= 0) continue;
+      hid_t dataset = H5Dopen(file, "/MC/sns_positions", H5P_DEFAULT);
+
+      hsize_t n = NumberOfRows(dataset);
+      std::vector<sns_pos_t> buffer(n);
+      if (n > 0) ReadRows(dataset, memtype, 0, n, buffer.data());
+      H5Dclose(dataset);
+
+      for (auto& row: buffer) {
+        if (!ids.insert(row.sensor_id).second) continue;
+        writeSnsPos(&row, table, memtype, irow++);
+      }
+    }
+
+    H5Dclose(table);
+  }
+
+  void ConcatenateTable(const std::vector<hid_t>& inputs, hid_t group,
+                        const std::string& path, const std::string& name)
+  {
+    const std::string full_name = path + name;
+    if (H5Lexists(inputs[0], full_name.c_str(), H5P_DEFAULT) <= 0) return;
+
+    // The rows are copied as they are stored in the first file,
+    // whichever the type of the table is
+    hid_t first = H5Dopen(inputs[0], full_name.c_str(), H5P_DEFAULT);
+    hid_t type = H5Dget_type(first);
+    H5Dclose(first);
+
+    size_t row_size = H5Tget_size(type);
+    std::string table_name = name;
+    hid_t table = createTable(group, table_name, type);
+
+    std::vector<char> buffer(block_rows * row_size);
+    hsize_t irow = 0;
+
+    for (hid_t file: inputs) {
+      if (H5Lexists(file, full_name.c_str(), H5P_DEFAULT) <= 0) continue;
+      hid_t dataset = H5Dopen(file, full_name.c_str(), H5P_DEFAULT);
+
+      hsize_t n = NumberOfRows(dataset);
+      for (hsize_t i=0; i<n; i+=block_rows) {
+        hsize_t nrows = std::min(block_rows, n - i);
+        ReadRows(dataset, type, i, nrows, buffer.data());
+        AppendRows(table, type, irow, nrows, buffer.data());
+        irow += nrows;
+      }
+      H5Dclose(dataset);
+    }
+
+    H5Dclose(table);
+    H5Tclose(type);
+  }
+
+}
+
+
+HDF5Merger::HDF5Merger()
+{
+}
+
+HDF5Merger::~HDF5Merger()
+{
+}
+
+bool HDF5Merger::Merge(const std::vector<std::string>& input_files,
+                       const std::string& output_file)
+{
+  error_ = "";
+
+  if (input_files.empty()) {
+    error_ = "No files to merge.";
+    return false;
+  }
+
+  std::vector<hid_t> inputs;
+  for (const auto& name: input_files) {
+    hid_t file = H5Fopen(name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file < 0) {
+      error_ = "Cannot open " + name;
+      break;
+    }
+    // Names are mapped to integers independently in each file,
+    // so files written without strings cannot be concatenated
+    if (H5Lexists(file, "/MC/string_map", H5P_DEFAULT) > 0) {
+      error_ = name + " stores names as integers (save_strings false) and cannot be merged";
+      H5Fclose(file);
+      break;
+    }
+    inputs.push_back(file);
+  }
+
+  if (!error_.empty()) {
+    for (hid_t file: inputs) H5Fclose(file);
+    return false;
+  }
+
+  hid_t output = H5Fcreate(output_file.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+
+  std::string group_name = "/MC";
+  hid_t group = createGroup(output, group_name);
+
+  MergeConfiguration(inputs, group);
+  MergeSensorPositions(inputs, group);
+  ConcatenateTable(inputs, group, "/MC/", "sns_response");
+  ConcatenateTable(inputs, group, "/MC/", "hits");
+  ConcatenateTable(inputs, group, "/MC/", "particles");
+  ConcatenateTable(inputs, group, "/MC/", "event_weights");
+  H5Gclose(group);
+
+  if (H5Lexists(inputs[0], "/DEBUG", H5P_DEFAULT) > 0) {
+    std::string debug_group_name = "/DEBUG";
+    hid_t debug_group = createGroup(output, debug_group_name);
+    ConcatenateTable(inputs, debug_group, "/DEBUG/", "steps");
+    H5Gclose(debug_group);
+  }
+
+  H5Fclose(output);
+  for (hid_t file: inputs) H5Fclose(file);
+
+  return true;
+}
@@ -0,0 +1,44 @@
+// ----------------------------------------------------------------------------
+// nexus | HDF5Merger.h
+//
+// This class merges the h5 nexus output files of several jobs of the same
+// production into a single file. The event tables are concatenated, the
+// configuration is taken from the first file (adding up the event counters)
+// and the sensor positions are merged.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef HDF5MERGER_H
+#define HDF5MERGER_H
+
+#include <string>
+#include <vector>
+
+namespace nexus {
+
+  class HDF5Merger {
+
+  public:
+    /// constructor
+    HDF5Merger();
+    /// destructor
+    ~HDF5Merger();
+
+    /// Merge the input files into the output file. Returns false
+    /// (and sets the error message) if the files cannot be merged.
+    bool Merge(const std::vector<std::string>& input_files,
+               const std::string& output_file);
+
+    /// Description of the last error
+    const std::string& GetError() const;
+
+  private:
+    std::string error_;
+  };
+
+  inline const std::string& HDF5Merger::GetError() const { return error_; }
+
+} // namespace nexus
+
+#endif
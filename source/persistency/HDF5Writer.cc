@@ -15,13 +15,20 @@
 
 #include <stdint.h>
 #include <iostream>
+#include <mutex>
 
 using namespace nexus;
 
+namespace {
+  // The HDF5 library is not guaranteed to be thread-safe, so all the
+  // writers (one per worker thread in multithreaded mode) share a lock
+  std::mutex h5_mutex;
+}
+
 
 HDF5Writer::HDF5Writer():
-  file_(0), irun_(0), ismp_(0), ihit_(0),
-  ipart_(0), ipos_(0), istep_(0), istrmap_(0)
+  file_(0), group_(0), isOpen_(false), evtWeightTable_(0), irun_(0), ismp_(0), ihit_(0),
+  ipart_(0), ipos_(0), istep_(0), istrmap_(0), iweight_(0)
 {
 }
 
@@ -31,6 +38,8 @@ HDF5Writer::~HDF5Writer()
 
 void HDF5Writer::Open(std::string fileName, bool debug, bool save_str)
 {
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
   firstEvent_= true;
 
   file_ = H5Fcreate( fileName.c_str(), H5F_ACC_TRUNC,
@@ -38,6 +47,7 @@ void HDF5Writer::Open(std::string fileName, bool debug, bool save_str)
 
   std::string group_name = "/MC";
   size_t group = createGroup(file_, group_name);
+  group_ = group;
 
   std::string run_table_name = "configuration";
   memtypeRun_ = createRunType();
@@ -59,6 +69,11 @@ void HDF5Writer::Open(std::string fileName, bool debug, bool save_str)
   memtypeSnsPos_ = createSensorPosType();
   snsPosTable_ = createTable(group, sns_pos_table_name, memtypeSnsPos_);
 
+  // The event weights table is only created if weights are written
+  memtypeEvtWeight_ = createEventWeightType();
+  evtWeightTable_ = 0;
+  iweight_ = 0;
+
   if (!save_str) {
     std::string str_map_table_name = "string_map";
     memtypeStringMap_ = createStringMapType();
@@ -78,12 +93,16 @@ void HDF5Writer::Open(std::string fileName, bool debug, bool save_str)
 
 void HDF5Writer::Close()
 {
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
   isOpen_=false;
   H5Fclose(file_);
 }
 
 void HDF5Writer::WriteRunInfo(const char* param_key, const char* param_value)
 {
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
   run_info_t runData;
   memset(runData.param_key,   0, CONFLEN);
   memset(runData.param_value, 0, CONFLEN);
@@ -97,6 +116,8 @@ void HDF5Writer::WriteRunInfo(const char* param_key, const char* param_value)
 
 void HDF5Writer::WriteSensorDataInfo(int64_t evt_number, unsigned int sensor_id, unsigned int time_bin, unsigned int charge)
 {
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
   sns_data_t snsData;
   snsData.event_id = evt_number;
   snsData.sensor_id = sensor_id;
@@ -107,8 +128,10 @@ void HDF5Writer::WriteSensorDataInfo(int64_t evt_number, unsigned int sensor_id,
   ismp_++;
 }
 
-void HDF5Writer::WriteHitInfo(bool str, int64_t evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, const char* label_str, int label)
+void HDF5Writer::WriteHitInfo(bool str, int64_t evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, const char* label_str, int label, float weight)
 {
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
   hit_info_t trueInfo;
   trueInfo.event_id = evt_number;
   trueInfo.x = hit_position_x;
@@ -124,13 +147,16 @@ void HDF5Writer::WriteHitInfo(bool str, int64_t evt_number, int particle_indx, i
   }
   trueInfo.particle_id = particle_indx;
   trueInfo.hit_id = hit_indx;
+  trueInfo.weight = weight;
   writeHit(&trueInfo,  hitInfoTable_, memtypeHitInfo_, ihit_);
 
   ihit_++;
 }
 
-void HDF5Writer::WriteParticleInfo(bool str, int64_t evt_number, int particle_indx, const char* particle_name_str, int particle_name, char primary, int mother_id, float initial_vertex_x, float initial_vertex_y, float initial_vertex_z, float initial_vertex_t, float final_vertex_x, float final_vertex_y, float final_vertex_z, float final_vertex_t, const char* initial_volume_str, const char* final_volume_str, int initial_volume, int final_volume, float ini_momentum_x, float ini_momentum_y, float ini_momentum_z, float final_momentum_x, float final_momentum_y, float final_momentum_z, float kin_energy, float length, const char* creator_proc_str, const char* final_proc_str, int creator_proc, int final_proc)
+void HDF5Writer::WriteParticleInfo(bool str, int64_t evt_number, int particle_indx, const char* particle_name_str, int particle_name, char primary, int mother_id, float initial_vertex_x, float initial_vertex_y, float initial_vertex_z, float initial_vertex_t, float final_vertex_x, float final_vertex_y, float final_vertex_z, float final_vertex_t, const char* initial_volume_str, const char* final_volume_str, int initial_volume, int final_volume, float ini_momentum_x, float ini_momentum_y, float ini_momentum_z, float final_momentum_x, float final_momentum_y, float final_momentum_z, float kin_energy, float length, const char* creator_proc_str, const char* final_proc_str, int creator_proc, int final_proc, float weight)
 {
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
   particle_info_t trueInfo;
   trueInfo.event_id = evt_number;
   trueInfo.particle_id = particle_indx;
@@ -176,6 +202,7 @@ void HDF5Writer::WriteParticleInfo(bool str, int64_t evt_number, int particle_in
     trueInfo.creator_proc = creator_proc;
     trueInfo.final_proc = final_proc;
   }
+  trueInfo.weight = weight;
   writeParticle(&trueInfo,  particleInfoTable_, memtypeParticleInfo_, ipart_);
 
   ipart_++;
@@ -183,6 +210,8 @@ void HDF5Writer::WriteParticleInfo(bool str, int64_t evt_number, int particle_in
 
 void HDF5Writer::WriteSensorPosInfo(unsigned int sensor_id, const char* sensor_name, float x, float y, float z)
 {
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
   sns_pos_t snsPos;
   snsPos.sensor_id = sensor_id;
   memset(snsPos.sensor_name, 0, STRLEN);
@@ -205,6 +234,8 @@ void HDF5Writer::WriteStep(int64_t evt_number,
                            float   final_x, float   final_y, float   final_z,
                            float time)
 {
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
   step_info_t step;
   step.event_id    = evt_number;
   step.particle_id = particle_id;
@@ -232,6 +263,8 @@ void HDF5Writer::WriteStep(int64_t evt_number,
 
 void HDF5Writer::WriteStringMapInfo(const char* name, int name_id)
 {
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
   string_map_t strmap;
   memset(strmap.name, 0, STRLEN);
   strcpy(strmap.name, name);
@@ -240,3 +273,29 @@ void HDF5Writer::WriteStringMapInfo(const char* name, int name_id)
   writeStringMap(&strmap, stringMapTable_, memtypeStringMap_, istrmap_);
   istrmap_++;
 }
+
+void HDF5Writer::WriteEventWeight(int64_t evt_number, double weight)
+{
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
+  if (!evtWeightTable_) {
+    std::string evt_weight_table_name = "event_weights";
+    evtWeightTable_ = createTable(group_, evt_weight_table_name, memtypeEvtWeight_);
+  }
+
+  event_weight_t evtWeight;
+  evtWeight.event_id = evt_number;
+  evtWeight.weight   = weight;
+
+  writeEventWeight(&evtWeight, evtWeightTable_, memtypeEvtWeight_, iweight_);
+  iweight_++;
+}
+
+uint64_t HDF5Writer::GetFileSize()
+{
+  std::lock_guard<std::mutex> lock(h5_mutex);
+
+  hsize_t size = 0;
+  if (isOpen_) H5Fget_filesize(file_, &size);
+  return size;
+}
@@ -32,8 +32,8 @@ namespace nexus {
 
     void WriteRunInfo(const char* param_key, const char* param_value);
     void WriteSensorDataInfo(int64_t evt_number, unsigned int sensor_id, unsigned int time_bin, unsigned int charge);
-    void WriteHitInfo(bool str, int64_t evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, const char* label_str, int label);
-    void WriteParticleInfo(bool str, int64_t evt_number, int particle_indx, const char* particle_name_str, int particle_name, char primary, int mother_id, float initial_vertex_x, float initial_vertex_y, float initial_vertex_z, float initial_vertex_t, float final_vertex_x, float final_vertex_y, float final_vertex_z, float final_vertex_t, const char* initial_volume_str, const char* final_volume_str, int initial_volume, int final_volume, float ini_momentum_x, float ini_momentum_y, float ini_momentum_z, float final_momentum_x, float final_momentum_y, float final_momentum_z, float kin_energy, float length, const char* creator_proc_str, const char* final_proc_str, int creator_proc, int final_proc);
+    void WriteHitInfo(bool str, int64_t evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, const char* label_str, int label, float weight);
+    void WriteParticleInfo(bool str, int64_t evt_number, int particle_indx, const char* particle_name_str, int particle_name, char primary, int mother_id, float initial_vertex_x, float initial_vertex_y, float initial_vertex_z, float initial_vertex_t, float final_vertex_x, float final_vertex_y, float final_vertex_z, float final_vertex_t, const char* initial_volume_str, const char* final_volume_str, int initial_volume, int final_volume, float ini_momentum_x, float ini_momentum_y, float ini_momentum_z, float final_momentum_x, float final_momentum_y, float final_momentum_z, float kin_energy, float length, const char* creator_proc_str, const char* final_proc_str, int creator_proc, int final_proc, float weight);
     void WriteSensorPosInfo(unsigned int sensor_id, const char* sensor_name, float x, float y, float z);
     void WriteStep(int64_t evt_number,
                    int particle_id, const char* particle_name,
@@ -45,9 +45,16 @@ namespace nexus {
                    float   final_x, float   final_y, float   final_z,
                    float time);
     void WriteStringMapInfo(const char* name, int name_id);
+    /// Write the weight of an event. The event weights
+    /// table is created with the first one.
+    void WriteEventWeight(int64_t evt_number, double weight);
+
+    /// size of the file, in bytes (0 if it is not open)
+    uint64_t GetFileSize();
 
   private:
     size_t file_; ///< HDF5 file
+    size_t group_; ///< MC group
 
     bool isOpen_;
     bool firstEvent_; ///< First event
@@ -60,6 +67,7 @@ namespace nexus {
     size_t snsPosTable_;
     size_t stepTable_;
     size_t stringMapTable_;
+    size_t evtWeightTable_;
 
     size_t memtypeRun_;
     size_t memtypeSnsData_;
@@ -68,6 +76,7 @@ namespace nexus {
     size_t memtypeSnsPos_;
     size_t memtypeStep_;
     size_t memtypeStringMap_;
+    size_t memtypeEvtWeight_;
 
     size_t irun_; ///< counter for configuration parameters
     size_t ismp_; ///< counter for written waveform samples
@@ -76,6 +85,7 @@ namespace nexus {
     size_t ipos_; ///< counter for sensor positions
     size_t istep_; ///< counter for steps
     size_t istrmap_;  ///< counter for string map
+    size_t iweight_;  ///< counter for event weights
 
   };
 
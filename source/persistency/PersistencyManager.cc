@@ -13,22 +13,29 @@
 #include "TrajectoryMap.h"
 #include "IonizationSD.h"
 #include "SensorSD.h"
-#include "NexusApp.h"
 #include "DetectorConstruction.h"
 #include "SaveAllSteppingAction.h"
 #include "GeometryBase.h"
 #include "HDF5Writer.h"
 #include "PersistencyManagerBase.h"
 #include "FactoryBase.h"
+#include "EventAbortManager.h"
+#include "StartupProfiler.h"
+#include "Electroluminescence.h"
+#include "IonizationElectron.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4Event.hh>
+#include <G4PrimaryVertex.hh>
 #include <G4TrajectoryContainer.hh>
 #include <G4Trajectory.hh>
 #include <G4SDManager.hh>
 #include <G4HCtable.hh>
 #include <G4RunManager.hh>
 #include <G4Run.hh>
+#include <G4Threading.hh>
+#include <G4ProcessTable.hh>
+#include <G4AccumulableManager.hh>
 
 #include <string>
 #include <sstream>
@@ -44,10 +51,11 @@ REGISTER_CLASS(PersistencyManager, PersistencyManagerBase)
 PersistencyManager::PersistencyManager():
 PersistencyManagerBase(), msg_(0), output_file_("nexus_out"), ready_(false),
   store_evt_(true), store_steps_(false),
-  interacting_evt_(false), save_ie_numb_(false), event_type_("other"),
-  saved_evts_(0), interacting_evts_(0), pmt_bin_size_(-1), sipm_bin_size_(-1),
+  interacting_evt_(false), save_ie_numb_(false), save_weights_(false), event_type_("other"),
+  saved_evts_("Events saved", 0), interacting_evts_("Events interacting in ACTIVE", 0),
+  pmt_bin_size_(-1), sipm_bin_size_(-1),
   nevt_(0), start_id_(0), first_evt_(true), h5writer_(0),
-  str_counter_(0), save_str_(true), particles_(true)
+  str_counter_(0), save_str_(true), particles_(true), telemetry_interval_(0.)
 {
   msg_ = new G4GenericMessenger(this, "/nexus/persistency/");
   msg_->DeclareProperty("output_file", output_file_, "Path of output file.");
@@ -60,6 +68,15 @@ PersistencyManagerBase(), msg_(0), output_file_("nexus_out"), ready_(false),
   msg_->DeclareProperty("save_particles", particles_,
                         "True if particles table is saved.");
 
+  G4GenericMessenger::Command& telemetry_cmd =
+    msg_->DeclarePropertyWithUnit("telemetry_interval", "s", telemetry_interval_,
+                                  "Time between updates of the status file of the run (0 = no file).");
+  telemetry_cmd.SetParameterName("telemetry_interval", false);
+  telemetry_cmd.SetRange("telemetry_interval>=0.");
+
+  msg_->DeclareProperty("telemetry_file", telemetry_file_,
+                        "Path (without extension) of the status file of the run (default: output file + .status).");
+
   init_macro_ = "";
   macros_.clear();
   delayed_macros_.clear();
@@ -81,8 +98,18 @@ void PersistencyManager::OpenFile()
   // If the output file was not set yet, do so
   if (!h5writer_) {
     h5writer_ = new HDF5Writer();
-    G4String hdf5file = output_file_ + ".h5";
+    // In multithreaded mode, each worker thread writes its own file
+    G4String hdf5file = output_file_;
+    if (G4Threading::IsWorkerThread())
+      hdf5file += "_t" + std::to_string(G4Threading::G4GetThreadId());
+    hdf5file += ".h5";
     h5writer_->Open(hdf5file, store_steps_, save_str_);
+
+    G4String status_file = telemetry_file_ != "" ? telemetry_file_ : output_file_ + ".status";
+    if (G4Threading::IsWorkerThread())
+      status_file += "_t" + std::to_string(G4Threading::G4GetThreadId());
+    telemetry_.Configure(status_file + ".json", telemetry_interval_/second,
+                         [this]() { return GetTelemetryCounters(); });
     return;
   } else {
     G4Exception("[PersistencyManager]", "OpenFile()",
@@ -101,14 +128,39 @@ void PersistencyManager::CloseFile()
 
 
 
+void PersistencyManager::RegisterCounters()
+{
+  // The counters are printed, summed over all threads,
+  // by the run action of the master at the end of the run
+  G4AccumulableManager* accumulables = G4AccumulableManager::Instance();
+  accumulables->RegisterAccumulable(saved_evts_);
+  accumulables->RegisterAccumulable(interacting_evts_);
+}
+
+
+
 G4bool PersistencyManager::Store(const G4Event* event)
 {
+  G4bool stored = StoreEvent(event);
+
+  if (telemetry_.IsEnabled())
+    telemetry_.EndOfEvent(G4RunManager::GetRunManager()->GetCurrentRun());
+
+  return stored;
+}
+
+
+
+G4bool PersistencyManager::StoreEvent(const G4Event* event)
+{
+  // The trajectories are not looked up by track ID beyond this point
+  TrajectoryMap::EndEvent();
+
   if (interacting_evt_) {
-    interacting_evts_++;
+    interacting_evts_ += 1;
   }
 
   if (!store_evt_) {
-    TrajectoryMap::Clear();
     if (store_steps_) {
       SaveAllSteppingAction* sa = (SaveAllSteppingAction*)
         G4RunManager::GetRunManager()->GetUserSteppingAction();
@@ -117,13 +169,19 @@ G4bool PersistencyManager::Store(const G4Event* event)
     return false;
   }
 
-  saved_evts_++;
+  saved_evts_ += 1;
 
   if (first_evt_) {
     first_evt_ = false;
     nevt_ = start_id_;
+    if (!save_weights_) save_weights_ = WeightingActive();
   }
 
+  // Events are distributed among the worker threads in multithreaded mode,
+  // so the event number is taken from the Geant4 event ID to keep it unique
+  if (G4Threading::IsWorkerThread())
+    nevt_ = start_id_ + event->GetEventID();
+
   if (store_steps_)
     StoreSteps();
 
@@ -137,15 +195,40 @@ G4bool PersistencyManager::Store(const G4Event* event)
   hit_map_.clear();
   StoreHits(event->GetHCofThisEvent());
 
+  // Weight of the event as set by the primary generator. The tracks
+  // split or killed by variance reduction carry their own weights.
+  if (save_weights_) {
+    G4double weight = 1.;
+    if (G4PrimaryVertex* vertex = event->GetPrimaryVertex()) {
+      weight = vertex->GetWeight();
+      if (vertex->GetPrimary()) weight *= vertex->GetPrimary()->GetWeight();
+    }
+    h5writer_->WriteEventWeight(nevt_, weight);
+  }
+
   nevt_++;
 
-  TrajectoryMap::Clear();
   StoreCurrentEvent(true);
 
   return true;
 }
 
 
+G4bool PersistencyManager::WeightingActive() const
+{
+  G4ProcessTable* processes = G4ProcessTable::GetProcessTable();
+
+  // The importance biasing adds its process to the biased particles
+  for (const G4String& name: *processes->GetNameList())
+    if (name == "ImportanceProcess") return true;
+
+  const Electroluminescence* el = dynamic_cast<const Electroluminescence*>
+    (processes->FindProcess("Electroluminescence", IonizationElectron::Definition()));
+
+  return el && el->GetPhotonFraction() < 1.;
+}
+
+
 void PersistencyManager::StoreTrajectories(G4TrajectoryContainer* tc)
 {
   // If the pointer is null, no trajectories were stored in this event
@@ -210,7 +293,8 @@ void PersistencyManager::StoreTrajectories(G4TrajectoryContainer* tc)
                                  (float)final_mom.y(), (float)final_mom.z(),
 				 kin_energy, length, creator_proc.c_str(),
                                  final_proc.c_str(),
-                                 (int)creatpr_id, (int)finpr_id);
+                                 (int)creatpr_id, (int)finpr_id,
+                                 (float)trj->GetWeight());
 
   }
 }
@@ -282,7 +366,7 @@ void PersistencyManager::StoreIonizationHits(G4VHitsCollection* hc)
     h5writer_->WriteHitInfo(save_str_, nevt_, trackid,  ihits_->size() - 1,
 			    xyz[0], xyz[1], xyz[2],
 			    hit->GetTime(), hit->GetEnergyDeposit(),
-                            sdname.c_str(), sdname_id);
+                            sdname.c_str(), sdname_id, hit->GetWeight());
   }
 }
 
@@ -377,26 +461,42 @@ void PersistencyManager::StoreSteps()
   sa->Reset();
 }
 
-G4bool PersistencyManager::Store(const G4Run*)
+G4bool PersistencyManager::Store(const G4Run* run)
 {
+  if (!h5writer_) return false;
+
   // Store the event type
   G4String key = "event_type";
   h5writer_->WriteRunInfo(key, event_type_.c_str());
 
   // Store the number of events to be processed
-  NexusApp* app = (NexusApp*) G4RunManager::GetRunManager();
-  G4int num_events = app->GetNumberOfEventsToBeProcessed();
+  G4int num_events = run->GetNumberOfEventToBeProcessed();
 
   key = "num_events";
   h5writer_->WriteRunInfo(key,  std::to_string(num_events).c_str());
   key = "saved_events";
-  h5writer_->WriteRunInfo(key,  std::to_string(saved_evts_).c_str());
+  h5writer_->WriteRunInfo(key,  std::to_string(saved_evts_.GetValue()).c_str());
 
   if (save_ie_numb_) {
     key = "interacting_events";
-    h5writer_->WriteRunInfo(key,  std::to_string(interacting_evts_).c_str());
+    h5writer_->WriteRunInfo(key,  std::to_string(interacting_evts_.GetValue()).c_str());
+  }
+
+  const EventAbortManager& abort_mgr = EventAbortManager::Instance();
+  if (abort_mgr.IsEnabled()) {
+    key = "aborted_events_energy";
+    h5writer_->WriteRunInfo(key, std::to_string(abort_mgr.GetAbortedByEnergy()).c_str());
+    key = "aborted_events_veto";
+    h5writer_->WriteRunInfo(key, std::to_string(abort_mgr.GetAbortedByVeto()).c_str());
   }
 
+  for (const auto& counter: run_counters_)
+    h5writer_->WriteRunInfo(counter.first, std::to_string(counter.second).c_str());
+
+  // Store the time and memory used by each stage of the start-up
+  for (const auto& stage: StartupProfiler::Instance().GetSummary())
+    h5writer_->WriteRunInfo(stage.first, stage.second.c_str());
+
   // Store sensor time binning
   std::map<G4String, G4double>::const_iterator it;
   for (it = sensdet_bin_.begin(); it != sensdet_bin_.end(); ++it) {
@@ -428,10 +528,21 @@ G4bool PersistencyManager::Store(const G4Run*)
     }
   }
 
+  if (telemetry_.IsEnabled())
+    telemetry_.EndOfRun(run);
 
   return true;
 }
 
+
+
+RunTelemetry::Counters PersistencyManager::GetTelemetryCounters() const
+{
+  return {saved_evts_.GetValue(), interacting_evts_.GetValue(), h5writer_ ? h5writer_->GetFileSize() : 0};
+}
+
+
+
 void PersistencyManager::SaveConfigurationInfo(G4String file_name)
 {
   std::ifstream history(file_name, std::ifstream::in);
@@ -11,8 +11,10 @@
 #define PERSISTENCY_MANAGER_H
 
 #include "PersistencyManagerBase.h"
+#include "RunTelemetry.h"
 
 #include <G4VPersistencyManager.hh>
+#include <G4Accumulable.hh>
 #include <map>
 #include <vector>
 
@@ -45,6 +47,14 @@ namespace nexus {
     void InteractingEvent(G4bool);
     void StoreSteps(G4bool);
     void SaveNumbOfInteractingEvents(G4bool);
+    /// Set whether to save the generator weight of each event
+    /// (MC/event_weights). The weighted generators set it; otherwise,
+    /// it is set at the first saved event if the importance biasing
+    /// or the thinning of the EL photons is active.
+    void SaveEventWeights(G4bool);
+    /// Add to a counter saved in the configuration table at the
+    /// end of the run (e.g., the trials of a biased generator)
+    void AddToRunCounter(const G4String& key, int64_t n);
 
     ///
     virtual G4bool Store(const G4Event*);
@@ -58,18 +68,29 @@ namespace nexus {
   public:
     void OpenFile();
     void CloseFile();
+    void RegisterCounters();
+
+    /// Return the ID of a string in a string-to-ID map,
+    /// assigning it the next value of the counter if it is new
+    static G4int FindStringIDInMap(std::map<G4String, G4int>& vmap, G4String vol, G4int& counter);
 
 
   private:
+    G4bool StoreEvent(const G4Event*);
     void StoreTrajectories(G4TrajectoryContainer*);
     void StoreHits(G4HCofThisEvent*);
     void StoreIonizationHits(G4VHitsCollection*);
     void StoreSensorHits(G4VHitsCollection*);
     void StoreSteps();
 
+    /// Whether the importance biasing or the thinning
+    /// of the EL photons is active in this thread
+    G4bool WeightingActive() const;
+
     void SaveConfigurationInfo(G4String history);
 
-    G4int FindStringIDInMap(std::map<G4String, G4int>& vmap, G4String vol, G4int& counter);
+    /// Counters of the run reported by the telemetry
+    RunTelemetry::Counters GetTelemetryCounters() const;
 
 
   private:
@@ -83,11 +104,12 @@ namespace nexus {
     G4bool store_steps_; ///< Should we store the steps for the current event?
     G4bool interacting_evt_; ///< Has the current event interacted in ACTIVE?
     G4bool save_ie_numb_; ///< Should we save the number of interacting events in the configuration table?
+    G4bool save_weights_; ///< Should we save the weight of each event?
 
     G4String event_type_; ///< event type: bb0nu, bb2nu, background or not set
 
-    int64_t saved_evts_; ///< number of events to be saved
-    int64_t interacting_evts_; ///< number of events interacting in ACTIVE
+    G4Accumulable<G4long> saved_evts_; ///< number of events to be saved
+    G4Accumulable<G4long> interacting_evts_; ///< number of events interacting in ACTIVE
     G4double pmt_bin_size_, sipm_bin_size_; ///< bin width of sensors
 
     int64_t nevt_; ///< Event ID
@@ -106,6 +128,11 @@ namespace nexus {
     G4bool particles_; ///< Store particles table
 
     std::map<G4String, G4double> sensdet_bin_;
+    std::map<G4String, int64_t> run_counters_; ///< Counters for the configuration table
+
+    RunTelemetry telemetry_;
+    G4double telemetry_interval_; ///< Time between updates of the status file
+    G4String telemetry_file_;     ///< Path of the status file
   };
 
 
@@ -119,6 +146,10 @@ namespace nexus {
   { interacting_evt_ = ie; }
   inline void PersistencyManager::SaveNumbOfInteractingEvents(G4bool sie)
   {save_ie_numb_ = sie;}
+  inline void PersistencyManager::SaveEventWeights(G4bool sew)
+  { save_weights_ = sew; }
+  inline void PersistencyManager::AddToRunCounter(const G4String& key, int64_t n)
+  { run_counters_[key] += n; }
   inline G4bool PersistencyManager::Store(const G4VPhysicalVolume*)
   { return false; }
   inline G4bool PersistencyManager::Retrieve(G4Event*&)
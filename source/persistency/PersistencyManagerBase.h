@@ -14,6 +14,10 @@ class PersistencyManagerBase: public G4VPersistencyManager
     virtual void OpenFile() = 0;
     virtual void CloseFile() = 0;
 
+    /// Register the run counters as accumulables, so that the
+    /// counters of the worker threads are summed in the master
+    virtual void RegisterCounters() {}
+
     G4String init_macro_;
     std::vector<G4String> macros_;
     std::vector<G4String> delayed_macros_;
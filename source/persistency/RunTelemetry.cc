@@ -0,0 +1,152 @@
+// ----------------------------------------------------------------------------
+// nexus | RunTelemetry.cc
+//
+// This class writes periodically, while a run is in progress, a small
+// status file in JSON format with the events processed, the current and
+// average event rates, the estimated time to the end of the run, the
+// memory used by the process, the size of the output file and the number
+// of saved and interacting events. Batch systems and monitoring dashboards
+// may poll it, since it is replaced atomically.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "RunTelemetry.h"
+#include "StartupProfiler.h"
+
+#include <G4Run.hh>
+#include <G4Threading.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+
+namespace nexus {
+
+  RunTelemetry::RunTelemetry():
+    interval_(0.), run_id_(-1), nevents_(0), ndone_(0), ndone_last_(0)
+  {
+  }
+
+
+
+  RunTelemetry::~RunTelemetry()
+  {
+  }
+
+
+
+  void RunTelemetry::Configure(const G4String& filename, G4double interval,
+                               std::function<Counters()> counters)
+  {
+    filename_ = filename;
+    interval_ = interval;
+    counters_ = counters;
+  }
+
+
+
+  void RunTelemetry::EndOfEvent(const G4Run* run)
+  {
+    if (!IsEnabled() || !run) return;
+
+    Clock::time_point now = Clock::now();
+
+    if (run->GetRunID() != run_id_) {
+      // The rates are measured from the end of the first event,
+      // which includes the building of the physics tables
+      run_id_ = run->GetRunID();
+      nevents_ = run->GetNumberOfEventToBeProcessed();
+      // In multithreaded mode, the events are shared among the worker
+      // threads, each of them reporting in its own file
+      if (G4Threading::IsWorkerThread())
+        nevents_ /= std::max(1, G4Threading::GetNumberOfRunningWorkerThreads());
+      ndone_ = ndone_last_ = 0;
+      start_ = last_ = now;
+    }
+
+    ++ndone_;
+
+    if (std::chrono::duration<G4double>(now - last_).count() >= interval_)
+      Write(now, false);
+  }
+
+
+
+  void RunTelemetry::EndOfRun(const G4Run* run)
+  {
+    if (!IsEnabled() || !run || run->GetRunID() != run_id_) return;
+
+    Write(Clock::now(), true);
+    run_id_ = -1;
+  }
+
+
+
+  void RunTelemetry::Write(Clock::time_point now, G4bool finished)
+  {
+    const Counters counters = counters_ ? counters_() : Counters{0, 0, 0};
+
+    const G4double elapsed = std::chrono::duration<G4double>(now - start_).count();
+    const G4double interval = std::chrono::duration<G4double>(now - last_).count();
+
+    const G4double average_rate = elapsed > 0. ? (ndone_ - 1) / elapsed : 0.;
+    const G4double current_rate =
+      interval > 0. ? (ndone_ - ndone_last_) / interval : average_rate;
+    const G4double eta =
+      (!finished && average_rate > 0. && nevents_ > ndone_) ? (nevents_ - ndone_) / average_rate : 0.;
+
+    std::ostringstream status;
+    status << "{\n"
+           << "  \"run\": " << run_id_ << ",\n"
+           << "  \"finished\": " << (finished ? "true" : "false") << ",\n"
+           << "  \"events_done\": " << ndone_ << ",\n"
+           << "  \"events_to_process\": " << nevents_ << ",\n"
+           << "  \"events_per_second\": " << current_rate << ",\n"
+           << "  \"average_events_per_second\": " << average_rate << ",\n"
+           << "  \"eta_seconds\": " << eta << ",\n"
+           << "  \"elapsed_seconds\": " << elapsed << ",\n"
+           << "  \"rss_mb\": " << CurrentRSS() << ",\n"
+           << "  \"peak_rss_mb\": " << StartupProfiler::PeakRSS() << ",\n"
+           << "  \"output_bytes\": " << counters.output_bytes << ",\n"
+           << "  \"saved_events\": " << counters.saved_evts << ",\n"
+           << "  \"interacting_events\": " << counters.interacting_evts << ",\n"
+           << "  \"timestamp\": " << std::time(nullptr) << "\n"
+           << "}\n";
+
+    // The status is written to a temporary file that replaces the
+    // previous one, so that readers never find a partial file
+    const G4String tmp_filename = filename_ + ".tmp";
+    std::ofstream out(tmp_filename);
+    out << status.str();
+    out.close();
+
+    if (!out || std::rename(tmp_filename.c_str(), filename_.c_str()) != 0) {
+      G4String msg = "Cannot write the status file " + filename_;
+      G4Exception("[RunTelemetry]", "Write()", JustWarning, msg);
+    }
+
+    last_ = now;
+    ndone_last_ = ndone_;
+  }
+
+
+
+  G4double RunTelemetry::CurrentRSS()
+  {
+#ifdef __linux__
+    // The second field of statm is the number of resident pages
+    std::ifstream statm("/proc/self/statm");
+    long size = 0, resident = 0;
+    if (statm >> size >> resident)
+      return resident * (sysconf(_SC_PAGESIZE) / (1024. * 1024.));
+#endif
+    return StartupProfiler::PeakRSS();
+  }
+
+} // end namespace nexus
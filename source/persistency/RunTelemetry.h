@@ -0,0 +1,89 @@
+// ----------------------------------------------------------------------------
+// nexus | RunTelemetry.h
+//
+// This class writes periodically, while a run is in progress, a small
+// status file in JSON format with the events processed, the current and
+// average event rates, the estimated time to the end of the run, the
+// memory used by the process, the size of the output file and the number
+// of saved and interacting events. Batch systems and monitoring dashboards
+// may poll it, since it is replaced atomically.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef RUN_TELEMETRY_H
+#define RUN_TELEMETRY_H
+
+#include <globals.hh>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+class G4Run;
+
+
+namespace nexus {
+
+  class RunTelemetry
+  {
+  public:
+    /// Counters of the persistency manager reported in the status file
+    struct Counters {
+      int64_t saved_evts;
+      int64_t interacting_evts;
+      uint64_t output_bytes;
+    };
+
+  public:
+    /// Constructor
+    RunTelemetry();
+    /// Destructor
+    ~RunTelemetry();
+
+    /// Set the status file, the time between updates and the function
+    /// returning the counters, which is only called when the status
+    /// file is written. The telemetry is disabled if the interval is
+    /// not positive.
+    void Configure(const G4String& filename, G4double interval,
+                   std::function<Counters()> counters);
+
+    G4bool IsEnabled() const;
+
+    /// Count an event of the run, updating the status file
+    /// if the interval has elapsed since the last update
+    void EndOfEvent(const G4Run*);
+
+    /// Write the final status of the run
+    void EndOfRun(const G4Run*);
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    void Write(Clock::time_point now, G4bool finished);
+
+    /// Current resident memory of the process, in megabytes
+    /// (the peak one where the current one is not available)
+    static G4double CurrentRSS();
+
+  private:
+    G4String filename_;
+    G4double interval_; ///< Time between updates, in seconds
+    std::function<Counters()> counters_;
+
+    G4int run_id_;    ///< Run being monitored, -1 if none
+    G4int nevents_;   ///< Events to be processed (by this thread)
+    int64_t ndone_;   ///< Events processed
+    int64_t ndone_last_; ///< Events processed at the last update
+
+    Clock::time_point start_; ///< End of the first event of the run
+    Clock::time_point last_;  ///< Last update
+  };
+
+  // INLINE DEFINITIONS ////////////////////////////////////
+
+  inline G4bool RunTelemetry::IsEnabled() const { return interval_ > 0.; }
+
+} // namespace nexus
+
+#endif
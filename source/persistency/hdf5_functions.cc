@@ -53,6 +53,7 @@ hsize_t createHitInfoType(bool str)
   }
   H5Tinsert (memtype, "particle_id", HOFFSET (hit_info_t, particle_id), H5T_NATIVE_INT);
   H5Tinsert (memtype, "hit_id", HOFFSET (hit_info_t, hit_id), H5T_NATIVE_INT);
+  H5Tinsert (memtype, "weight", HOFFSET (hit_info_t, weight), H5T_NATIVE_FLOAT);
   return memtype;
 }
 
@@ -109,6 +110,7 @@ hsize_t createParticleInfoType(bool str)
     H5Tinsert (memtype, "creator_proc", HOFFSET (particle_info_t, creator_proc), H5T_NATIVE_INT);
     H5Tinsert (memtype, "final_proc", HOFFSET (particle_info_t, final_proc), H5T_NATIVE_INT);
   }
+  H5Tinsert (memtype, "weight", HOFFSET (particle_info_t, weight), H5T_NATIVE_FLOAT);
   return memtype;
 }
 
@@ -169,6 +171,15 @@ hsize_t createStringMapType()
   return memtype;
 }
 
+hsize_t createEventWeightType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof(event_weight_t));
+  H5Tinsert (memtype, "event_id", HOFFSET(event_weight_t, event_id), H5T_NATIVE_INT64);
+  H5Tinsert (memtype, "weight"  , HOFFSET(event_weight_t, weight  ), H5T_NATIVE_DOUBLE);
+  return memtype;
+}
+
 hid_t createTable(hid_t group, std::string& table_name, hsize_t memtype)
 {
   //Create 1D dataspace (evt number). First dimension is unlimited (initially 0)
@@ -347,3 +358,23 @@ void writeStringMap(string_map_t* strmap, hid_t dataset, hid_t memtype, hsize_t
   H5Sclose(file_space);
   H5Sclose(memspace);
 }
+
+void writeEventWeight(event_weight_t* evtWeight, hid_t dataset, hid_t memtype, hsize_t counter)
+{
+  hid_t memspace, file_space;
+
+  const hsize_t n_dims = 1;
+  hsize_t dims[n_dims] = {1};
+  memspace = H5Screate_simple(n_dims, dims, NULL);
+
+  dims[0] = counter + 1;
+  H5Dset_extent(dataset, dims);
+
+  file_space = H5Dget_space(dataset);
+  hsize_t start[1] = {counter};
+  hsize_t count[1] = {1};
+  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, evtWeight);
+  H5Sclose(file_space);
+  H5Sclose(memspace);
+}
@@ -38,6 +38,7 @@
         int label;
         int particle_id;
         int hit_id;
+        float weight;
   } hit_info_t;
 
   typedef struct{
@@ -71,8 +72,14 @@
 	char final_proc_str[STRLEN];
         int creator_proc;
         int final_proc;
+        float weight;
   } particle_info_t;
 
+  typedef struct{
+    int64_t event_id;
+    double weight;
+  } event_weight_t;
+
   typedef struct{
     unsigned int sensor_id;
     char sensor_name[STRLEN];
@@ -110,6 +117,7 @@ typedef struct{
   hsize_t createSensorPosType();
   hsize_t createStepType();
   hsize_t createStringMapType();
+  hsize_t createEventWeightType();
 
   hid_t createTable(hid_t group, std::string& table_name, hsize_t memtype);
   hid_t createGroup(hid_t file, std::string& groupName);
@@ -121,6 +129,7 @@ typedef struct{
   void writeSnsPos(sns_pos_t* snsPos, hid_t dataset, hid_t memtype, hsize_t counter);
   void writeStep(step_info_t* step, hid_t dataset, hid_t memtype, hsize_t counter);
   void writeStringMap(string_map_t* strmap, hid_t dataset, hid_t memtype, hsize_t counter);
+  void writeEventWeight(event_weight_t* evtWeight, hid_t dataset, hid_t memtype, hsize_t counter);
 
 
 #endif
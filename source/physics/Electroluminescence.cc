@@ -10,6 +10,7 @@
 
 #include "IonizationElectron.h"
 #include "BaseDriftField.h"
+#include "ThinningInformation.h"
 
 #include <G4MaterialPropertiesTable.hh>
 #include <G4ParticleChange.hh>
@@ -28,7 +29,7 @@ using namespace CLHEP;
 Electroluminescence::Electroluminescence(const G4String& process_name,
 					                               G4ProcessType type):
   G4VDiscreteProcess(process_name, type), theFastIntegralTable_(0),
-  table_generation_(false), photons_per_point_(0)
+  table_generation_(false), photons_per_point_(0), photon_fraction_(1.)
 {
   ParticleChange_ = new G4ParticleChange();
   pParticleChange = ParticleChange_;
@@ -43,6 +44,12 @@ Electroluminescence::Electroluminescence(const G4String& process_name,
   msg_->DeclareProperty("photons_per_point", photons_per_point_,
 			"Photon per point");
 
+  G4GenericMessenger::Command& fraction_cmd =
+    msg_->DeclareMethod("photon_fraction", &Electroluminescence::SetPhotonFraction,
+                        "Fraction of EL photons tracked (thinning).");
+  fraction_cmd.SetParameterName("photon_fraction", false);
+  fraction_cmd.SetRange("photon_fraction>0. && photon_fraction<=1.");
+
  }
 
 
@@ -54,6 +61,14 @@ Electroluminescence::~Electroluminescence()
 
 
 
+void Electroluminescence::SetPhotonFraction(G4double fraction)
+{
+  photon_fraction_ = fraction;
+  if (photon_fraction_ < 1.) ThinningInformation::EnableThinning();
+}
+
+
+
 G4bool Electroluminescence::IsApplicable(const G4ParticleDefinition& pdef)
 {
   return (pdef == *IonizationElectron::Definition());
@@ -84,8 +99,11 @@ Electroluminescence::PostStepDoIt(const G4Track& track, const G4Step& step)
   if (yield <= 0.)
     return G4VDiscreteProcess::PostStepDoIt(track, step);
 
-  // Generate a random number of photons around mean 'yield'
+  // Generate a random number of photons around mean 'yield'.
+  // Thinning a Poisson (or Gaussian with variance equal to the mean)
+  // number of photons by a fraction f is equivalent to scaling its mean by f.
   G4double mean = yield * step_length;
+  if (!table_generation_) mean *= photon_fraction_;
 
   G4int num_photons;
 
@@ -131,6 +149,11 @@ Electroluminescence::PostStepDoIt(const G4Track& track, const G4Step& step)
 
   G4double sc_max = spectrum_integral->GetMaxValue();
 
+  // Thinned photons are marked with their thinning weight,
+  // which is resampled into photon counts by the sensors
+  G4double thinning_weight = ThinningInformation::GetWeight(track);
+  if (!table_generation_) thinning_weight /= photon_fraction_;
+
   for (G4int i=0; i<num_photons; i++) {
     // Generate a random direction for the photon
     // (EL is supposed isotropic)
@@ -180,6 +203,8 @@ Electroluminescence::PostStepDoIt(const G4Track& track, const G4Step& step)
     // Create the track
     G4Track* secondary = new G4Track(photon, xyzt.t(), xyzt.v());
     secondary->SetParentID(track.GetTrackID());
+    if (thinning_weight != 1.)
+      secondary->SetUserInformation(new ThinningInformation(thinning_weight));
     ParticleChange_->AddSecondary(secondary);
 
   }
@@ -36,6 +36,10 @@ namespace nexus {
     /// secondaries at the end of the step.
     G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&);
 
+    /// Fraction of EL photons that are tracked (thinning if below 1)
+    G4double GetPhotonFraction() const;
+    void SetPhotonFraction(G4double);
+
   private:
 
     /// Returns infinity; i.e., the process does not limit the step,
@@ -56,8 +60,17 @@ namespace nexus {
 
     G4bool table_generation_;
     G4int photons_per_point_;
+
+    /// Fraction of EL photons that are actually tracked. Each tracked
+    /// photon is marked with a thinning weight equal to the inverse of it.
+    G4double photon_fraction_;
   };
 
+  // INLINE METHODS //////////////////////////////////////////////////
+
+  inline G4double Electroluminescence::GetPhotonFraction() const
+  { return photon_fraction_; }
+
 } // end namespace nexus
 
 #endif
@@ -0,0 +1,114 @@
+// ----------------------------------------------------------------------------
+// nexus | MeshTransmissionModel.cc
+//
+// Fast simulation model of the optical photons crossing a hexagonal mesh.
+// Instead of tracking them through the individual holes, the mesh is
+// replaced by a gas envelope where photons are transmitted, reflected or
+// absorbed with the angle-dependent probabilities of a MeshTransmissionTable.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "MeshTransmissionModel.h"
+
+#include "MeshTransmissionTable.h"
+
+#include <G4OpticalPhoton.hh>
+#include <G4VSolid.hh>
+#include <Randomize.hh>
+
+
+namespace nexus {
+
+
+  MeshTransmissionModel::MeshTransmissionModel(G4Region* region):
+    G4VFastSimulationModel("MeshTransmissionModel_" + region->GetName(), region),
+    table_(MeshTransmissionTable::Find(region))
+  {
+    if (!table_) {
+      G4String msg = "No mesh transmission table attached to region " + region->GetName();
+      G4Exception("[MeshTransmissionModel]", "MeshTransmissionModel()",
+                  FatalException, msg);
+    }
+  }
+
+
+
+  MeshTransmissionModel::~MeshTransmissionModel()
+  {
+  }
+
+
+
+  G4bool MeshTransmissionModel::IsApplicable(const G4ParticleDefinition& pdef)
+  {
+    return (&pdef == G4OpticalPhoton::Definition());
+  }
+
+
+
+  G4bool MeshTransmissionModel::ModelTrigger(const G4FastTrack& ftrack)
+  {
+    // Photons produced inside the envelope, or leaving it
+    // after being transmitted or reflected, are tracked normally
+    const G4VSolid* solid = ftrack.GetEnvelopeSolid();
+    G4ThreeVector pos = ftrack.GetPrimaryTrackLocalPosition();
+    G4ThreeVector dir = ftrack.GetPrimaryTrackLocalDirection();
+
+    if (solid->Inside(pos) != kSurface) return false;
+
+    return solid->SurfaceNormal(pos).dot(dir) < 0.;
+  }
+
+
+
+  void MeshTransmissionModel::DoIt(const G4FastTrack& ftrack, G4FastStep& fstep)
+  {
+    const G4Track* track = ftrack.GetPrimaryTrack();
+
+    G4ThreeVector pos = ftrack.GetPrimaryTrackLocalPosition();
+    G4ThreeVector dir = ftrack.GetPrimaryTrackLocalDirection();
+    G4ThreeVector pol = ftrack.GetPrimaryTrackLocalPolarization();
+
+    // The mesh lies on the xy plane of the envelope
+    G4double cos_theta = std::abs(dir.z());
+    G4double open = table_->GetOpenFraction(cos_theta);
+    G4double face = table_->GetFaceFraction(cos_theta);
+
+    G4double rnd = G4UniformRand();
+
+    if (rnd >= open) {
+      // The photon hits the metal, on the front face or on the walls
+      // of a hole (where a single reflection is assumed)
+      if (G4UniformRand() > table_->GetReflectivity(track->GetTotalEnergy())) {
+        fstep.KillPrimaryTrack();
+        return;
+      }
+
+      if (rnd < open + face) {
+        // Specular reflection back to the side it came from
+        dir.setZ(-dir.z());
+        pol.setX(-pol.x());
+        pol.setY(-pol.y());
+        fstep.ProposePrimaryTrackFinalMomentumDirection(dir, true);
+        fstep.ProposePrimaryTrackFinalPolarization(pol, true);
+        return;
+      }
+
+      dir.setX(-dir.x());
+      dir.setY(-dir.y());
+      pol.setZ(-pol.z());
+    }
+
+    // Move the photon to the other side of the envelope
+    G4double distance = ftrack.GetEnvelopeSolid()->DistanceToOut(pos, dir);
+
+    fstep.ProposePrimaryTrackFinalPosition(pos + distance * dir, true);
+    fstep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + distance / track->GetVelocity());
+    fstep.ProposePrimaryTrackPathLength(distance);
+    fstep.ProposePrimaryTrackFinalMomentumDirection(dir, true);
+    fstep.ProposePrimaryTrackFinalPolarization(pol, true);
+  }
+
+
+} // end namespace nexus
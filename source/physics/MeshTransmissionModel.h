@@ -0,0 +1,45 @@
+// ----------------------------------------------------------------------------
+// nexus | MeshTransmissionModel.h
+//
+// Fast simulation model of the optical photons crossing a hexagonal mesh.
+// Instead of tracking them through the individual holes, the mesh is
+// replaced by a gas envelope where photons are transmitted, reflected or
+// absorbed with the angle-dependent probabilities of a MeshTransmissionTable.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef MESH_TRANSMISSION_MODEL_H
+#define MESH_TRANSMISSION_MODEL_H
+
+#include <G4VFastSimulationModel.hh>
+
+
+namespace nexus {
+
+  class MeshTransmissionTable;
+
+  class MeshTransmissionModel: public G4VFastSimulationModel
+  {
+  public:
+    /// Constructor. The region must have a MeshTransmissionTable registered.
+    MeshTransmissionModel(G4Region* region);
+    /// Destructor
+    ~MeshTransmissionModel();
+
+    // This model is only valid for optical photons
+    G4bool IsApplicable(const G4ParticleDefinition&);
+
+    // Triggered by photons entering the envelope through its surface
+    G4bool ModelTrigger(const G4FastTrack&);
+
+    // Transmit, reflect or absorb the photon
+    void DoIt(const G4FastTrack&, G4FastStep&);
+
+  private:
+    const MeshTransmissionTable* table_;
+  };
+
+} // end namespace nexus
+
+#endif
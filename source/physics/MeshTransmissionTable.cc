@@ -0,0 +1,127 @@
+// ----------------------------------------------------------------------------
+// nexus | MeshTransmissionTable.cc
+//
+// Optical transmission and reflection probabilities of a hexagonal mesh as a
+// function of the angle of incidence, computed once from its dimensions by
+// sampling straight lines across it. The tables are attached to the regions
+// of the mesh envelopes, where the MeshTransmissionModel uses them.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "MeshTransmissionTable.h"
+
+#include "HexagonMeshTools.h"
+
+#include <G4MaterialPropertiesTable.hh>
+#include <G4Region.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <algorithm>
+
+
+namespace nexus {
+
+  using namespace CLHEP;
+
+
+  MeshTransmissionTable::MeshTransmissionTable(G4double in_radius, G4double thickness,
+                                               G4MaterialPropertiesTable* metal,
+                                               G4int nbins, G4int nrays):
+    in_radius_(in_radius), thickness_(thickness), metal_(metal)
+  {
+    nbins = std::max(nbins, 1);
+
+    for (G4int i=0; i<=nbins; ++i) {
+      MeshCrossing c = SampleMeshCrossing(in_radius_, thickness_, G4double(i)/nbins, nrays);
+      open_.push_back(c.open);
+      face_.push_back(c.face);
+    }
+  }
+
+
+
+  MeshTransmissionTable::~MeshTransmissionTable()
+  {
+  }
+
+
+
+  G4double MeshTransmissionTable::Interpolate(const std::vector<G4double>& values,
+                                              G4double cos_theta) const
+  {
+    G4double x = std::clamp(std::abs(cos_theta), 0., 1.) * (values.size() - 1);
+    size_t i = std::min(size_t(x), values.size() - 2);
+    return values[i] + (x - i) * (values[i+1] - values[i]);
+  }
+
+
+
+  G4double MeshTransmissionTable::GetOpenFraction(G4double cos_theta) const
+  {
+    return Interpolate(open_, cos_theta);
+  }
+
+
+
+  G4double MeshTransmissionTable::GetFaceFraction(G4double cos_theta) const
+  {
+    return Interpolate(face_, cos_theta);
+  }
+
+
+
+  G4double MeshTransmissionTable::GetReflectivity(G4double energy) const
+  {
+    if (!metal_) return 0.;
+
+    G4MaterialPropertyVector* refl = metal_->GetProperty("REFLECTIVITY");
+    if (!refl) return 0.;
+
+    return refl->Value(energy);
+  }
+
+
+
+  void MeshTransmissionTable::Print() const
+  {
+    G4cout << "Mesh transmission table: hole size " << in_radius_/mm
+           << " mm, thickness " << thickness_/mm << " mm, open fraction "
+           << open_.back() << " at normal incidence." << G4endl;
+  }
+
+
+
+  std::map<G4Region*, std::unique_ptr<MeshTransmissionTable>>&
+  MeshTransmissionTable::Tables()
+  {
+    static std::map<G4Region*, std::unique_ptr<MeshTransmissionTable>> tables;
+    return tables;
+  }
+
+
+
+  void MeshTransmissionTable::Register(G4Region* region, MeshTransmissionTable* table)
+  {
+    Tables()[region].reset(table);
+  }
+
+
+
+  const MeshTransmissionTable* MeshTransmissionTable::Find(const G4Region* region)
+  {
+    auto it = Tables().find(const_cast<G4Region*>(region));
+    return (it == Tables().end()) ? nullptr : it->second.get();
+  }
+
+
+
+  std::vector<G4Region*> MeshTransmissionTable::GetRegions()
+  {
+    std::vector<G4Region*> regions;
+    for (auto& rt: Tables()) regions.push_back(rt.first);
+    return regions;
+  }
+
+
+} // end namespace nexus
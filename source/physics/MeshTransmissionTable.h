@@ -0,0 +1,70 @@
+// ----------------------------------------------------------------------------
+// nexus | MeshTransmissionTable.h
+//
+// Optical transmission and reflection probabilities of a hexagonal mesh as a
+// function of the angle of incidence, computed once from its dimensions by
+// sampling straight lines across it. The tables are attached to the regions
+// of the mesh envelopes, where the MeshTransmissionModel uses them.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef MESH_TRANSMISSION_TABLE_H
+#define MESH_TRANSMISSION_TABLE_H
+
+#include <globals.hh>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+class G4Region;
+class G4MaterialPropertiesTable;
+
+
+namespace nexus {
+
+  class MeshTransmissionTable
+  {
+  public:
+    /// Constructor. The dimensions are those of PlaceHexagons (hole size
+    /// flat-to-flat and land width, equal to the mesh thickness). The metal
+    /// reflectivity is taken from the REFLECTIVITY property of the table.
+    MeshTransmissionTable(G4double in_radius, G4double thickness,
+                          G4MaterialPropertiesTable* metal,
+                          G4int nbins=100, G4int nrays=20000);
+    /// Destructor
+    ~MeshTransmissionTable();
+
+    /// Probability of going through a hole without touching the metal
+    G4double GetOpenFraction(G4double cos_theta) const;
+    /// Probability of hitting the front face of the metal
+    G4double GetFaceFraction(G4double cos_theta) const;
+    /// Reflectivity of the metal at a given photon energy
+    G4double GetReflectivity(G4double energy) const;
+
+    void Print() const;
+
+    /// Attach a table (taking ownership) to the region of a mesh envelope
+    static void Register(G4Region*, MeshTransmissionTable*);
+    /// Table attached to a region, nullptr if none
+    static const MeshTransmissionTable* Find(const G4Region*);
+    /// Regions with a table attached
+    static std::vector<G4Region*> GetRegions();
+
+  private:
+    G4double Interpolate(const std::vector<G4double>&, G4double cos_theta) const;
+
+    static std::map<G4Region*, std::unique_ptr<MeshTransmissionTable>>& Tables();
+
+  private:
+    G4double in_radius_, thickness_;
+    G4MaterialPropertiesTable* metal_;
+
+    std::vector<G4double> open_; ///< Open fraction at equally spaced cos(theta)
+    std::vector<G4double> face_; ///< Face fraction at equally spaced cos(theta)
+  };
+
+} // end namespace nexus
+
+#endif
@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------------
+// nexus | ThinningInformation.cc
+//
+// Track (or primary particle) information that marks the optical photons
+// produced with thinning. It holds the thinning weight of the photon, that
+// is, the inverse of the product of the fractions of photons kept by the
+// processes that created it. Only the photons carrying this information are
+// resampled by the sensitive detectors; other weights (e.g., those of the
+// importance biasing) are left to the analysis.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "ThinningInformation.h"
+
+#include <G4Track.hh>
+#include <G4DynamicParticle.hh>
+#include <G4PrimaryParticle.hh>
+
+
+namespace nexus {
+
+
+  std::atomic<G4bool> ThinningInformation::enabled_(false);
+
+
+  ThinningInformation::ThinningInformation(G4double weight):
+    G4VUserTrackInformation("ThinningInformation"),
+    G4VUserPrimaryParticleInformation(), weight_(weight)
+  {
+  }
+
+
+
+  ThinningInformation::~ThinningInformation()
+  {
+  }
+
+
+
+  G4double ThinningInformation::GetWeight(const G4Track& track)
+  {
+    const ThinningInformation* info =
+      dynamic_cast<const ThinningInformation*>(track.GetUserInformation());
+
+    // The information of the primary particles is not transferred to
+    // their tracks, but it can be reached through the dynamic particle
+    const G4PrimaryParticle* primary = track.GetDynamicParticle()->GetPrimaryParticle();
+    if (!info && primary)
+      info = dynamic_cast<const ThinningInformation*>(primary->GetUserInformation());
+
+    return info ? info->GetWeight() : 1.;
+  }
+
+
+
+  void ThinningInformation::Print() const
+  {
+    G4cout << "Optical photon with thinning weight " << weight_ << G4endl;
+  }
+
+
+} // end namespace nexus
@@ -0,0 +1,69 @@
+// ----------------------------------------------------------------------------
+// nexus | ThinningInformation.h
+//
+// Track (or primary particle) information that marks the optical photons
+// produced with thinning. It holds the thinning weight of the photon, that
+// is, the inverse of the product of the fractions of photons kept by the
+// processes that created it. Only the photons carrying this information are
+// resampled by the sensitive detectors; other weights (e.g., those of the
+// importance biasing) are left to the analysis.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef THINNING_INFORMATION_H
+#define THINNING_INFORMATION_H
+
+#include <G4VUserTrackInformation.hh>
+#include <G4VUserPrimaryParticleInformation.hh>
+#include <globals.hh>
+
+#include <atomic>
+
+class G4Track;
+
+
+namespace nexus {
+
+  class ThinningInformation: public G4VUserTrackInformation,
+                             public G4VUserPrimaryParticleInformation
+  {
+  public:
+    /// Constructor
+    ThinningInformation(G4double weight);
+    /// Destructor
+    ~ThinningInformation();
+
+    G4double GetWeight() const;
+
+    /// Thinning weight of a track, taken from its own information
+    /// or, for primary particles, from that of the primary.
+    /// It is 1 if the track was not produced with thinning.
+    static G4double GetWeight(const G4Track&);
+
+    /// Record that some process or generator was configured to produce
+    /// photons with thinning (a photon fraction below 1), in any thread
+    static void EnableThinning();
+    static G4bool IsThinningEnabled();
+
+    void Print() const;
+
+  private:
+    G4double weight_;
+
+    static std::atomic<G4bool> enabled_;
+  };
+
+  // INLINE METHODS //////////////////////////////////////////////////
+
+  inline G4double ThinningInformation::GetWeight() const { return weight_; }
+
+  inline void ThinningInformation::EnableThinning()
+  { enabled_.store(true, std::memory_order_relaxed); }
+
+  inline G4bool ThinningInformation::IsThinningEnabled()
+  { return enabled_.load(std::memory_order_relaxed); }
+
+} // end namespace nexus
+
+#endif
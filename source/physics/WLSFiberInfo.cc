@@ -0,0 +1,58 @@
+// ----------------------------------------------------------------------------
+// nexus | WLSFiberInfo.cc
+//
+// Region information of the wavelength shifting fibers simulated with the
+// WLSFiberModel, whose cores are the root volumes of the region. It holds
+// the material surrounding the light guide (the outermost cladding), which
+// determines the total internal reflection angle.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "WLSFiberInfo.h"
+
+#include <G4Material.hh>
+#include <G4MaterialPropertiesTable.hh>
+
+#include <cmath>
+
+
+namespace nexus {
+
+
+  WLSFiberInfo::WLSFiberInfo(G4Material* cladding):
+    G4VUserRegionInformation(), cladding_(cladding)
+  {
+  }
+
+
+
+  WLSFiberInfo::~WLSFiberInfo()
+  {
+  }
+
+
+
+  G4double WLSFiberInfo::GetCriticalCosine(G4double energy, G4double core_rindex) const
+  {
+    G4MaterialPropertiesTable* mpt = cladding_->GetMaterialPropertiesTable();
+    G4MaterialPropertyVector* rindex = mpt ? mpt->GetProperty("RINDEX") : nullptr;
+
+    // Photons reaching a material without refractive index are absorbed
+    if (!rindex) return 0.;
+
+    G4double n = rindex->Value(energy);
+    if (n >= core_rindex) return 0.;
+
+    return std::sqrt(1. - (n*n) / (core_rindex*core_rindex));
+  }
+
+
+
+  void WLSFiberInfo::Print() const
+  {
+    G4cout << "WLS fiber region with cladding " << cladding_->GetName() << G4endl;
+  }
+
+
+} // end namespace nexus
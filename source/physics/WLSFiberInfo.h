@@ -0,0 +1,44 @@
+// ----------------------------------------------------------------------------
+// nexus | WLSFiberInfo.h
+//
+// Region information of the wavelength shifting fibers simulated with the
+// WLSFiberModel, whose cores are the root volumes of the region. It holds
+// the material surrounding the light guide (the outermost cladding), which
+// determines the total internal reflection angle.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef WLS_FIBER_INFO_H
+#define WLS_FIBER_INFO_H
+
+#include <G4VUserRegionInformation.hh>
+#include <globals.hh>
+
+class G4Material;
+
+
+namespace nexus {
+
+  class WLSFiberInfo: public G4VUserRegionInformation
+  {
+  public:
+    /// Constructor
+    WLSFiberInfo(G4Material* cladding);
+    /// Destructor
+    ~WLSFiberInfo();
+
+    /// Cosine of the critical angle (with respect to the normal of the
+    /// fiber surface) of a photon of a given energy in the core, zero if
+    /// there is no total internal reflection
+    G4double GetCriticalCosine(G4double energy, G4double core_rindex) const;
+
+    void Print() const;
+
+  private:
+    G4Material* cladding_;
+  };
+
+} // end namespace nexus
+
+#endif
@@ -0,0 +1,164 @@
+// ----------------------------------------------------------------------------
+// nexus | WLSFiberModel.cc
+//
+// Fast simulation model of the light transport along wavelength shifting
+// fibers. Photons re-emitted in the fiber core that are trapped by total
+// internal reflection are moved directly to the end of the fiber they are
+// heading to, with the time and attenuation of the path they would follow,
+// so that they are not tracked through each reflection. There, they leave
+// the fiber and are detected by the sensors as usual.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "WLSFiberModel.h"
+
+#include "WLSFiberInfo.h"
+
+#include <G4OpticalPhoton.hh>
+#include <G4OpProcessSubType.hh>
+#include <G4VProcess.hh>
+#include <G4Tubs.hh>
+#include <G4Box.hh>
+#include <G4Material.hh>
+#include <G4MaterialPropertiesTable.hh>
+#include <Randomize.hh>
+
+#include <cmath>
+
+
+namespace nexus {
+
+
+  WLSFiberModel::WLSFiberModel(G4Region* region):
+    G4VFastSimulationModel("WLSFiberModel_" + region->GetName(), region),
+    info_(dynamic_cast<WLSFiberInfo*>(region->GetUserInformation()))
+  {
+    if (!info_) {
+      G4String msg = "No WLS fiber information attached to region " + region->GetName();
+      G4Exception("[WLSFiberModel]", "WLSFiberModel()",
+                  FatalException, msg);
+    }
+  }
+
+
+
+  WLSFiberModel::~WLSFiberModel()
+  {
+  }
+
+
+
+  G4bool WLSFiberModel::IsApplicable(const G4ParticleDefinition& pdef)
+  {
+    return (&pdef == G4OpticalPhoton::Definition());
+  }
+
+
+
+  G4bool WLSFiberModel::ModelTrigger(const G4FastTrack& ftrack)
+  {
+    const G4Track* track = ftrack.GetPrimaryTrack();
+
+    // Only photons just re-emitted inside the core
+    const G4VProcess* creator = track->GetCreatorProcess();
+    if (!creator || (creator->GetProcessSubType() != fOpWLS &&
+                     creator->GetProcessSubType() != fOpWLS2)) return false;
+
+    if (track->GetPosition() != track->GetVertexPosition()) return false;
+
+    const G4VSolid* solid = ftrack.GetEnvelopeSolid();
+    G4ThreeVector pos = ftrack.GetPrimaryTrackLocalPosition();
+    G4ThreeVector dir = ftrack.GetPrimaryTrackLocalDirection();
+
+    if (solid->Inside(pos) != kInside || dir.z() == 0.) return false;
+
+    // The fiber runs along the z axis of the core
+    G4MaterialPropertiesTable* mpt =
+      ftrack.GetEnvelopeLogicalVolume()->GetMaterial()->GetMaterialPropertiesTable();
+    G4MaterialPropertyVector* rindex = mpt ? mpt->GetProperty("RINDEX") : nullptr;
+    if (!rindex) return false;
+
+    G4double cos_crit =
+      info_->GetCriticalCosine(track->GetTotalEnergy(), rindex->Value(track->GetTotalEnergy()));
+
+    if (const G4Tubs* tubs = dynamic_cast<const G4Tubs*>(solid)) {
+
+      // Thin cylindrical shell (a barrel of fibers): the photons are guided
+      // if the radial component of their direction is below the critical one
+      if (tubs->GetInnerRadius() > 0.) {
+        G4double u_r = (pos.x()*dir.x() + pos.y()*dir.y()) / pos.perp();
+        return std::abs(u_r) < cos_crit;
+      }
+
+      // Round fiber: the angle of incidence is the same in every
+      // reflection, given by the impact parameter of the photon
+      G4double s = dir.perp();
+      if (s == 0.) return true;
+
+      G4double b = (pos.x()*dir.y() - pos.y()*dir.x()) / s;
+      G4double r = tubs->GetOuterRadius();
+      G4double cos_inc = s * std::sqrt(std::max(0., 1. - b*b/(r*r)));
+      return cos_inc < cos_crit;
+    }
+
+    // Square fiber
+    if (dynamic_cast<const G4Box*>(solid))
+      return std::abs(dir.x()) < cos_crit && std::abs(dir.y()) < cos_crit;
+
+    return false;
+  }
+
+
+
+  void WLSFiberModel::DoIt(const G4FastTrack& ftrack, G4FastStep& fstep)
+  {
+    const G4Track* track = ftrack.GetPrimaryTrack();
+    const G4VSolid* solid = ftrack.GetEnvelopeSolid();
+
+    G4ThreeVector pos = ftrack.GetPrimaryTrackLocalPosition();
+    G4ThreeVector dir = ftrack.GetPrimaryTrackLocalDirection();
+    G4ThreeVector pol = ftrack.GetPrimaryTrackLocalPolarization();
+
+    // Length of the path to the end of the fiber, which does not depend
+    // on the reflections, since they preserve the z component of the direction
+    G4ThreeVector pmin, pmax;
+    solid->BoundingLimits(pmin, pmax);
+    G4double zend = (dir.z() > 0.) ? pmax.z() : pmin.z();
+    G4double path = (zend - pos.z()) / dir.z();
+
+    // Absorption in the core
+    G4MaterialPropertiesTable* mpt =
+      ftrack.GetEnvelopeLogicalVolume()->GetMaterial()->GetMaterialPropertiesTable();
+    G4MaterialPropertyVector* abslength = mpt->GetProperty("ABSLENGTH");
+
+    if (abslength) {
+      G4double attenuation = std::exp(-path / abslength->Value(track->GetTotalEnergy()));
+      if (G4UniformRand() > attenuation) {
+        fstep.KillPrimaryTrack();
+        return;
+      }
+    }
+
+    // In a barrel, the photons also turn around the axis. The angular
+    // momentum about it is preserved in the reflections, so the angle
+    // advanced is approximately that of a thin shell.
+    const G4Tubs* tubs = dynamic_cast<const G4Tubs*>(solid);
+    if (tubs && tubs->GetInnerRadius() > 0.) {
+      G4double dphi = (pos.x()*dir.y() - pos.y()*dir.x()) / pos.perp2() * path;
+      pos.rotateZ(dphi);
+      dir.rotateZ(dphi);
+      pol.rotateZ(dphi);
+    }
+
+    pos.setZ(zend);
+
+    fstep.ProposePrimaryTrackFinalPosition(pos, true);
+    fstep.ProposePrimaryTrackFinalTime(track->GetGlobalTime() + path / track->GetVelocity());
+    fstep.ProposePrimaryTrackPathLength(path);
+    fstep.ProposePrimaryTrackFinalMomentumDirection(dir, true);
+    fstep.ProposePrimaryTrackFinalPolarization(pol, true);
+  }
+
+
+} // end namespace nexus
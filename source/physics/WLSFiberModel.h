@@ -0,0 +1,47 @@
+// ----------------------------------------------------------------------------
+// nexus | WLSFiberModel.h
+//
+// Fast simulation model of the light transport along wavelength shifting
+// fibers. Photons re-emitted in the fiber core that are trapped by total
+// internal reflection are moved directly to the end of the fiber they are
+// heading to, with the time and attenuation of the path they would follow,
+// so that they are not tracked through each reflection. There, they leave
+// the fiber and are detected by the sensors as usual.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef WLS_FIBER_MODEL_H
+#define WLS_FIBER_MODEL_H
+
+#include <G4VFastSimulationModel.hh>
+
+
+namespace nexus {
+
+  class WLSFiberInfo;
+
+  class WLSFiberModel: public G4VFastSimulationModel
+  {
+  public:
+    /// Constructor. The region must have a WLSFiberInfo attached.
+    WLSFiberModel(G4Region* region);
+    /// Destructor
+    ~WLSFiberModel();
+
+    // This model is only valid for optical photons
+    G4bool IsApplicable(const G4ParticleDefinition&);
+
+    // Triggered by photons re-emitted in the core and trapped in the fiber
+    G4bool ModelTrigger(const G4FastTrack&);
+
+    // Move the photon to the end of the fiber, or absorb it on the way
+    void DoIt(const G4FastTrack&, G4FastStep&);
+
+  private:
+    const WLSFiberInfo* info_;
+  };
+
+} // end namespace nexus
+
+#endif
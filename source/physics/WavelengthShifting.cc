@@ -14,10 +14,12 @@
 // ----------------------------------------------------------------------------
 
 #include "WavelengthShifting.h"
+#include "ThinningInformation.h"
 
 #include <G4OpticalPhoton.hh>
 #include <Randomize.hh>
 #include <G4WLSTimeGeneratorProfileExponential.hh>
+#include <G4GenericMessenger.hh>
 
 #include "CLHEP/Units/PhysicalConstants.h"
 
@@ -26,11 +28,19 @@ namespace nexus {
   using namespace CLHEP;
 
   WavelengthShifting::WavelengthShifting(const G4String& name, G4ProcessType type):
-    G4VDiscreteProcess(name, type), wlsIntegralTable_(0)
+    G4VDiscreteProcess(name, type), wlsIntegralTable_(0), photon_fraction_(1.)
   {
     ParticleChange_ = new G4ParticleChange();
     pParticleChange = ParticleChange_;
 
+    msg_ = new G4GenericMessenger(this, "/Physics/WavelengthShifting/",
+                                  "Control commands of the wavelength shifting process.");
+    G4GenericMessenger::Command& fraction_cmd =
+      msg_->DeclareMethod("photon_fraction", &WavelengthShifting::SetPhotonFraction,
+                          "Fraction of re-emitted photons tracked (thinning).");
+    fraction_cmd.SetParameterName("photon_fraction", false);
+    fraction_cmd.SetRange("photon_fraction>0. && photon_fraction<=1.");
+
     WLSTimeGeneratorProfile_ =
       new G4WLSTimeGeneratorProfileExponential("WLSTimeGeneratorProfileExponential");
 
@@ -45,6 +55,13 @@ namespace nexus {
       delete wlsIntegralTable_;
     }
     delete WLSTimeGeneratorProfile_;
+    delete msg_;
+  }
+
+  void WavelengthShifting::SetPhotonFraction(G4double fraction)
+  {
+    photon_fraction_ = fraction;
+    if (photon_fraction_ < 1.) ThinningInformation::EnableThinning();
   }
 
   G4bool WavelengthShifting::IsApplicable(const G4ParticleDefinition& aParticleType)
@@ -83,6 +100,11 @@ namespace nexus {
    if (rndm > conversion_efficiency) {
      return G4VDiscreteProcess::PostStepDoIt(track, step);
    }
+
+   // Thinning: keep the re-emitted photon with probability photon_fraction_
+   if (photon_fraction_ < 1. && G4UniformRand() > photon_fraction_) {
+     return G4VDiscreteProcess::PostStepDoIt(track, step);
+   }
    ParticleChange_->SetNumberOfSecondaries(1);
 
    G4int materialIndex = material->GetIndex();
@@ -144,6 +166,9 @@ namespace nexus {
      new G4Track(aWLSPhoton,aSecondaryTime,aSecondaryPosition);
    aSecondaryTrack->SetTouchableHandle(track.GetTouchableHandle());
    aSecondaryTrack->SetParentID(track.GetTrackID());
+   G4double thinning_weight = ThinningInformation::GetWeight(track) / photon_fraction_;
+   if (thinning_weight != 1.)
+     aSecondaryTrack->SetUserInformation(new ThinningInformation(thinning_weight));
    ParticleChange_->AddSecondary(aSecondaryTrack);
 
    return G4VDiscreteProcess::PostStepDoIt(track, step);
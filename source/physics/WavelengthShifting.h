@@ -21,6 +21,7 @@
 
 class G4ParticleChange;
 class G4VWLSTimeGeneratorProfile;
+class G4GenericMessenger;
 
 namespace nexus {
 
@@ -36,6 +37,9 @@ namespace nexus {
     G4VParticleChange* PostStepDoIt(const G4Track& aTrack, const G4Step& aStep);
     G4double GetMeanFreePath(const G4Track& track, G4double, G4ForceCondition*);
 
+    /// Set the fraction of re-emitted photons tracked (thinning if below 1)
+    void SetPhotonFraction(G4double);
+
   private:
     void BuildThePhysicsTable();
     void ComputeCumulativeDistribution(const G4MaterialPropertyVector& pdf, G4PhysicsOrderedFreeVector& cdf);
@@ -45,6 +49,9 @@ namespace nexus {
     G4PhysicsTable* wlsIntegralTable_;
     G4VWLSTimeGeneratorProfile*  WLSTimeGeneratorProfile_;
 
+    G4GenericMessenger* msg_;
+    G4double photon_fraction_; ///< Fraction of re-emitted photons tracked
+
   };
 
 }
@@ -33,7 +33,8 @@ namespace nexus {
 
   NexusPhysics::NexusPhysics():
     G4VPhysicsConstructor("NexusPhysics"),
-    clustering_(true), drift_(true), electroluminescence_(true), photoelectric_(false)
+    clustering_(true), drift_(true), electroluminescence_(true), photoelectric_(false),
+    fast_simulation_(true)
   {
     msg_ = new G4GenericMessenger(this, "/PhysicsList/Nexus/",
       "Control commands of the nexus physics list.");
@@ -50,6 +51,9 @@ namespace nexus {
     msg_->DeclareProperty("photoelectric", photoelectric_,
       "Switch on/off the photoelectric effect.");
 
+    msg_->DeclareProperty("fast_simulation", fast_simulation_,
+      "Switch on/off the fast simulation models of optical photons.");
+
   }
 
 
@@ -135,6 +139,16 @@ namespace nexus {
         }
       }
     }
+
+    // Add fast simulation to optical photons, so that the models
+    // attached to regions by the geometries (e.g., meshes) are applied
+
+    if (fast_simulation_) {
+      G4FastSimulationManagerProcess* fastsim =
+        new G4FastSimulationManagerProcess("fast_simulation");
+      pmanager = G4OpticalPhoton::Definition()->GetProcessManager();
+      pmanager->AddDiscreteProcess(fastsim);
+    }
   }
 
 } // end namespace nexus
@@ -34,6 +34,7 @@ namespace nexus {
     G4bool drift_;               ///< Switch on/of the ionization drift
     G4bool electroluminescence_; ///< Switch on/off the electroluminescence
     G4bool photoelectric_;       ///< Switch on/off the photoelectric effect
+    G4bool fast_simulation_;     ///< Switch on/off the optical fast simulation
 
     G4GenericMessenger* msg_;
   };
@@ -13,11 +13,11 @@
 namespace nexus {
 
 
-  G4Allocator<IonizationHit> IonizationHitAllocator;
+  G4ThreadLocal G4Allocator<IonizationHit>* IonizationHitAllocator = nullptr;
 
 
 
-  IonizationHit::IonizationHit(): G4VHit()
+  IonizationHit::IonizationHit(): G4VHit(), weight_(1.)
   {
   }
 
@@ -42,6 +42,7 @@ namespace nexus {
     time_       = other.time_;
     energy_dep_ = other.energy_dep_;
     position_   = other.position_;
+    weight_     = other.weight_;
 
     return *this;
   }
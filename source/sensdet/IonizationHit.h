@@ -52,25 +52,33 @@ namespace nexus {
     G4ThreeVector GetPosition();
     void SetPosition(G4ThreeVector);
 
+    G4double GetWeight();
+    void SetWeight(G4double);
+
   private:
     G4int track_id_;
     G4double time_;
     G4double energy_dep_;
     G4ThreeVector position_;
+    G4double weight_;
   };
 
 
   typedef G4THitsCollection<IonizationHit> IonizationHitsCollection;
-  extern G4Allocator<IonizationHit> IonizationHitAllocator;
+  extern G4ThreadLocal G4Allocator<IonizationHit>* IonizationHitAllocator;
 
 
   // INLINE DEFINITIONS //////////////////////////////////////////////
 
   inline void* IonizationHit::operator new(size_t)
-  { return ((void*) IonizationHitAllocator.MallocSingle()); }
+  {
+    if (!IonizationHitAllocator)
+      IonizationHitAllocator = new G4Allocator<IonizationHit>;
+    return ((void*) IonizationHitAllocator->MallocSingle());
+  }
 
   inline void IonizationHit::operator delete(void* aHit)
-  { IonizationHitAllocator.FreeSingle((IonizationHit*) aHit); }
+  { IonizationHitAllocator->FreeSingle((IonizationHit*) aHit); }
 
   inline G4int IonizationHit::GetTrackID() { return track_id_; }
   inline void IonizationHit::SetTrackID(G4int id) { track_id_ = id; }
@@ -86,6 +94,9 @@ namespace nexus {
   inline void IonizationHit::SetPosition(G4ThreeVector xyz)
   { position_ = xyz; }
 
+  inline G4double IonizationHit::GetWeight() { return weight_; }
+  inline void IonizationHit::SetWeight(G4double w) { weight_ = w; }
+
 
 } // end namespace nexus
 
@@ -12,6 +12,7 @@
 #include "Trajectory.h"
 #include "TrajectoryMap.h"
 #include "IonizationElectron.h"
+#include "EventAbortManager.h"
 
 #include <G4SDManager.hh>
 #include <G4Step.hh>
@@ -37,6 +38,15 @@ IonizationSD::~IonizationSD()
 
 
 
+G4VSensitiveDetector* IonizationSD::Clone() const
+{
+  IonizationSD* sd = new IonizationSD(GetFullPathName());
+  sd->IncludeInTotalEnergyDeposit(include_);
+  return sd;
+}
+
+
+
 G4String IonizationSD::GetCollectionUniqueName()
 {
   G4String name = "IonizationHitsCollection";
@@ -80,19 +90,27 @@ G4bool IonizationSD::ProcessHits(G4Step* step, G4TouchableHistory*)
   hit->SetTime(step->GetTrack()->GetGlobalTime());
   hit->SetEnergyDeposit(edep);
   hit->SetPosition(step->GetPostStepPoint()->GetPosition());
+  hit->SetWeight(step->GetTrack()->GetWeight());
 
   // Add hit to collection
   IHC_->insert(hit);
 
   // Add energy deposit to the trajectory associated
-  // to the current track
+  // to the current track. The event selections use the deposits
+  // weighted with the weight of the track relative to its primary,
+  // which changes when the track is split by the importance biasing.
   if (include_) {
     Trajectory* trj =
       (Trajectory*) TrajectoryMap::Get(step->GetTrack()->GetTrackID());
+
+    G4double weighted_edep = edep;
     if (trj) {
-      edep += trj->GetEnergyDeposit();
-      trj->SetEnergyDeposit(edep);
+      weighted_edep *= track->GetWeight() / trj->GetPrimaryWeight();
+      trj->SetEnergyDeposit(trj->GetEnergyDeposit() + edep);
+      trj->SetWeightedEnergyDeposit(trj->GetWeightedEnergyDeposit() + weighted_edep);
     }
+
+    EventAbortManager::Instance().AddEnergy(weighted_edep);
   }
 
   return true;
@@ -35,6 +35,10 @@ namespace nexus {
 
     void EndOfEvent(G4HCofThisEvent*);
 
+    /// Return a copy of this sensitive detector with the same
+    /// configuration (used to create one instance per worker thread)
+    virtual G4VSensitiveDetector* Clone() const;
+
     /// Return the unique name of the hits collection created
     /// by this sensitive detector. This will be used by the persistency
     /// manager to fetch the collection from the G4HCofThisEvent object.
@@ -8,11 +8,13 @@
 
 #include "SensorHit.h"
 
+#include <G4Poisson.hh>
+
 
 using namespace nexus;
 
 
-G4Allocator<SensorHit> SensorHitAllocator;
+G4ThreadLocal G4Allocator<SensorHit>* SensorHitAllocator = nullptr;
 
 
 
@@ -49,6 +51,7 @@ const SensorHit& SensorHit::operator=(const SensorHit& other)
   bin_size_  = other.bin_size_;
   position_  = other.position_;
   histogram_ = other.histogram_;
+  weighted_histogram_ = other.weighted_histogram_;
 
   return *this;
 }
@@ -80,3 +83,32 @@ void SensorHit::Fill(G4double time, G4int counts)
   G4double time_bin = floor(time/bin_size_) * bin_size_;
   histogram_[time_bin] += counts;
 }
+
+
+
+void SensorHit::FillWeighted(G4double time, G4double weight)
+{
+  G4double time_bin = floor(time/bin_size_) * bin_size_;
+  weighted_histogram_[time_bin] += weight;
+}
+
+
+
+void SensorHit::ResampleWeights()
+{
+  for (const auto& bin : weighted_histogram_) {
+    G4int counts = G4int(G4Poisson(bin.second));
+    if (counts > 0) histogram_[bin.first] += counts;
+  }
+  weighted_histogram_.clear();
+}
+
+
+
+void SensorHit::Merge(const SensorHit& other)
+{
+  for (const auto& bin : other.histogram_)
+    histogram_[bin.first] += bin.second;
+  for (const auto& bin : other.weighted_histogram_)
+    weighted_histogram_[bin.first] += bin.second;
+}
@@ -58,6 +58,20 @@ namespace nexus {
     /// Adds counts to a given time bin
     void Fill(G4double time, G4int counts=1);
 
+    /// Adds the statistical weight of a thinned photon to a given
+    /// time bin. Weighted bins are converted into integer counts
+    /// by ResampleWeights().
+    void FillWeighted(G4double time, G4double weight);
+
+    /// Converts the accumulated weights into integer counts sampling
+    /// a Poisson distribution of mean equal to the sum of weights of
+    /// each time bin, and adds them to the histogram
+    void ResampleWeights();
+
+    /// Adds the counts of another hit of the same sensor
+    /// (used to merge the hits of sub-events)
+    void Merge(const SensorHit&);
+
     const std::map<G4double, G4int>& GetHistogram() const;
 
   private:
@@ -67,13 +81,17 @@ namespace nexus {
 
     /// Sparse histogram with number of photons detected per time bin
     std::map<G4double, G4int> histogram_;
+
+    /// Sparse histogram with the sum of weights of thinned photons
+    /// detected per time bin
+    std::map<G4double, G4double> weighted_histogram_;
   };
 
 } // namespace nexus
 
 
 typedef G4THitsCollection<nexus::SensorHit> SensorHitsCollection;
-extern G4Allocator<nexus::SensorHit> SensorHitAllocator;
+extern G4ThreadLocal G4Allocator<nexus::SensorHit>* SensorHitAllocator;
 
 
 // INLINE DEFINITIONS ////////////////////////////////////////////////
@@ -81,10 +99,13 @@ extern G4Allocator<nexus::SensorHit> SensorHitAllocator;
 namespace nexus {
 
   inline void* SensorHit::operator new(size_t)
-  { return ((void*) SensorHitAllocator.MallocSingle()); }
+  {
+    if (!SensorHitAllocator) SensorHitAllocator = new G4Allocator<SensorHit>;
+    return ((void*) SensorHitAllocator->MallocSingle());
+  }
 
   inline void SensorHit::operator delete(void* hit)
-  { SensorHitAllocator.FreeSingle((SensorHit*) hit); }
+  { SensorHitAllocator->FreeSingle((SensorHit*) hit); }
 
   inline G4int SensorHit::GetSensorID() const { return sns_id_; }
   inline void SensorHit::SetSensorID(G4int id) { sns_id_ = id; }
@@ -8,6 +8,7 @@
 // ----------------------------------------------------------------------------
 
 #include "SensorSD.h"
+#include "ThinningInformation.h"
 
 #include <G4OpticalPhoton.hh>
 #include <G4SDManager.hh>
@@ -36,6 +37,18 @@ namespace nexus {
 
 
 
+  G4VSensitiveDetector* SensorSD::Clone() const
+  {
+    SensorSD* sd = new SensorSD(GetFullPathName());
+    sd->SetDetectorVolumeDepth(sensor_depth_);
+    sd->SetMotherVolumeDepth(mother_depth_);
+    sd->SetDetectorNamingOrder(naming_order_);
+    sd->SetTimeBinning(timebinning_);
+    return sd;
+  }
+
+
+
   G4String SensorSD::GetCollectionUniqueName()
   {
     return "SensorHitsCollection";
@@ -86,7 +99,13 @@ namespace nexus {
     }
 
     G4double time = step->GetPostStepPoint()->GetGlobalTime();
-    hit->Fill(time);
+
+    // Photons produced with thinning are marked with a weight that is
+    // resampled into integer counts at the end of the event. Other track
+    // weights (e.g., from importance biasing) are not applied here.
+    G4double weight = ThinningInformation::GetWeight(*step->GetTrack());
+    if (weight == 1.) hit->Fill(time);
+    else hit->FillWeighted(time, weight);
 
     return true;
   }
@@ -106,12 +125,17 @@ namespace nexus {
 
   void SensorSD::EndOfEvent(G4HCofThisEvent* /*HCE*/)
   {
-    //  int HCID = G4SDManager::GetSDMpointer()->
-    //    GetCollectionID(this->GetCollectionName(0));
-    //  // }
-    // HCE->AddHitsCollection(HCID, HC_);
-
-
+    // Convert the weights of thinned photons into photon counts.
+    // The hits left without counts are dropped, so that the sensors
+    // that saw no photon are not written.
+    std::vector<SensorHit*>* hits = HC_->GetVector();
+    size_t nkept = 0;
+    for (SensorHit* hit: *hits) {
+      hit->ResampleWeights();
+      if (hit->GetHistogram().empty()) delete hit;
+      else (*hits)[nkept++] = hit;
+    }
+    hits->resize(nkept);
   }
 
 
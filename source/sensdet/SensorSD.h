@@ -38,6 +38,10 @@ namespace nexus {
     /// Method invoked at the end of every event
     void EndOfEvent(G4HCofThisEvent*);
 
+    /// Return a copy of this sensitive detector with the same
+    /// configuration (used to create one instance per worker thread)
+    G4VSensitiveDetector* Clone() const;
+
     /// Set the depth of the sensitive detector in the geometry hierarchy
     void SetDetectorVolumeDepth(G4int);
     /// Return the depth of the sensitive detector in the volume hierarchy
@@ -0,0 +1,46 @@
+// ----------------------------------------------------------------------------
+// nexus | VetoSD.cc
+//
+// This class is the sensitive detector attached to the veto volumes.
+// It does not create hits: the current event is aborted as soon as
+// energy is deposited in any of its volumes.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "VetoSD.h"
+#include "EventAbortManager.h"
+
+#include <G4Step.hh>
+
+
+using namespace nexus;
+
+
+
+VetoSD::VetoSD(const G4String& name): G4VSensitiveDetector(name)
+{
+}
+
+
+
+VetoSD::~VetoSD()
+{
+}
+
+
+
+G4VSensitiveDetector* VetoSD::Clone() const
+{
+  return new VetoSD(GetFullPathName());
+}
+
+
+
+G4bool VetoSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  if (step->GetTotalEnergyDeposit() <= 0.) return false;
+
+  EventAbortManager::Instance().Veto();
+  return true;
+}
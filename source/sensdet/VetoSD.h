@@ -0,0 +1,40 @@
+// ----------------------------------------------------------------------------
+// nexus | VetoSD.h
+//
+// This class is the sensitive detector attached to the veto volumes.
+// It does not create hits: the current event is aborted as soon as
+// energy is deposited in any of its volumes.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef VETO_SD_H
+#define VETO_SD_H
+
+#include <G4VSensitiveDetector.hh>
+
+class G4Step;
+class G4TouchableHistory;
+
+
+namespace nexus {
+
+  class VetoSD: public G4VSensitiveDetector
+  {
+  public:
+    /// Constructor
+    VetoSD(const G4String& sdname);
+    /// Destructor
+    virtual ~VetoSD();
+
+    /// Return a copy of this sensitive detector
+    /// (used to create one instance per worker thread)
+    virtual G4VSensitiveDetector* Clone() const;
+
+  private:
+    virtual G4bool ProcessHits(G4Step*, G4TouchableHistory*);
+  };
+
+} // end namespace nexus
+
+#endif
@@ -0,0 +1,105 @@
+#include "decay0.h"
+
+#include <catch.hpp>
+
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+
+  // Kinetic energies of the two electrons of n decays, sorted
+  void Sample(const decay0& gen, int n,
+              std::vector<double>& esum, std::vector<double>& e1)
+  {
+    std::vector<decay0Part> parts;
+    for (int i=0; i<n; ++i) {
+      gen.decay0DoIt(parts);
+      double sum = 0.;
+      for (const decay0Part& p: parts)
+        if (std::abs(p.pdgCode_) == 11) sum += p.energy_;
+      esum.push_back(sum);
+      e1.push_back(parts.front().energy_);
+    }
+    std::sort(esum.begin(), esum.end());
+    std::sort(e1.begin(), e1.end());
+  }
+
+  // Kolmogorov-Smirnov distance between two sorted samples
+  double KSDistance(const std::vector<double>& a, const std::vector<double>& b)
+  {
+    size_t i = 0, j = 0;
+    double d = 0.;
+    while (i < a.size() && j < b.size()) {
+      if (a[i] <= b[j]) ++i;
+      else              ++j;
+      d = std::max(d, std::abs(double(i)/a.size() - double(j)/b.size()));
+    }
+    return d;
+  }
+
+}
+
+
+TEST_CASE("Decay0 sampling tables") {
+
+  // The 2nubb spectra (mode 4, Ba136 ground state) sampled from the
+  // precomputed tables must be compatible with those sampled with the
+  // acceptance/rejection method of the original decay0 code.
+
+  const std::string spectrum_file = "Decay0TestSpectrum.dat";
+  const std::string cache_dir     = "Decay0TestCache";
+  std::filesystem::create_directory(cache_dir);
+
+  const int nevents = 10000;
+
+  std::vector<double> esum_a, e1_a;
+
+  {
+    decay0 rejection("Xe136", 0, 4, spectrum_file, 0., 4.3, false);
+    decay0 tables   ("Xe136", 0, 4, spectrum_file, 0., 4.3, true, cache_dir);
+
+    REQUIRE(!rejection.UsesSamplingTables());
+    REQUIRE( tables   .UsesSamplingTables());
+    REQUIRE(!tables   .SamplingTablesFromCache());
+
+    std::vector<double> esum_rej, e1_rej, esum_tab, e1_tab;
+    G4Random::setTheSeed(4321);
+    Sample(rejection, nevents, esum_rej, e1_rej);
+    Sample(tables,    nevents, esum_tab, e1_tab);
+
+    // Critical value of the two-sample KS test at a 1e-4 significance level
+    const double dmax = 2.15 * std::sqrt(2./nevents);
+    REQUIRE(KSDistance(esum_rej, esum_tab) < dmax);
+    REQUIRE(KSDistance(e1_rej,   e1_tab)   < dmax);
+
+    REQUIRE(esum_tab.front() >= 0.);
+    REQUIRE(esum_tab.back()  <= 2.45783);
+
+    // A second generator with the same settings shares the tables
+    // and, with the same random numbers, produces the same events
+    decay0 shared("Xe136", 0, 4, spectrum_file, 0., 4.3, true, cache_dir);
+
+    std::vector<double> esum_b, e1_b;
+    G4Random::setTheSeed(1234);
+    Sample(tables, 100, esum_a, e1_a);
+    G4Random::setTheSeed(1234);
+    Sample(shared, 100, esum_b, e1_b);
+    REQUIRE(esum_a == esum_b);
+  }
+
+  // Once the generators above are gone, the tables are read from the cache
+  decay0 cached("Xe136", 0, 4, spectrum_file, 0., 4.3, true, cache_dir);
+  REQUIRE(cached.SamplingTablesFromCache());
+
+  std::vector<double> esum_c, e1_c;
+  G4Random::setTheSeed(1234);
+  Sample(cached, 100, esum_c, e1_c);
+  REQUIRE(esum_a == esum_c);
+
+  std::filesystem::remove_all(cache_dir);
+  std::remove(spectrum_file.c_str());
+}
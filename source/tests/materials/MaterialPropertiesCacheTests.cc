@@ -0,0 +1,37 @@
+#include "MaterialPropertiesCache.h"
+#include "OpticalMaterialProperties.h"
+
+#include <G4MaterialPropertiesTable.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("MaterialPropertiesCache") {
+
+  // The tables requested twice with the same parameters must be shared,
+  // while those requested with different parameters must be built again
+
+  using nexus::MaterialPropertiesCache;
+  MaterialPropertiesCache::Clear();
+
+  const G4String table = MaterialPropertiesCache::TableName("GXe", 10.*bar, 25510/MeV, 1000.*ms);
+  REQUIRE(!MaterialPropertiesCache::Load(table));
+
+  G4MaterialPropertiesTable* computed = opticalprops::GXe(10.*bar, 293.*kelvin);
+  REQUIRE(computed);
+  REQUIRE(opticalprops::GXe(10.*bar, 293.*kelvin) == computed);
+  REQUIRE(opticalprops::GXe(15.*bar, 293.*kelvin) != computed);
+
+  const G4String other = MaterialPropertiesCache::TableName("Other");
+  REQUIRE(!MaterialPropertiesCache::Load(other));
+  MaterialPropertiesCache::Save(other, computed);
+  REQUIRE(MaterialPropertiesCache::Load(other) == computed);
+
+  // Once forgotten, the tables are built again
+  MaterialPropertiesCache::Clear();
+  REQUIRE(!MaterialPropertiesCache::Load(other));
+  REQUIRE(opticalprops::GXe(10.*bar, 293.*kelvin) != computed);
+
+  MaterialPropertiesCache::Clear();
+}
@@ -0,0 +1,80 @@
+#include "AcceptanceMapSampler.h"
+#include "BoxPointSampler.h"
+
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+#include <algorithm>
+
+TEST_CASE("AcceptanceMapSampler") {
+
+  // The region is a spherical shell with a thin slab removed, generated
+  // inside a box. The vertices obtained with the acceptance map must
+  // belong to the region, follow the same distribution as those of the
+  // plain rejection loop, and need fewer acceptance tests.
+
+  auto box = nexus::BoxPointSampler(10., 10., 10.);
+  auto generator = [&box]() { return box.GenerateVertex(nexus::INSIDE); };
+
+  G4int ntests = 0;
+  auto accept = [&ntests](const G4ThreeVector& p) {
+    ++ntests;
+    return p.mag() > 4. && p.mag() < 9. && std::abs(p.z()) > 0.2;
+  };
+
+  // Distance within which the result of the test does not change
+  auto safety = [](const G4ThreeVector& p) {
+    const G4double r = p.mag();
+    if (r < 4.) return 4. - r;
+    if (r > 9.) return r - 9.;
+    return std::min({r - 4., 9. - r, std::abs(std::abs(p.z()) - 0.2)});
+  };
+
+  nexus::AcceptanceMapSampler sampler(generator, {accept, safety});
+  sampler.Build();
+
+  REQUIRE(sampler.GetVoxelState(G4ThreeVector(0., 0., 0.))  == nexus::AcceptanceMapSampler::EMPTY);
+  REQUIRE(sampler.GetVoxelState(G4ThreeVector(0., 6.5, 3.)) == nexus::AcceptanceMapSampler::FULL);
+  REQUIRE(sampler.GetVoxelState(G4ThreeVector(0., 6.5, 0.)) == nexus::AcceptanceMapSampler::PARTIAL);
+  REQUIRE(sampler.GetVoxelState(G4ThreeVector(0., 0., 20.)) == nexus::AcceptanceMapSampler::PARTIAL);
+
+  // Without a safety, nothing can be proven about the voxels
+  nexus::AcceptanceMapSampler unsafe(generator, {accept, nullptr});
+  unsafe.Build();
+  REQUIRE(unsafe.GetNumberOfVoxels(nexus::AcceptanceMapSampler::PARTIAL) == 24*24*24);
+
+  const G4int npoints = 20000;
+
+  std::vector<G4double> r_map, r_rej;
+
+  ntests = 0;
+  for (G4int i=0; i<npoints; ++i) {
+    G4ThreeVector p = sampler.GenerateVertex();
+    REQUIRE(accept(p));
+    r_map.push_back(p.mag());
+  }
+  const G4int ntests_map = ntests - npoints; // minus the checks above
+
+  ntests = 0;
+  for (G4int i=0; i<npoints; ++i) {
+    G4ThreeVector p;
+    do { p = generator(); } while (!accept(p));
+    r_rej.push_back(p.mag());
+  }
+  const G4int ntests_rej = ntests;
+
+  REQUIRE(ntests_map < 0.75 * ntests_rej);
+
+  // Two-sample Kolmogorov-Smirnov distance of the radial distributions
+  std::sort(r_map.begin(), r_map.end());
+  std::sort(r_rej.begin(), r_rej.end());
+  size_t i = 0, j = 0;
+  G4double d = 0.;
+  while (i < r_map.size() && j < r_rej.size()) {
+    if (r_map[i] <= r_rej[j]) ++i;
+    else                      ++j;
+    d = std::max(d, std::abs(G4double(i)/r_map.size() - G4double(j)/r_rej.size()));
+  }
+  REQUIRE(d < 2.15 * std::sqrt(2./npoints));
+}
@@ -0,0 +1,64 @@
+#include "ArrayParameterisation.h"
+
+#include <G4Box.hh>
+#include <G4GeometryManager.hh>
+#include <G4LogicalVolume.hh>
+#include <G4NistManager.hh>
+#include <G4Navigator.hh>
+#include <G4PVParameterised.hh>
+#include <G4PVPlacement.hh>
+#include <G4TouchableHistory.hh>
+
+#include <catch.hpp>
+
+#include <memory>
+
+TEST_CASE("ArrayParameterisation") {
+
+  // The navigator must find each copy of the array at its position,
+  // with the index of the position as copy number (which is what the
+  // sensitive detectors use to identify the sensors), and the mother
+  // volume between them.
+
+  G4Material* vacuum = G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+
+  auto world_logic = new G4LogicalVolume(new G4Box("WORLD", 10., 10., 1.),
+                                         vacuum, "WORLD");
+  auto world_phys  = new G4PVPlacement(nullptr, G4ThreeVector(), world_logic,
+                                       "WORLD", nullptr, false, 0, false);
+
+  auto cell_logic = new G4LogicalVolume(new G4Box("CELL", .4, .4, .5),
+                                        vacuum, "CELL");
+
+  std::vector<G4ThreeVector> positions;
+  for (G4int i=0; i<5; ++i)
+    for (G4int j=0; j<4; ++j)
+      positions.push_back(G4ThreeVector(-4. + 2.*i, -3. + 2.*j, 0.));
+
+  G4PVParameterised* array =
+    nexus::PlaceArray("CELL", cell_logic, world_logic, positions);
+
+  REQUIRE(array->GetMultiplicity() == G4int(positions.size()));
+
+  // The navigation of parameterised volumes needs the voxels
+  G4GeometryManager::GetInstance()->CloseGeometry(true, false, world_phys);
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(world_phys);
+
+  for (size_t k=0; k<positions.size(); ++k) {
+    G4ThreeVector point = positions[k] + G4ThreeVector(.3, -.3, .2);
+    navigator.LocateGlobalPointAndSetup(point, nullptr, false);
+    std::unique_ptr<G4TouchableHistory> touchable(navigator.CreateTouchableHistory());
+
+    REQUIRE(touchable->GetVolume()->GetName() == "CELL");
+    REQUIRE(touchable->GetCopyNumber() == G4int(k));
+    REQUIRE(touchable->GetTranslation() == positions[k]);
+  }
+
+  navigator.LocateGlobalPointAndSetup(G4ThreeVector(-3., -2., 0.), nullptr, false);
+  std::unique_ptr<G4TouchableHistory> touchable(navigator.CreateTouchableHistory());
+  REQUIRE(touchable->GetVolume()->GetName() == "WORLD");
+
+  G4GeometryManager::GetInstance()->OpenGeometry(world_phys);
+}
@@ -0,0 +1,37 @@
+#include "HexagonMeshTools.h"
+
+#include <catch.hpp>
+
+#include <cmath>
+
+TEST_CASE("SampleMeshCrossing") {
+
+  // Lines hit the front face of the mesh with a probability equal
+  // to the fraction of its area covered by metal, at any angle.
+  // At normal incidence, the rest of them go through the holes,
+  // while grazing lines never do.
+
+  const G4double hole  = 2.5;
+  const G4double land  = 0.1;
+  const G4int    nrays = 100000;
+
+  const G4double metal = 1. - std::pow(hole/(hole + land), 2);
+  const G4double tol   = 5. * std::sqrt(metal * (1. - metal) / nrays);
+
+  nexus::MeshCrossing normal = nexus::SampleMeshCrossing(hole, land, 1., nrays);
+  REQUIRE(std::abs(normal.face - metal) < tol);
+  REQUIRE(normal.open + normal.face == Approx(1.));
+
+  nexus::MeshCrossing grazing = nexus::SampleMeshCrossing(hole, land, 0., nrays);
+  REQUIRE(std::abs(grazing.face - metal) < tol);
+  REQUIRE(grazing.open == 0.);
+
+  // The transmission decreases with the angle of incidence
+  G4double previous = normal.open;
+  for (G4double cos_theta: {0.9, 0.5, 0.1, 0.02}) {
+    nexus::MeshCrossing c = nexus::SampleMeshCrossing(hole, land, cos_theta, nrays);
+    REQUIRE(std::abs(c.face - metal) < tol);
+    REQUIRE(c.open < previous);
+    previous = c.open;
+  }
+}
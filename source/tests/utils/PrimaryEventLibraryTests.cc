@@ -0,0 +1,121 @@
+#include "PrimaryEventLibrary.h"
+#include "NexusApp.h"
+
+#include <catch.hpp>
+
+#include <cstdio>
+#include <set>
+
+TEST_CASE("PrimaryEventLibrary") {
+
+  // This test writes a small library and checks that every event,
+  // read in an arbitrary order, is recovered unchanged, together
+  // with the number of source events and the particle weights.
+
+  const G4String filename = "PrimaryEventLibraryTest.bin";
+  const int nevents = 10;
+
+  nexus::PrimaryEventLibraryWriter writer;
+  writer.Open(filename, nexus::PrimaryEventLibrary::kHasPositions |
+                        nexus::PrimaryEventLibrary::kHasWeights);
+
+  for (int i=0; i<nevents; ++i) {
+    std::vector<nexus::LibraryParticle> particles;
+    for (int j=0; j<i%4; ++j) {
+      nexus::LibraryParticle p = {};
+      p.pdg = 11;
+      p.px = i;
+      p.py = j;
+      p.pz = i*j;
+      p.t  = 0.5 * j;
+      p.x  = -i;
+      p.weight = 0.25 * (j+1);
+      particles.push_back(p);
+    }
+    nexus::LibraryEvent evt = {};
+    evt.event_id = 100 + i;
+    evt.weight   = 1. / (i+1);
+    writer.AddEvent(evt, particles);
+  }
+  writer.SetNumberOfSourceEvents(1000);
+  writer.Close();
+
+  nexus::PrimaryEventLibrary library;
+  library.Open(filename);
+
+  REQUIRE(library.IsOpen());
+  REQUIRE(library.HasPositions());
+  REQUIRE(library.HasWeights());
+  REQUIRE(library.GetNumberOfEvents() == nevents);
+  REQUIRE(library.GetNumberOfSourceEvents() == 1000);
+
+  for (int i=nevents-1; i>=0; i-=3) {
+    const nexus::LibraryEvent& evt = library.GetEvent(i);
+    REQUIRE(evt.event_id == 100 + i);
+    REQUIRE(evt.weight == Approx(1. / (i+1)));
+    REQUIRE(evt.nparticles == (uint32_t)(i%4));
+
+    const nexus::LibraryParticle* particles = library.GetParticles(i);
+    for (uint32_t j=0; j<evt.nparticles; ++j) {
+      REQUIRE(particles[j].pdg == 11);
+      REQUIRE(particles[j].px == i);
+      REQUIRE(particles[j].py == j);
+      REQUIRE(particles[j].pz == i*j);
+      REQUIRE(particles[j].x  == -i);
+      REQUIRE(particles[j].weight == 0.25f * (j+1));
+    }
+  }
+
+  library.Close();
+  std::remove(filename.c_str());
+}
+
+
+
+TEST_CASE("PrimaryEventLibrary jobs") {
+
+  // This test checks that two forked jobs, each one running half
+  // of the events, replay disjoint sets of library events which,
+  // together, are the ones replayed by a single job.
+
+  const G4String filename = "PrimaryEventLibraryJobsTest.bin";
+  const int nevents = 10;
+  const int first_event = 3;
+
+  nexus::PrimaryEventLibraryWriter writer;
+  writer.Open(filename);
+  for (int i=0; i<nevents+first_event; ++i) {
+    nexus::LibraryEvent evt = {};
+    evt.event_id = i;
+    writer.AddEvent(evt, std::vector<nexus::LibraryParticle>());
+  }
+  writer.Close();
+
+  nexus::PrimaryEventLibrary library;
+  library.Open(filename);
+
+  // Events replayed by each job, offset as in the --jobs driver
+  std::set<int64_t> job_events[2];
+  for (int job=0; job<2; ++job) {
+    nexus::NexusApp::SetJobEventOffset(job * nevents/2);
+    for (int id=0; id<nevents/2; ++id) {
+      uint64_t k = nexus::PrimaryEventLibrary::GetReplayIndex(first_event, id);
+      REQUIRE(k < library.GetNumberOfEvents());
+      job_events[job].insert(library.GetEvent(k).event_id);
+    }
+  }
+  nexus::NexusApp::SetJobEventOffset(0);
+
+  REQUIRE(job_events[0].size() == (size_t)nevents/2);
+  REQUIRE(job_events[1].size() == (size_t)nevents/2);
+  for (int64_t id: job_events[0])
+    REQUIRE(job_events[1].count(id) == 0);
+
+  std::set<int64_t> all(job_events[0]);
+  all.insert(job_events[1].begin(), job_events[1].end());
+  REQUIRE(*all.begin() == first_event);
+  REQUIRE(*all.rbegin() == first_event + nevents - 1);
+
+  library.Close();
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,189 @@
+// ----------------------------------------------------------------------------
+// nexus | AcceptanceMapSampler.cc
+//
+// This class speeds up the generation of vertices in regions defined by
+// rejection, where points are drawn with a base sampler until one passes an
+// acceptance test (typically, until the navigator locates it in a given
+// volume). On first use, the bounding box of a set of base points is divided
+// in voxels. A voxel is classified as empty or full only when this is proven:
+// the acceptance test gives a safety distance (e.g., that of the navigator)
+// within which its result does not change, and it must cover the whole voxel
+// from its centre. All other voxels are partially filled. Afterwards, points
+// falling in empty voxels are rejected and points falling in full voxels are
+// accepted without running the acceptance test, which is only needed in
+// partially filled voxels. Since the points are still drawn with the base
+// sampler, the vertices follow the same distribution as with the plain
+// rejection loop.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "AcceptanceMapSampler.h"
+
+#include <G4Navigator.hh>
+#include <G4VPhysicalVolume.hh>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace nexus {
+
+  AcceptanceMapSampler::AcceptanceMapSampler
+  (std::function<G4ThreeVector()> generator,
+   AcceptanceTest test,
+   G4int nbins, G4int ntraining):
+    generator_(generator), test_(test),
+    nbins_(std::max(1, nbins)), ntraining_(std::max(1, ntraining)),
+    n_{0, 0, 0}
+  {
+  }
+
+
+
+  AcceptanceMapSampler::~AcceptanceMapSampler()
+  {
+  }
+
+
+
+  G4ThreeVector AcceptanceMapSampler::GenerateVertex()
+  {
+    Build();
+
+    while (true) {
+      G4ThreeVector point = generator_();
+
+      VoxelState state = GetVoxelState(point);
+      if (state == FULL) return point;
+      if (state == PARTIAL && test_.accept(point)) return point;
+    }
+  }
+
+
+
+  void AcceptanceMapSampler::Build()
+  {
+    std::call_once(built_, &AcceptanceMapSampler::BuildMap, this);
+  }
+
+
+
+  void AcceptanceMapSampler::BuildMap()
+  {
+    std::vector<G4ThreeVector> points(ntraining_ * nbins_ * nbins_ * nbins_);
+    for (G4ThreeVector& p: points) p = generator_();
+
+    min_ = max_ = points.front();
+    for (const G4ThreeVector& p: points) {
+      for (G4int i=0; i<3; ++i) {
+        min_[i] = std::min(min_[i], p[i]);
+        max_[i] = std::max(max_[i], p[i]);
+      }
+    }
+
+    // Flat dimensions (e.g., points on a plane) get a single voxel
+    for (G4int i=0; i<3; ++i)
+      n_[i] = (max_[i] > min_[i]) ? nbins_ : 1;
+
+    // The training points only give the extent of the map: a few accepted
+    // (or rejected) points do not prove that the whole voxel is. A
+    // voxel is empty (or full) only if its centre is rejected (or accepted)
+    // and the result of the test is known not to change within the
+    // half-diagonal of the voxel. Otherwise, the points in it are tested.
+    G4ThreeVector size;
+    for (G4int i=0; i<3; ++i)
+      size[i] = (max_[i] - min_[i]) / n_[i];
+    const G4double half_diagonal = size.mag() / 2.;
+
+    voxels_.assign(n_[0] * n_[1] * n_[2], PARTIAL);
+
+    if (!test_.safety) return;
+
+    for (G4int ix=0; ix<n_[0]; ++ix) {
+      for (G4int iy=0; iy<n_[1]; ++iy) {
+        for (G4int iz=0; iz<n_[2]; ++iz) {
+
+          G4ThreeVector centre(min_.x() + (ix + 0.5) * size.x(),
+                               min_.y() + (iy + 0.5) * size.y(),
+                               min_.z() + (iz + 0.5) * size.z());
+
+          G4bool accepted = test_.accept(centre);
+          if (test_.safety(centre) < half_diagonal) continue;
+
+          G4int index = (ix * n_[1] + iy) * n_[2] + iz;
+          voxels_[index] = accepted ? FULL : EMPTY;
+        }
+      }
+    }
+  }
+
+
+
+  G4int AcceptanceMapSampler::GetVoxelIndex(const G4ThreeVector& point) const
+  {
+    G4int idx[3];
+
+    for (G4int i=0; i<3; ++i) {
+      if (point[i] < min_[i] || point[i] > max_[i]) return -1;
+      if (n_[i] == 1) {
+        idx[i] = 0;
+        continue;
+      }
+      G4int k = (G4int) std::floor((point[i] - min_[i]) / (max_[i] - min_[i]) * n_[i]);
+      idx[i] = std::min(k, n_[i] - 1);
+    }
+
+    return (idx[0] * n_[1] + idx[1]) * n_[2] + idx[2];
+  }
+
+
+
+  AcceptanceMapSampler::VoxelState
+  AcceptanceMapSampler::GetVoxelState(const G4ThreeVector& point) const
+  {
+    if (voxels_.empty()) return PARTIAL;
+
+    G4int index = GetVoxelIndex(point);
+    if (index < 0) return PARTIAL;
+
+    return voxels_[index];
+  }
+
+
+
+  G4int AcceptanceMapSampler::GetNumberOfVoxels(VoxelState state) const
+  {
+    return std::count(voxels_.begin(), voxels_.end(), state);
+  }
+
+
+
+  AcceptanceTest
+  VolumeAcceptance(std::function<G4Navigator*()> navigator,
+                   const std::vector<G4String>& volumes,
+                   const G4ThreeVector& origin)
+  {
+    AcceptanceTest test;
+
+    test.accept = [navigator, volumes, origin](const G4ThreeVector& point) {
+      G4VPhysicalVolume* volume =
+        navigator()->LocateGlobalPointAndSetup(point - origin, 0, false);
+      return volume && std::find(volumes.begin(), volumes.end(),
+                                 volume->GetName()) != volumes.end();
+    };
+
+    // Within the safety of a point there are no boundaries of the
+    // volume where it is located nor of its daughters, so every point
+    // there is located in the same volume
+    test.safety = [navigator, origin](const G4ThreeVector& point) {
+      G4Navigator* nav = navigator();
+      G4VPhysicalVolume* volume =
+        nav->LocateGlobalPointAndSetup(point - origin, 0, false);
+      return volume ? nav->ComputeSafety(point - origin) : 0.;
+    };
+
+    return test;
+  }
+
+} // end namespace nexus
@@ -0,0 +1,111 @@
+// ----------------------------------------------------------------------------
+// nexus | AcceptanceMapSampler.h
+//
+// This class speeds up the generation of vertices in regions defined by
+// rejection, where points are drawn with a base sampler until one passes an
+// acceptance test (typically, until the navigator locates it in a given
+// volume). On first use, the bounding box of a set of base points is divided
+// in voxels. A voxel is classified as empty or full only when this is proven:
+// the acceptance test gives a safety distance (e.g., that of the navigator)
+// within which its result does not change, and it must cover the whole voxel
+// from its centre. All other voxels are partially filled. Afterwards, points
+// falling in empty voxels are rejected and points falling in full voxels are
+// accepted without running the acceptance test, which is only needed in
+// partially filled voxels. Since the points are still drawn with the base
+// sampler, the vertices follow the same distribution as with the plain
+// rejection loop.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef ACCEPTANCE_MAP_SAMPLER_H
+#define ACCEPTANCE_MAP_SAMPLER_H
+
+#include <G4ThreeVector.hh>
+#include <globals.hh>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+
+class G4Navigator;
+
+
+namespace nexus {
+
+  /// Acceptance test of the points of a region
+  struct AcceptanceTest
+  {
+    /// Whether a point belongs to the region
+    std::function<G4bool(const G4ThreeVector&)> accept;
+    /// Distance from a point within which the result of the
+    /// test is guaranteed to be the same (0 if unknown)
+    std::function<G4double(const G4ThreeVector&)> safety;
+  };
+
+
+  class AcceptanceMapSampler
+  {
+  public:
+    enum VoxelState : unsigned char { EMPTY, PARTIAL, FULL };
+
+    /// Constructor. The base sampler and the acceptance test are
+    /// called in the same way as in a plain rejection loop. The bounding
+    /// box of the map is found with <ntraining> points per voxel.
+    AcceptanceMapSampler(std::function<G4ThreeVector()> generator,
+                         AcceptanceTest test,
+                         G4int nbins=24, G4int ntraining=32);
+
+    /// Destructor
+    ~AcceptanceMapSampler();
+
+    /// Return a point of the base sampler that passes the acceptance test
+    G4ThreeVector GenerateVertex();
+
+    /// Build the voxel map. It is done automatically on first use,
+    /// once the geometry is closed.
+    void Build();
+
+    /// Classification of the voxel containing a point
+    /// (PARTIAL if it lies outside the map)
+    VoxelState GetVoxelState(const G4ThreeVector& point) const;
+
+    /// Number of voxels in a given state
+    G4int GetNumberOfVoxels(VoxelState) const;
+
+  private:
+    /// Find the bounding box with the training points and classify the voxels
+    void BuildMap();
+    /// Index of the voxel containing a point, -1 if outside the map
+    G4int GetVoxelIndex(const G4ThreeVector& point) const;
+
+  private:
+    std::function<G4ThreeVector()> generator_;
+    AcceptanceTest test_;
+
+    G4int nbins_;     ///< Number of voxels along each axis
+    G4int ntraining_; ///< Training points per voxel used to find the box
+
+    G4ThreeVector min_, max_; ///< Bounding box of the map
+    G4int n_[3];              ///< Number of voxels along x, y and z
+    std::vector<VoxelState> voxels_;
+
+    std::once_flag built_;
+  };
+
+
+  /// Acceptance test of the points located by the navigator in one of
+  /// the given physical volumes, once the origin is subtracted from them
+  /// (as done by the vertex generators of the geometries). Its safety
+  /// is the isotropic safety of the navigator. The navigator is obtained
+  /// from the given function each time the test runs, so that every
+  /// thread can use its own one (e.g., GeometryBase::GetNavigator).
+  AcceptanceTest
+  VolumeAcceptance(std::function<G4Navigator*()> navigator,
+                   const std::vector<G4String>& volumes,
+                   const G4ThreeVector& origin=G4ThreeVector());
+
+} // namespace nexus
+
+#endif
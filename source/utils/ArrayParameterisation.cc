@@ -0,0 +1,66 @@
+// ----------------------------------------------------------------------------
+// nexus | ArrayParameterisation.cc
+//
+// Parameterisation that places copies of a volume at a list of positions,
+// used for regular arrays of sensors and holes. A single parameterised
+// volume replaces the individual placements, with the index of each
+// position as copy number (as returned by the touchables), which reduces
+// the memory and construction time of the geometry and speeds up the
+// navigation through the array. The parameterised volume must be the only
+// daughter of its mother volume.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "ArrayParameterisation.h"
+
+#include <G4PVParameterised.hh>
+#include <G4VPhysicalVolume.hh>
+
+
+namespace nexus {
+
+
+  ArrayParameterisation::ArrayParameterisation(const std::vector<G4ThreeVector>& positions):
+    G4VPVParameterisation(), positions_(positions)
+  {
+  }
+
+
+
+  ArrayParameterisation::~ArrayParameterisation()
+  {
+  }
+
+
+
+  void ArrayParameterisation::ComputeTransformation(const G4int copy_no,
+                                                    G4VPhysicalVolume* phys) const
+  {
+    phys->SetTranslation(positions_[copy_no]);
+    phys->SetRotation(nullptr);
+  }
+
+
+
+  G4int ArrayParameterisation::GetNumberOfCopies() const
+  {
+    return positions_.size();
+  }
+
+
+
+  G4PVParameterised* PlaceArray(const G4String& name, G4LogicalVolume* logic,
+                                G4LogicalVolume* mother_logic,
+                                const std::vector<G4ThreeVector>& positions,
+                                G4bool check_overlaps)
+  {
+    ArrayParameterisation* param = new ArrayParameterisation(positions);
+
+    return new G4PVParameterised(name, logic, mother_logic, kUndefined,
+                                 param->GetNumberOfCopies(), param,
+                                 check_overlaps);
+  }
+
+
+} // end namespace nexus
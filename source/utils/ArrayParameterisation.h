@@ -0,0 +1,56 @@
+// ----------------------------------------------------------------------------
+// nexus | ArrayParameterisation.h
+//
+// Parameterisation that places copies of a volume at a list of positions,
+// used for regular arrays of sensors and holes. A single parameterised
+// volume replaces the individual placements, with the index of each
+// position as copy number (as returned by the touchables), which reduces
+// the memory and construction time of the geometry and speeds up the
+// navigation through the array. The parameterised volume must be the only
+// daughter of its mother volume.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef ARRAY_PARAMETERISATION_H
+#define ARRAY_PARAMETERISATION_H
+
+#include <G4VPVParameterisation.hh>
+#include <G4ThreeVector.hh>
+
+#include <vector>
+
+class G4LogicalVolume;
+class G4PVParameterised;
+
+
+namespace nexus {
+
+  class ArrayParameterisation: public G4VPVParameterisation
+  {
+  public:
+    /// Constructor
+    ArrayParameterisation(const std::vector<G4ThreeVector>& positions);
+    /// Destructor
+    ~ArrayParameterisation();
+
+    /// Translate the volume to the position of a given copy
+    void ComputeTransformation(const G4int copy_no, G4VPhysicalVolume*) const;
+
+    G4int GetNumberOfCopies() const;
+
+  private:
+    std::vector<G4ThreeVector> positions_;
+  };
+
+
+  /// Place copies of a volume at the given positions inside its mother,
+  /// the copy number of each one being the index of its position
+  G4PVParameterised* PlaceArray(const G4String& name, G4LogicalVolume* logic,
+                                G4LogicalVolume* mother_logic,
+                                const std::vector<G4ThreeVector>& positions,
+                                G4bool check_overlaps=false);
+
+} // namespace nexus
+
+#endif
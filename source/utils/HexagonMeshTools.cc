@@ -10,6 +10,7 @@
 #include <G4SubtractionSolid.hh>
 #include <G4Polyhedra.hh>
 #include <G4PVPlacement.hh>
+#include <Randomize.hh>
 
 
 namespace nexus {
@@ -17,6 +18,43 @@ namespace nexus {
   using namespace CLHEP;
 
 
+  namespace {
+
+    // Centre of the hexagon placed by PlaceHexagons nearest to a point,
+    // which is one of the corners of the cell of the lattice containing it
+    G4TwoVector NearestHexagonCentre(const G4TwoVector& p, G4double hex_size)
+    {
+      G4double qf = 2.0/3.0 * p.x() / hex_size;
+      G4double rf = (-1.0/3.0 * p.x() + std::sqrt(3.0)/3.0 * p.y()) / hex_size;
+
+      G4TwoVector centre;
+      G4double dmin = DBL_MAX;
+      for (G4double q: {std::floor(qf), std::floor(qf) + 1.}) {
+        for (G4double r: {std::floor(rf), std::floor(rf) + 1.}) {
+          G4TwoVector c(hex_size * 3.0/2.0 * q,
+                        hex_size * (std::sqrt(3)/2.0*q + r*std::sqrt(3)));
+          G4double d = (p - c).mag2();
+          if (d < dmin) {
+            dmin = d;
+            centre = c;
+          }
+        }
+      }
+      return centre;
+    }
+
+    // Whether a point, relative to the centre of a hole, is inside it
+    G4bool InsideHexagon(const G4TwoVector& p, G4double circumradius)
+    {
+      G4double x = std::abs(p.x());
+      G4double y = std::abs(p.y());
+      return y <= std::sqrt(3.0)/2.0 * circumradius &&
+             std::sqrt(3.0) * x + y <= std::sqrt(3.0) * circumradius;
+    }
+
+  }
+
+
 
   G4ExtrudedSolid* CreateHexagon(G4double half_thickness, G4double circumradius){
     
@@ -94,6 +132,51 @@ namespace nexus {
 
   }
 
+  // -----
+
+  MeshCrossing SampleMeshCrossing(G4double in_radius, G4double thickness, G4double cos_theta, G4int nrays){
+
+    G4double hex_size     = (in_radius + thickness)/std::sqrt(3.0);
+    G4double circumradius = in_radius/std::sqrt(3.0);
+
+    // Vectors spanning a cell of the lattice of hexagons, where the lines
+    // are sampled, since the mesh is periodic
+    G4TwoVector v1(hex_size * 3.0/2.0, hex_size * std::sqrt(3)/2.0);
+    G4TwoVector v2(0., hex_size * std::sqrt(3));
+
+    // Transverse displacement of the lines across the mesh
+    G4bool grazing = cos_theta <= 0.;
+    G4double shift = grazing ? 0. :
+      thickness * std::sqrt(1. - cos_theta*cos_theta) / cos_theta;
+
+    G4int n_open = 0;
+    G4int n_face = 0;
+
+    for (G4int i = 0; i < nrays; ++i){
+
+      G4TwoVector entry = G4UniformRand() * v1 + G4UniformRand() * v2;
+      G4TwoVector centre = NearestHexagonCentre(entry, hex_size);
+
+      if (!InsideHexagon(entry - centre, circumradius)){
+        ++n_face;
+        continue;
+      }
+
+      // The holes are convex, so the line goes through
+      // if it leaves the mesh inside the same hole
+      if (grazing)
+        continue;
+
+      G4double phi = twopi * G4UniformRand();
+      G4TwoVector exit = entry + shift * G4TwoVector(std::cos(phi), std::sin(phi));
+
+      if (InsideHexagon(exit - centre, circumradius))
+        ++n_open;
+    }
+
+    return MeshCrossing{G4double(n_open)/nrays, G4double(n_face)/nrays};
+  }
+
 
 
 } // end namespace nexus
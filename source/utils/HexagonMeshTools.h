@@ -14,12 +14,24 @@
 
 namespace nexus {
 
+    /// Fractions of the straight lines crossing a hexagonal mesh
+    struct MeshCrossing {
+      G4double open; ///< Through a hole, without touching the metal
+      G4double face; ///< Hitting the front face of the metal
+    };
+
     /// Construct a hexagon with a given thickness
     G4ExtrudedSolid* CreateHexagon(G4double half_thickness, G4double circumradius);
 
     /// Place hexagons inside a disk to create a mesh
     void PlaceHexagons(G4int n_hole, G4double in_radius, G4double thickness, G4LogicalVolume* disk_logical, G4LogicalVolume* hex_logical, G4double mesh_diam);
 
+    /// Sample straight lines with a given polar angle (uniform in position
+    /// and azimuth) crossing a mesh with the same dimensions as the one
+    /// created by PlaceHexagons, whose thickness is equal to its land width.
+    /// The rest of the lines (1 - open - face) hit the walls of the holes.
+    MeshCrossing SampleMeshCrossing(G4double in_radius, G4double thickness, G4double cos_theta, G4int nrays);
+
 } // namespace nexus
 
 #endif
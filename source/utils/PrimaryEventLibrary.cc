@@ -0,0 +1,260 @@
+// ----------------------------------------------------------------------------
+// nexus | PrimaryEventLibrary.cc
+//
+// Binary library of pregenerated primary events. The file starts with a
+// fixed-size header, followed by the event records (an event header and
+// the list of its particles) and, at the end, an index with the offset of
+// each event, so that any event can be accessed directly. The reader maps
+// the file in memory; the pages are shared by all the threads and
+// processes that read the same library. Values are stored in the native
+// byte order, in MeV, ns and mm. The header also keeps the number of
+// source events the library was extracted from (e.g., the events simulated
+// to record a phase space), needed to normalise the replayed ones.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PrimaryEventLibrary.h"
+#include "NexusApp.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace {
+
+  const char     magic[8] = {'N','X','P','E','L','I','B','\0'};
+  const uint32_t version  = 2;
+
+  /// Header at the beginning of the file
+  struct LibraryHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t nevents;
+    uint64_t index_offset; ///< Position of the index in the file
+    uint64_t nsource;      ///< Number of source events (since version 2)
+  };
+
+  /// Size of the header of version 1 files
+  const size_t header_size_v1 = offsetof(LibraryHeader, nsource);
+
+}
+
+
+namespace nexus {
+
+  PrimaryEventLibrary::PrimaryEventLibrary():
+    data_(nullptr), size_(0), nevents_(0), nsource_(0), flags_(0), index_(nullptr)
+  {
+  }
+
+
+
+  PrimaryEventLibrary::~PrimaryEventLibrary()
+  {
+    Close();
+  }
+
+
+
+  void PrimaryEventLibrary::Open(const G4String& filename)
+  {
+    Close();
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      G4Exception("[PrimaryEventLibrary]", "Open()", FatalException,
+                  ("Cannot open library file " + filename).c_str());
+      return;
+    }
+
+    struct stat st;
+    fstat(fd, &st);
+    size_ = st.st_size;
+
+    if (size_ < header_size_v1) {
+      close(fd);
+      G4Exception("[PrimaryEventLibrary]", "Open()", FatalException,
+                  (filename + " is not a primary event library.").c_str());
+      return;
+    }
+
+    void* map = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (map == MAP_FAILED) {
+      G4Exception("[PrimaryEventLibrary]", "Open()", FatalException,
+                  ("Cannot map library file " + filename).c_str());
+      return;
+    }
+    data_ = static_cast<const char*>(map);
+
+    LibraryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(&header, data_, header_size_v1);
+    if (header.version >= 2 && size_ >= sizeof(header))
+      std::memcpy(&header, data_, sizeof(header));
+
+    const size_t header_size = (header.version >= 2) ? sizeof(header) : header_size_v1;
+
+    // The comparisons are arranged so that corrupted
+    // values cannot overflow and pass the checks
+    G4bool valid = std::memcmp(header.magic, magic, sizeof(magic)) == 0 &&
+      header.version >= 1 && header.version <= version &&
+      header.index_offset >= header_size && header.index_offset <= size_ &&
+      header.nevents <= (size_ - header.index_offset) / sizeof(uint64_t);
+
+    if (valid) {
+      index_ = reinterpret_cast<const uint64_t*>(data_ + header.index_offset);
+
+      // Every event record, particles included, must lie
+      // between the header and the index
+      for (uint64_t k=0; k<header.nevents && valid; ++k) {
+        uint64_t offset = index_[k];
+        if (offset < header_size || offset > header.index_offset ||
+            header.index_offset - offset < sizeof(LibraryEvent)) {
+          valid = false;
+          break;
+        }
+        LibraryEvent evt;
+        std::memcpy(&evt, data_ + offset, sizeof(evt));
+        valid = evt.nparticles <= (header.index_offset - offset - sizeof(LibraryEvent))
+                                  / sizeof(LibraryParticle);
+      }
+    }
+
+    if (!valid) {
+      Close();
+      G4Exception("[PrimaryEventLibrary]", "Open()", FatalException,
+                  (filename + " is not a valid primary event library.").c_str());
+      return;
+    }
+
+    nevents_ = header.nevents;
+    nsource_ = (header.version >= 2) ? header.nsource : header.nevents;
+    flags_   = header.flags;
+  }
+
+
+
+  void PrimaryEventLibrary::Close()
+  {
+    if (data_) munmap(const_cast<char*>(data_), size_);
+    data_    = nullptr;
+    size_    = 0;
+    nevents_ = 0;
+    nsource_ = 0;
+    flags_   = 0;
+    index_   = nullptr;
+  }
+
+
+
+  const LibraryEvent& PrimaryEventLibrary::GetEvent(uint64_t k) const
+  {
+    if (k >= nevents_)
+      G4Exception("[PrimaryEventLibrary]", "GetEvent()", FatalException,
+                  "Event index out of range.");
+
+    return *reinterpret_cast<const LibraryEvent*>(data_ + index_[k]);
+  }
+
+
+
+  const LibraryParticle* PrimaryEventLibrary::GetParticles(uint64_t k) const
+  {
+    if (k >= nevents_)
+      G4Exception("[PrimaryEventLibrary]", "GetParticles()", FatalException,
+                  "Event index out of range.");
+
+    return reinterpret_cast<const LibraryParticle*>
+      (data_ + index_[k] + sizeof(LibraryEvent));
+  }
+
+
+
+  uint64_t PrimaryEventLibrary::GetReplayIndex(uint64_t first_event, G4int event_id)
+  {
+    return first_event + NexusApp::GetJobEventOffset() + event_id;
+  }
+
+
+
+  PrimaryEventLibraryWriter::PrimaryEventLibraryWriter(): nsource_(0), flags_(0)
+  {
+  }
+
+
+
+  PrimaryEventLibraryWriter::~PrimaryEventLibraryWriter()
+  {
+    if (file_.is_open()) Close();
+  }
+
+
+
+  void PrimaryEventLibraryWriter::Open(const G4String& filename, uint32_t flags)
+  {
+    file_.open(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file_.good()) {
+      G4Exception("[PrimaryEventLibraryWriter]", "Open()", FatalException,
+                  ("Cannot create library file " + filename).c_str());
+      return;
+    }
+
+    flags_   = flags;
+    nsource_ = 0;
+    index_.clear();
+
+    // The header is written again with the final values when closing
+    LibraryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+
+
+
+  void PrimaryEventLibraryWriter::AddEvent(const LibraryEvent& event,
+                                           const std::vector<LibraryParticle>& particles)
+  {
+    index_.push_back(file_.tellp());
+
+    LibraryEvent evt = event;
+    evt.nparticles = particles.size();
+    file_.write(reinterpret_cast<const char*>(&evt), sizeof(evt));
+    file_.write(reinterpret_cast<const char*>(particles.data()),
+                particles.size() * sizeof(LibraryParticle));
+  }
+
+
+
+  void PrimaryEventLibraryWriter::Close()
+  {
+    LibraryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version      = version;
+    header.flags        = flags_;
+    header.nevents      = index_.size();
+    header.index_offset = file_.tellp();
+    header.nsource      = nsource_ ? nsource_ : index_.size();
+
+    file_.write(reinterpret_cast<const char*>(index_.data()),
+                index_.size() * sizeof(uint64_t));
+
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.close();
+
+    if (file_.fail())
+      G4Exception("[PrimaryEventLibraryWriter]", "Close()", FatalException,
+                  "Error writing the library file.");
+  }
+
+} // namespace nexus
@@ -0,0 +1,154 @@
+// ----------------------------------------------------------------------------
+// nexus | PrimaryEventLibrary.h
+//
+// Binary library of pregenerated primary events. The file starts with a
+// fixed-size header, followed by the event records (an event header and
+// the list of its particles) and, at the end, an index with the offset of
+// each event, so that any event can be accessed directly. The reader maps
+// the file in memory; the pages are shared by all the threads and
+// processes that read the same library. Values are stored in the native
+// byte order, in MeV, ns and mm. The header also keeps the number of
+// source events the library was extracted from (e.g., the events simulated
+// to record a phase space), needed to normalise the replayed ones.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PRIMARY_EVENT_LIBRARY_H
+#define PRIMARY_EVENT_LIBRARY_H
+
+#include <globals.hh>
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+
+namespace nexus {
+
+  /// Header of each event of the library
+  struct LibraryEvent {
+    int64_t  event_id;   ///< Event number in the original generator
+    double   time;       ///< Event time (ns)
+    double   weight;     ///< Statistical weight of the event
+    uint32_t nparticles; ///< Number of particles that follow
+    uint32_t flags;      ///< Reserved
+  };
+
+  /// Primary particle of an event of the library
+  struct LibraryParticle {
+    int32_t pdg;      ///< PDG code
+    float weight;     ///< Statistical weight, if the library has weights
+    double px, py, pz; ///< Momentum (MeV)
+    double t;          ///< Time with respect to the event time (ns)
+    double x, y, z;    ///< Position (mm), if the library has positions
+  };
+
+  /// Read-only access to a library of primary events
+
+  class PrimaryEventLibrary
+  {
+  public:
+    /// Bit of the library flags set if particle positions are stored
+    static const uint32_t kHasPositions = 1;
+    /// Bit of the library flags set if particle weights are stored
+    /// (otherwise, the particles have the weight of their event)
+    static const uint32_t kHasWeights = 2;
+
+    /// Constructor
+    PrimaryEventLibrary();
+    /// Destructor
+    ~PrimaryEventLibrary();
+
+    /// Map the library file in memory
+    void Open(const G4String& filename);
+    /// Unmap the library file
+    void Close();
+
+    G4bool IsOpen() const;
+
+    /// Number of events in the library
+    uint64_t GetNumberOfEvents() const;
+    /// Number of source events the library was extracted from
+    uint64_t GetNumberOfSourceEvents() const;
+    /// Flags of the library
+    uint32_t GetFlags() const;
+    /// Whether the particle positions are stored in the library
+    G4bool HasPositions() const;
+    /// Whether the particle weights are stored in the library
+    G4bool HasWeights() const;
+
+    /// Return the header of the k-th event
+    const LibraryEvent& GetEvent(uint64_t k) const;
+    /// Return the particles of the k-th event
+    const LibraryParticle* GetParticles(uint64_t k) const;
+
+    /// Index of the library event replayed by the given event of the
+    /// run, for a generator that starts at first_event. The events of
+    /// the jobs that precede this one (see NexusApp) are skipped, so
+    /// that forked jobs replay disjoint sets of library events.
+    static uint64_t GetReplayIndex(uint64_t first_event, G4int event_id);
+
+  private:
+    PrimaryEventLibrary(const PrimaryEventLibrary&) = delete;
+
+    const char* data_; ///< Start of the mapped file
+    size_t size_;      ///< Size of the mapped file
+    uint64_t nevents_;
+    uint64_t nsource_;
+    uint32_t flags_;
+    const uint64_t* index_; ///< Offset of each event in the file
+  };
+
+
+  /// Writer of libraries of primary events
+
+  class PrimaryEventLibraryWriter
+  {
+  public:
+    /// Constructor
+    PrimaryEventLibraryWriter();
+    /// Destructor. The file is closed if still open.
+    ~PrimaryEventLibraryWriter();
+
+    /// Create the library file
+    void Open(const G4String& filename, uint32_t flags=0);
+    /// Append an event to the library
+    void AddEvent(const LibraryEvent& event,
+                  const std::vector<LibraryParticle>& particles);
+    /// Write the index and close the file
+    void Close();
+
+    /// Number of events written so far
+    uint64_t GetNumberOfEvents() const;
+
+    /// Set the number of source events the library was extracted from.
+    /// By default, it is the number of events written.
+    void SetNumberOfSourceEvents(uint64_t);
+
+  private:
+    std::ofstream file_;
+    std::vector<uint64_t> index_;
+    uint64_t nsource_;
+    uint32_t flags_;
+  };
+
+  // INLINE DEFINITIONS ////////////////////////////////////
+
+  inline G4bool PrimaryEventLibrary::IsOpen() const { return data_ != nullptr; }
+  inline uint64_t PrimaryEventLibrary::GetNumberOfEvents() const { return nevents_; }
+  inline uint64_t PrimaryEventLibrary::GetNumberOfSourceEvents() const { return nsource_; }
+  inline uint32_t PrimaryEventLibrary::GetFlags() const { return flags_; }
+  inline G4bool PrimaryEventLibrary::HasPositions() const
+  { return flags_ & kHasPositions; }
+  inline G4bool PrimaryEventLibrary::HasWeights() const
+  { return flags_ & kHasWeights; }
+
+  inline uint64_t PrimaryEventLibraryWriter::GetNumberOfEvents() const
+  { return index_.size(); }
+  inline void PrimaryEventLibraryWriter::SetNumberOfSourceEvents(uint64_t n)
+  { nsource_ = n; }
+
+} // namespace nexus
+
+#endif